@@ -0,0 +1,263 @@
+/************************************************************************************
+* See header file for general module documentation
+************************************************************************************/
+
+
+//########## DEPENDENCIES ##########//
+#include "hal.h"
+#include "ctrlLink.h"
+
+#if (COMPUTER_CONTROL)
+
+
+//########## FUNCTION DEFINITIONS ##########//
+
+/************************************************************************************
+* Function: ctrlLinkInit
+*
+* Description:
+*   Empties the given link's ring buffers, sets up the USCI peripheral as a 3-wire
+*   SPI slave in CTRL_SPI_MODE (8-bit, MSB first), loads CTRL_REPORT_IDLE to be
+*   shifted out first, and enables the peripheral's RX interrupt.
+*
+* Arguments:
+*   *usciXN     -   pointer to the USCI peripheral object for the link
+*   *link       -   pointer to the link object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void ctrlLinkInit(const USCIXNSPI *const usciXN, CTRL_LINK *const link)
+{
+    link->rxHead = 0;
+    link->rxCommit = 0;
+    link->rxTail = 0;
+    link->rxState = CTRL_RX_HUNT;
+    link->rxErrors = 0;
+    link->txHead = 0;
+    link->txTail = 0;
+
+    // the computer supplies the clock, so no clock division is needed (and no loopback, since SOMI carries the reports)
+    usciXNSpiInit(usciXN, SPI_SLV, 1, CTRL_SPI_MODE, SPI_DAT8BIT, SPI_MSB, 0);
+
+    *(usciXN->UCXNTXBUF) = CTRL_REPORT_IDLE;
+    *(usciXN->UCXNIFG) &= ~(usciXN->UCXNRXIFG);
+    *(usciXN->UCXNIE) |= usciXN->UCXNRXIE;
+}
+
+/************************************************************************************
+* Function: ctrlLinkISR
+*
+* Description:
+*   Handles one byte received from the computer; this should be called by the
+*   client's ISR for the link's USCI RX interrupt whenever its RXIFG is set. The
+*   next report byte (or CTRL_REPORT_IDLE) is loaded into TXBUF, and the received
+*   byte is run through the command parser described in the module header. Once a
+*   command passes its checksum, it is made visible to ctrlLinkPopCmd.
+*
+* Arguments:
+*   *usciXN     -   pointer to the USCI peripheral object for the link
+*   *link       -   pointer to the link object
+*
+* Returns:
+*   unsigned char noCmd; 0 if a command was completed (so the main loop should be
+*   woken to collect it), otherwise 1
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char ctrlLinkISR(const USCIXNSPI *const usciXN, CTRL_LINK *const link)
+{
+    unsigned char rxByte = *(usciXN->UCXNRXBUF);
+    unsigned char nextHead;
+
+    *(usciXN->UCXNIFG) &= ~(usciXN->UCXNRXIFG);     // the received byte has been collected
+
+    // load the byte to shift out during the computer's next transfer
+    if (*(usciXN->UCXNIFG) & (usciXN->UCXNTXIFG))
+    {
+        if (link->txTail != link->txHead)
+        {
+            *(usciXN->UCXNTXBUF) = link->txBuf[link->txTail];
+            link->txTail = (link->txTail + 1) & (CTRL_TX_BUF_SZ - 1);
+        }
+        else
+        {
+            *(usciXN->UCXNTXBUF) = CTRL_REPORT_IDLE;
+        }
+    }
+
+    if (link->rxState == CTRL_RX_HUNT)
+    {
+        if (rxByte == CTRL_SYNC)
+        {
+            link->rxState = CTRL_RX_CMD;
+            link->rxSum = 0;
+        }
+
+        return 1;
+    }
+
+    link->rxSum += rxByte;
+
+    if (link->rxState == CTRL_RX_CHECK)
+    {
+        link->rxState = CTRL_RX_HUNT;
+
+        if (link->rxSum)
+        {
+            // bad checksum; drop every byte of the command
+            link->rxHead = link->rxCommit;
+
+            if (link->rxErrors != 0xFF)
+                link->rxErrors++;
+
+            return 1;
+        }
+
+        link->rxCommit = link->rxHead;
+        return 0;
+    }
+
+    // every other byte of the command is stored for ctrlLinkPopCmd
+    nextHead = (link->rxHead + 1) & (CTRL_RX_BUF_SZ - 1);
+
+    if (nextHead == link->rxTail)
+    {
+        // no room left; drop every byte of the command, and wait for the next one
+        link->rxHead = link->rxCommit;
+        link->rxState = CTRL_RX_HUNT;
+
+        if (link->rxErrors != 0xFF)
+            link->rxErrors++;
+
+        return 1;
+    }
+
+    link->rxBuf[link->rxHead] = rxByte;
+    link->rxHead = nextHead;
+
+    switch (link->rxState)
+    {
+    case CTRL_RX_CMD:
+        if (CTRL_CMD_TYPE(rxByte) == CTRL_CMD_FRAME)
+        {
+            link->rxLeft = rxByte & CTRL_FRAME_LED;     // the LED byte, if there is one, is counted now; the segment bytes once the mask is in
+            link->rxState = CTRL_RX_MASK;
+        }
+        else
+        {
+            link->rxState = CTRL_RX_CHECK;              // CTRL_CMD_RELEASE (commands this module doesn't know are still framed, and left for the client to ignore)
+        }
+        break;
+
+    case CTRL_RX_MASK:
+        // count the segment bytes that follow
+        while (rxByte)
+        {
+            link->rxLeft += rxByte & 0x01;
+            rxByte >>= 1;
+        }
+
+        link->rxState = (link->rxLeft) ? CTRL_RX_DATA : CTRL_RX_CHECK;
+        break;
+
+    default:    // CTRL_RX_DATA
+        if (!(--(link->rxLeft)))
+            link->rxState = CTRL_RX_CHECK;
+        break;
+    }
+
+    return 1;
+}
+
+/************************************************************************************
+* Function: ctrlLinkPopCmd
+*
+* Description:
+*   Collects the oldest complete command from the link's receive ring buffer into
+*   the given frame object. For a CTRL_CMD_FRAME, only the segCodes entries given
+*   by dispMask (and ledState, with CTRL_FRAME_LED) are written.
+*
+* Arguments:
+*   *link       -   pointer to the link object
+*   *frame      -   pointer to the frame object to fill
+*
+* Returns:
+*   unsigned char emptyLink; 0 if a command was collected, 1 if none were waiting
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char ctrlLinkPopCmd(CTRL_LINK *const link, CTRL_FRAME *const frame)
+{
+    unsigned char tail = link->rxTail;
+    unsigned char dispMask;
+    unsigned char dispIndex;
+
+    if (tail == link->rxCommit)
+        return 1;
+
+    frame->cmd = link->rxBuf[tail];
+    tail = (tail + 1) & (CTRL_RX_BUF_SZ - 1);
+
+    if (CTRL_CMD_TYPE(frame->cmd) == CTRL_CMD_FRAME)
+    {
+        frame->dispMask = link->rxBuf[tail];
+        tail = (tail + 1) & (CTRL_RX_BUF_SZ - 1);
+
+        // unpack the segment bytes, display 0 first
+        for (dispIndex = 0, dispMask = frame->dispMask; dispMask; dispIndex++, dispMask >>= 1)
+        {
+            if (dispMask & 0x01)
+            {
+                frame->segCodes[dispIndex] = link->rxBuf[tail];
+                tail = (tail + 1) & (CTRL_RX_BUF_SZ - 1);
+            }
+        }
+
+        if (frame->cmd & CTRL_FRAME_LED)
+        {
+            frame->ledState = link->rxBuf[tail];
+            tail = (tail + 1) & (CTRL_RX_BUF_SZ - 1);
+        }
+    }
+
+    link->rxTail = tail;    // only handed back to the ISR once every byte has been copied out
+    return 0;
+}
+
+/************************************************************************************
+* Function: ctrlLinkReport
+*
+* Description:
+*   Queues a report byte to be shifted out to the computer (the encoding of reports
+*   is up to the client; report must not be CTRL_REPORT_IDLE).
+*
+* Arguments:
+*   *link       -   pointer to the link object
+*   report      -   the report byte to queue
+*
+* Returns:
+*   unsigned char fullLink; 0 if the report was queued, 1 if the transmit ring buffer
+*   was full and the report was dropped
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char ctrlLinkReport(CTRL_LINK *const link, const unsigned char report)
+{
+    unsigned char nextHead = (link->txHead + 1) & (CTRL_TX_BUF_SZ - 1);
+
+    if (nextHead == link->txTail)
+        return 1;
+
+    link->txBuf[link->txHead] = report;
+    link->txHead = nextHead;    // only moved once the report is in place, so the ISR never loads a stale byte
+    return 0;
+}
+
+#endif /* COMPUTER_CONTROL */
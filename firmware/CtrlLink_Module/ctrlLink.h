@@ -0,0 +1,204 @@
+/************************************************************************************
+* Computer Control Link Module
+*
+* Contains a compact binary protocol that lets a computer drive the interface's
+* displays and LEDs directly ("COMPUTER CONTROL"), and receive its key events back.
+* The link is a 3-wire SPI slave on a free USCI peripheral (USCI_B0 on the Gemini
+* board), set up through "spi.h"; the computer is the SPI master, and every byte it
+* clocks in shifts a report byte back out at the same time.
+*
+* Every command the computer sends has the format:
+*       CTRL_SYNC, cmd, payload..., checksum
+* where the checksum is chosen so that the 8-bit sum of every byte from cmd to the
+* checksum is 0. Two commands are defined:
+*       CTRL_CMD_FRAME:     a display mask byte, then one segment byte (in the
+*                           SEVEN_SEG_DISP binSegCode format) for each set bit of
+*                           the mask, display 0 first. When CTRL_FRAME_LED is ORed
+*                           into the command, the LED shift register byte follows.
+*                           A partial frame only updates the displays it carries.
+*       CTRL_CMD_RELEASE:   no payload; hands the interface back to its front panel.
+* While waiting for CTRL_SYNC, any other bytes are ignored, so the computer can clock
+* in filler bytes just to collect reports.
+*
+* Received bytes are framed by ctrlLinkISR, called by the client's USCI RX ISR, into
+* a receive ring buffer. A command only becomes visible to the main loop once its
+* checksum has been verified; commands that fail their checksum, or that don't fit
+* in the ring buffer, are dropped and counted in rxErrors. The main loop collects
+* each command with ctrlLinkPopCmd. Report bytes queued with ctrlLinkReport are
+* loaded into TXBUF by the same ISR, one per received byte; CTRL_REPORT_IDLE is
+* shifted out when there is nothing to report, so reports must never be 0x00.
+*
+* Please note: the next report byte is loaded once the previous byte has been
+* received, so the computer must leave a short gap between bytes for the ISR to run.
+*
+* Setting COMPUTER_CONTROL to 0 leaves the module's functions out of the build.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+
+#ifndef CTRLLINK_MODULE_CTRLLINK_H_
+#define CTRLLINK_MODULE_CTRLLINK_H_
+
+
+//########## DEPENDENCIES ##########//
+#include "spi.h"
+
+
+//########## SYMBOLIC CONSTANTS ##########//
+
+// user-defined constants
+#define COMPUTER_CONTROL    0       // set to 1 to build the link and let a computer take over the interface; 0 to leave it out entirely
+#define CTRL_RX_BUF_SZ      16      // bytes in the receive ring buffer (MUST be a power of 2; one byte is always kept free)
+#define CTRL_TX_BUF_SZ      8       // report bytes in the transmit ring buffer (MUST be a power of 2; one byte is always kept free)
+#define CTRL_NUM_DISPS      8       // displays a frame can carry (display masks are 8 bits wide, so this must not be greater than 8)
+#define CTRL_SPI_MODE       0x0     // UCCKPH/UCCKPL code for the link (see usciXNSpiInit), which must match the computer's SPI mode
+
+// protocol bytes
+#define CTRL_SYNC           0xA5    // starts every command
+#define CTRL_CMD_FRAME      0x10    // display/LED frame; see the module description for its payload
+#define CTRL_FRAME_LED      0x01    // ORed into CTRL_CMD_FRAME when the frame carries an LED byte
+#define CTRL_CMD_RELEASE    0x20    // hands the interface back to its front panel
+#define CTRL_CMD_TYPE_MASK  0xF0    // bits of a command byte holding the command type
+#define CTRL_REPORT_IDLE    0x00    // shifted out while no report is waiting
+
+// receive parser states, as kept in CTRL_LINK.rxState
+#define CTRL_RX_HUNT        0       // waiting for CTRL_SYNC
+#define CTRL_RX_CMD         1       // waiting for the command byte
+#define CTRL_RX_MASK        2       // waiting for a frame's display mask
+#define CTRL_RX_DATA        3       // waiting for rxLeft more payload bytes
+#define CTRL_RX_CHECK       4       // waiting for the checksum
+
+
+//########## PREPROCESSOR MACROS ##########//
+
+// evaluates as the type of a command byte (CTRL_CMD_FRAME or CTRL_CMD_RELEASE)
+#define CTRL_CMD_TYPE(cmd)          ((cmd) & CTRL_CMD_TYPE_MASK)
+
+// evaluates as nonzero if a complete command is waiting to be collected by ctrlLinkPopCmd (for checking before entering a low power mode)
+#define CTRL_CMD_PENDING(link)      ((link)->rxCommit != (link)->rxTail)
+
+
+//########## STRUCTURES ##########//
+
+// a command collected by ctrlLinkPopCmd
+typedef struct CTRL_FRAME
+{
+    unsigned char cmd;                          // the command byte; see CTRL_CMD_TYPE
+    unsigned char dispMask;                     // bit n is set if segCodes[n] was sent (CTRL_CMD_FRAME only)
+    unsigned char segCodes[CTRL_NUM_DISPS];     // segment code for display n, only valid if bit n of dispMask is set
+    unsigned char ledState;                     // LED shift register byte, only valid if cmd has CTRL_FRAME_LED
+}
+CTRL_FRAME;
+
+/* Receive and transmit ring buffers. The ISR is the only producer of rxBuf (rxHead and rxCommit) and the only consumer of txBuf (txTail);
+ * the main loop is the only consumer of rxBuf (rxTail) and the only producer of txBuf (txHead). Only the cmd and payload bytes of each
+ * command are stored. */
+typedef struct CTRL_LINK
+{
+    unsigned char rxBuf[CTRL_RX_BUF_SZ];
+    volatile unsigned char rxHead;      // index of the next free byte
+    volatile unsigned char rxCommit;    // index just past the last command that passed its checksum; the main loop may read up to here
+    volatile unsigned char rxTail;      // index of the next byte for the main loop to read
+    unsigned char rxState;              // CTRL_RX_ parser state
+    unsigned char rxLeft;               // payload bytes left in the command being received
+    unsigned char rxSum;                // 8-bit sum of the command's bytes received so far
+    volatile unsigned char rxErrors;    // commands dropped for a bad checksum or a full ring buffer; saturates at 0xFF
+
+    unsigned char txBuf[CTRL_TX_BUF_SZ];
+    volatile unsigned char txHead;      // index of the next free report byte
+    volatile unsigned char txTail;      // index of the next report byte to load into TXBUF
+}
+CTRL_LINK;
+
+
+//########## FUNCTION PROTOTYPES ##########//
+#if (COMPUTER_CONTROL)
+
+/************************************************************************************
+* Function: ctrlLinkInit
+*
+* Description:
+*   Empties the given link's ring buffers, sets up the USCI peripheral as a 3-wire
+*   SPI slave in CTRL_SPI_MODE (8-bit, MSB first), loads CTRL_REPORT_IDLE to be
+*   shifted out first, and enables the peripheral's RX interrupt.
+*
+* Arguments:
+*   *usciXN     -   pointer to the USCI peripheral object for the link
+*   *link       -   pointer to the link object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void ctrlLinkInit(const USCIXNSPI *const usciXN, CTRL_LINK *const link);
+
+/************************************************************************************
+* Function: ctrlLinkISR
+*
+* Description:
+*   Handles one byte received from the computer; this should be called by the
+*   client's ISR for the link's USCI RX interrupt whenever its RXIFG is set. The
+*   next report byte (or CTRL_REPORT_IDLE) is loaded into TXBUF, and the received
+*   byte is run through the command parser described in the module header. Once a
+*   command passes its checksum, it is made visible to ctrlLinkPopCmd.
+*
+* Arguments:
+*   *usciXN     -   pointer to the USCI peripheral object for the link
+*   *link       -   pointer to the link object
+*
+* Returns:
+*   unsigned char noCmd; 0 if a command was completed (so the main loop should be
+*   woken to collect it), otherwise 1
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char ctrlLinkISR(const USCIXNSPI *const usciXN, CTRL_LINK *const link);
+
+/************************************************************************************
+* Function: ctrlLinkPopCmd
+*
+* Description:
+*   Collects the oldest complete command from the link's receive ring buffer into
+*   the given frame object. For a CTRL_CMD_FRAME, only the segCodes entries given
+*   by dispMask (and ledState, with CTRL_FRAME_LED) are written.
+*
+* Arguments:
+*   *link       -   pointer to the link object
+*   *frame      -   pointer to the frame object to fill
+*
+* Returns:
+*   unsigned char emptyLink; 0 if a command was collected, 1 if none were waiting
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char ctrlLinkPopCmd(CTRL_LINK *const link, CTRL_FRAME *const frame);
+
+/************************************************************************************
+* Function: ctrlLinkReport
+*
+* Description:
+*   Queues a report byte to be shifted out to the computer (the encoding of reports
+*   is up to the client; report must not be CTRL_REPORT_IDLE).
+*
+* Arguments:
+*   *link       -   pointer to the link object
+*   report      -   the report byte to queue
+*
+* Returns:
+*   unsigned char fullLink; 0 if the report was queued, 1 if the transmit ring buffer
+*   was full and the report was dropped
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char ctrlLinkReport(CTRL_LINK *const link, const unsigned char report);
+
+#endif /* COMPUTER_CONTROL */
+
+
+#endif /* CTRLLINK_MODULE_CTRLLINK_H_ */
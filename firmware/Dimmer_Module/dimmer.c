@@ -0,0 +1,289 @@
+/************************************************************************************
+* See header file for general module documentation
+************************************************************************************/
+
+
+//########## DEPENDENCIES ##########//
+#include "hal.h"
+#include "dimmer.h"
+
+#if (DISP_DIMMING)
+
+
+//########## PRIVATE FUNCTIONS ##########//
+
+// reads the timer, which runs from ACLK (asynchronously to MCLK), until two reads in a row agree, so a read made while it counts is never taken
+static unsigned int dimReadTimer(void)
+{
+    unsigned int count;
+
+    do
+        count = DIM_TIMER_R;
+    while (count != DIM_TIMER_R);
+
+    return count;
+}
+
+// sets the level shown from the next part of the period on, starting or stopping the blanking as needed; interrupts must be disabled
+static void dimSetLevel(DIMMER *const dimmer, const unsigned char level)
+{
+    if (level >= DIM_LEVEL_FULL)
+    {
+        DIM_PHASE_CCTL = 0;
+
+        // the outputs stay lit from now on, so they must be relit if they were blanked
+        if (dimmer->timerBlank)
+        {
+            dimmer->timerBlank = 0;
+            dimmer->phasePending = 1;
+        }
+        return;
+    }
+
+    dimmer->litTicks = level * dimmer->levelTicks;
+
+    // start with the lit part of a period; if the blanking is already running, the new level takes effect from its next compare
+    if (!(DIM_PHASE_CCTL & CCIE))
+    {
+        DIM_PHASE_CCR = DIM_TIMER_R + dimmer->litTicks;
+        DIM_PHASE_CCTL = CCIE;
+    }
+}
+
+
+//########## FUNCTION DEFINITIONS ##########//
+
+/************************************************************************************
+* Function: dimInit
+*
+* Description:
+*   Initializes the given dimmer at DIM_LEVEL_FULL with its compare channels
+*   stopped, and with the given levels to be set by dimWake and the inactivity
+*   timeout.
+*
+* Arguments:
+*   *dimmer         -   pointer to the dimmer object
+*   activeLevel     -   level to set on dimWake (1 to DIM_LEVEL_FULL)
+*   idleLevel       -   level to set after DIM_IDLE_MS of inactivity (1 to DIM_LEVEL_FULL)
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void dimInit(DIMMER *const dimmer, const unsigned char activeLevel, const unsigned char idleLevel)
+{
+    dimmer->activeLevel = activeLevel;
+    dimmer->idleLevel = idleLevel;
+    dimmer->periodTicks = DIM_PERIOD;
+    dimmer->levelTicks = DIM_LEVEL_TICKS;
+    dimStop(dimmer);
+}
+
+/************************************************************************************
+* Function: dimCalibrate
+*
+* Description:
+*   Measures ACLK against MCLK, as described in the module header, and sets the
+*   dimmer's period and level lengths from it. If the count is too low to give
+*   every level at least one ACLK cycle (such as when ACLK isn't running), the
+*   typical DIM_PERIOD and DIM_LEVEL_TICKS are kept. Interrupts are disabled while
+*   counting, for DIM_CAL_CYCLES; this must be called with MCLK at DIM_MCLK_HZ,
+*   while the blanking is stopped (such as right after dimInit).
+*
+* Arguments:
+*   *dimmer     -   pointer to the dimmer object
+*
+* Returns:
+*   unsigned char calError; 0 if the lengths were measured, 1 if the typical ones
+*   were kept
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char dimCalibrate(DIMMER *const dimmer)
+{
+    unsigned short intState = __get_interrupt_state();
+    unsigned int periodTicks;
+
+    __disable_interrupt();
+
+    periodTicks = dimReadTimer();
+    __delay_cycles(DIM_CAL_CYCLES);
+    periodTicks = (dimReadTimer() - periodTicks) / DIM_CAL_PERIODS;
+
+    __set_interrupt_state(intState);
+
+    if (periodTicks < DIM_LEVEL_FULL)
+        return 1;
+
+    dimmer->periodTicks = periodTicks;
+    dimmer->levelTicks = periodTicks / DIM_LEVEL_FULL;
+    dimmer->litTicks = periodTicks;
+
+    return 0;
+}
+
+/************************************************************************************
+* Function: dimWake
+*
+* Description:
+*   Sets the dimmer's activeLevel, and restarts the DIM_IDLE_MS inactivity count.
+*   Below DIM_LEVEL_FULL, the blanking is started with the lit part of a period if
+*   it isn't running already; at DIM_LEVEL_FULL, it is stopped, and if the blank
+*   part of a period was in progress, a change back to the lit part is marked for
+*   dimPopPhase, so the outputs are relit.
+*
+* Arguments:
+*   *dimmer     -   pointer to the dimmer object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void dimWake(DIMMER *const dimmer)
+{
+    unsigned short intState = __get_interrupt_state();
+
+    __disable_interrupt();
+
+    DIM_IDLE_CCR = DIM_TIMER_R + DIM_IDLE_STEP;
+    DIM_IDLE_CCTL = CCIE;
+    dimmer->idleStepsLeft = DIM_IDLE_STEPS;
+    dimSetLevel(dimmer, dimmer->activeLevel);
+
+    __set_interrupt_state(intState);
+}
+
+/************************************************************************************
+* Function: dimStop
+*
+* Description:
+*   Stops the blanking and the inactivity count at once, and leaves the dimmer at
+*   DIM_LEVEL_FULL, not blanked, with nothing pending. The outputs are left alone;
+*   this is for when the client turns them off, or takes them over, itself.
+*
+* Arguments:
+*   *dimmer     -   pointer to the dimmer object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void dimStop(DIMMER *const dimmer)
+{
+    unsigned short intState = __get_interrupt_state();
+
+    __disable_interrupt();
+
+    // this also clears any flags, so a compare that has already come up is never handled
+    DIM_PHASE_CCTL = 0;
+    DIM_IDLE_CCTL = 0;
+
+    dimmer->litTicks = dimmer->periodTicks;
+    dimmer->idleStepsLeft = 0;
+    dimmer->timerBlank = 0;
+    dimmer->phasePending = 0;
+    dimmer->blanked = 0;
+
+    __set_interrupt_state(intState);
+}
+
+/************************************************************************************
+* Function: dimPopPhase
+*
+* Description:
+*   Collects a change between the lit and blank parts of the period, updating
+*   DIM_BLANKED to match. The client should then blank or relight its outputs.
+*
+* Arguments:
+*   *dimmer     -   pointer to the dimmer object
+*
+* Returns:
+*   unsigned char noChange; 0 if a change was collected, 1 if none was pending
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char dimPopPhase(DIMMER *const dimmer)
+{
+    unsigned short intState;
+
+    if (!(dimmer->phasePending))
+        return 1;
+
+    intState = __get_interrupt_state();
+    __disable_interrupt();
+
+    // if the main loop fell more than a part behind, only the part in progress matters
+    dimmer->phasePending = 0;
+    dimmer->blanked = dimmer->timerBlank;
+
+    __set_interrupt_state(intState);
+
+    return 0;
+}
+
+/************************************************************************************
+* Function: dimISR
+*
+* Description:
+*   Moves on to the other part of the period, scheduling the next compare for the
+*   end of it; this should be called by the client's ISR for DIM_PHASE_CCR.
+*
+* Arguments:
+*   *dimmer     -   pointer to the dimmer object
+*
+* Returns:
+*   unsigned char noChange; 0 (so the main loop should be woken to blank or relight
+*   the outputs)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char dimISR(DIMMER *const dimmer)
+{
+    dimmer->timerBlank ^= 1;
+    DIM_PHASE_CCR += (dimmer->timerBlank) ? (dimmer->periodTicks - dimmer->litTicks) : dimmer->litTicks;
+    dimmer->phasePending = 1;
+
+    return 0;
+}
+
+/************************************************************************************
+* Function: dimIdleISR
+*
+* Description:
+*   Counts down one inactivity step, setting the dimmer's idleLevel once none are
+*   left; this should be called by the client's ISR for DIM_IDLE_CCR.
+*
+* Arguments:
+*   *dimmer     -   pointer to the dimmer object
+*
+* Returns:
+*   unsigned char noChange; 0 if a change back to the lit part of the period is
+*   pending (so the main loop should be woken to relight the outputs), otherwise 1
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char dimIdleISR(DIMMER *const dimmer)
+{
+    DIM_IDLE_CCR += DIM_IDLE_STEP;
+
+    if (!(--(dimmer->idleStepsLeft)))
+    {
+        DIM_IDLE_CCTL = 0;
+        dimSetLevel(dimmer, dimmer->idleLevel);
+    }
+
+    return (dimmer->phasePending) ? 0 : 1;
+}
+
+
+#endif /* DISP_DIMMING */
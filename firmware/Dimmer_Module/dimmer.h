@@ -0,0 +1,246 @@
+/************************************************************************************
+* Display Dimmer Module
+*
+* Contains a brightness control for displays and LEDs driven through shift registers
+* whose outputs can't be dimmed in hardware (the output enables are tied on). The
+* outputs are blanked for part of every DIM_PERIOD_HZ period instead, so they are
+* only lit for level / DIM_LEVEL_FULL of the time, drawing that much less current.
+* At DIM_LEVEL_FULL, the blanking compare is stopped and nothing is blanked.
+*
+* One compare channel of a timer running in continuous mode from ACLK (VLOCLK by
+* default) times the lit and blank parts of each period; the client's ISR for it
+* calls dimISR, which marks each change of part to be collected by the main loop
+* with dimPopPhase. The client then blanks every output or relights them itself;
+* no SPI writes are ever done from the ISR. While DIM_BLANKED, the client should
+* send its writes blank, and keep what they would have shown for the relight.
+*
+* A second compare channel of the same timer counts down DIM_IDLE_MS of inactivity
+* (in steps of DIM_IDLE_STEP_MS, so the CPU is only woken a few times along the way).
+* dimWake sets the object's activeLevel and restarts the count; the client calls it
+* for every key event. Once the count runs out, idleLevel is set until the next
+* dimWake. The client may change activeLevel and idleLevel at any time; they take
+* effect from the next dimWake or inactivity timeout.
+*
+* VLOCLK varies from about 4kHz to 20kHz between parts, so a period timed from its
+* typical frequency could come out slow enough to flicker. dimCalibrate counts the
+* ACLK cycles in DIM_CAL_PERIODS periods of MCLK cycles (which are calibrated), and
+* the period and level lengths are taken from that count instead of DIM_PERIOD and
+* DIM_LEVEL_TICKS. The inactivity count is still timed from DIM_ACLK_HZ, as it
+* only needs to be roughly right.
+*
+* Please note: the client must have started the timer (see DIM_TIMER_R) in
+* continuous mode from ACLK before calling dimCalibrate or dimWake, and must call
+* dimISR from the interrupt for DIM_PHASE_CCR and dimIdleISR from the interrupt for
+* DIM_IDLE_CCR; neither channel may be used for anything else.
+*
+* Setting DISP_DIMMING to 0 leaves the module's functions out of the build.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+
+#ifndef DIMMER_MODULE_DIMMER_H_
+#define DIMMER_MODULE_DIMMER_H_
+
+
+//########## SYMBOLIC CONSTANTS ##########//
+
+// user-defined constants
+#define DISP_DIMMING        0       // set to 1 to build the dimmer and blank the outputs for part of every period; 0 to leave it out entirely
+#define DIM_PERIOD_HZ       100     // blanking periods per second (high enough that the blanking can't be seen to flicker)
+#define DIM_LEVEL_FULL      8       // brightness levels run from 1 (lit for 1/DIM_LEVEL_FULL of each period) to DIM_LEVEL_FULL (never blanked)
+#define DIM_IDLE_MS         30000   // time without a dimWake before idleLevel is set, in milliseconds
+#define DIM_IDLE_STEP_MS    5000    // inactivity is counted down in steps of this long, in milliseconds (at most about 5400ms at the typical VLOCLK)
+#define DIM_ACLK_HZ         12000UL // frequency of ACLK, which the timer runs from (typical VLOCLK)
+#define DIM_MCLK_HZ         8000000UL   // frequency of MCLK while dimCalibrate runs, which ACLK is measured against
+#define DIM_CAL_PERIODS     4       // number of periods' worth of MCLK cycles dimCalibrate counts ACLK cycles over (MUST be a power of 2)
+
+// timer compare channels used for the blanking and the inactivity count; the timer itself must already be running in continuous mode from ACLK
+#define DIM_TIMER_R         TA1R
+#define DIM_PHASE_CCR       TA1CCR0
+#define DIM_PHASE_CCTL      TA1CCTL0
+#define DIM_IDLE_CCR        TA1CCR1
+#define DIM_IDLE_CCTL       TA1CCTL1
+
+// derived constants
+#define DIM_PERIOD          ((unsigned int)(DIM_ACLK_HZ / DIM_PERIOD_HZ))                  // number of ACLK cycles per blanking period
+#define DIM_LEVEL_TICKS     (DIM_PERIOD / DIM_LEVEL_FULL)                                   // number of ACLK cycles lit per brightness level
+#define DIM_CAL_CYCLES      ((DIM_CAL_PERIODS * DIM_MCLK_HZ) / DIM_PERIOD_HZ)               // number of MCLK cycles dimCalibrate counts ACLK cycles over
+#define DIM_IDLE_STEP       ((unsigned int)((DIM_IDLE_STEP_MS * DIM_ACLK_HZ) / 1000UL))    // number of ACLK cycles per inactivity step
+#define DIM_IDLE_STEPS      ((DIM_IDLE_MS + DIM_IDLE_STEP_MS - 1) / DIM_IDLE_STEP_MS)       // inactivity steps before idleLevel is set (rounded up)
+
+
+//########## PREPROCESSOR MACROS ##########//
+
+// evaluates as nonzero while the outputs should be blank, as of the last dimPopPhase
+#define DIM_BLANKED(dimmer)         ((dimmer)->blanked)
+
+// evaluates as nonzero if the dimmer has changed part of its period, and dimPopPhase has not collected it (for checking before entering a low power mode)
+#define DIM_PHASE_PENDING(dimmer)   ((dimmer)->phasePending)
+
+
+//########## STRUCTURES ##########//
+
+// state of a dimmer; timerBlank and phasePending are only set by the ISRs, and blanked is only changed by dimPopPhase (or dimStop)
+typedef struct DIMMER
+{
+    unsigned char activeLevel;              // level set by dimWake
+    unsigned char idleLevel;                // level set once DIM_IDLE_MS pass without a dimWake
+    unsigned int periodTicks;               // ACLK cycles per period (DIM_PERIOD until measured by dimCalibrate)
+    unsigned int levelTicks;                // ACLK cycles lit per brightness level (DIM_LEVEL_TICKS until measured by dimCalibrate)
+    volatile unsigned int litTicks;         // ACLK cycles lit per period at the current level
+    volatile unsigned char idleStepsLeft;   // inactivity steps left before idleLevel is set
+    volatile unsigned char timerBlank;      // set while the timer is timing the blank part of a period
+    volatile unsigned char phasePending;    // set once timerBlank has changed, until collected by dimPopPhase
+    unsigned char blanked;                  // timerBlank as of the last dimPopPhase; see DIM_BLANKED
+}
+DIMMER;
+
+
+//########## FUNCTION PROTOTYPES ##########//
+#if (DISP_DIMMING)
+
+/************************************************************************************
+* Function: dimInit
+*
+* Description:
+*   Initializes the given dimmer at DIM_LEVEL_FULL with its compare channels
+*   stopped, and with the given levels to be set by dimWake and the inactivity
+*   timeout.
+*
+* Arguments:
+*   *dimmer         -   pointer to the dimmer object
+*   activeLevel     -   level to set on dimWake (1 to DIM_LEVEL_FULL)
+*   idleLevel       -   level to set after DIM_IDLE_MS of inactivity (1 to DIM_LEVEL_FULL)
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void dimInit(DIMMER *const dimmer, const unsigned char activeLevel, const unsigned char idleLevel);
+
+/************************************************************************************
+* Function: dimCalibrate
+*
+* Description:
+*   Measures ACLK against MCLK, as described in the module header, and sets the
+*   dimmer's period and level lengths from it. If the count is too low to give
+*   every level at least one ACLK cycle (such as when ACLK isn't running), the
+*   typical DIM_PERIOD and DIM_LEVEL_TICKS are kept. Interrupts are disabled while
+*   counting, for DIM_CAL_CYCLES; this must be called with MCLK at DIM_MCLK_HZ,
+*   while the blanking is stopped (such as right after dimInit).
+*
+* Arguments:
+*   *dimmer     -   pointer to the dimmer object
+*
+* Returns:
+*   unsigned char calError; 0 if the lengths were measured, 1 if the typical ones
+*   were kept
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char dimCalibrate(DIMMER *const dimmer);
+
+/************************************************************************************
+* Function: dimWake
+*
+* Description:
+*   Sets the dimmer's activeLevel, and restarts the DIM_IDLE_MS inactivity count.
+*   Below DIM_LEVEL_FULL, the blanking is started with the lit part of a period if
+*   it isn't running already; at DIM_LEVEL_FULL, it is stopped, and if the blank
+*   part of a period was in progress, a change back to the lit part is marked for
+*   dimPopPhase, so the outputs are relit.
+*
+* Arguments:
+*   *dimmer     -   pointer to the dimmer object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void dimWake(DIMMER *const dimmer);
+
+/************************************************************************************
+* Function: dimStop
+*
+* Description:
+*   Stops the blanking and the inactivity count at once, and leaves the dimmer at
+*   DIM_LEVEL_FULL, not blanked, with nothing pending. The outputs are left alone;
+*   this is for when the client turns them off, or takes them over, itself.
+*
+* Arguments:
+*   *dimmer     -   pointer to the dimmer object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void dimStop(DIMMER *const dimmer);
+
+/************************************************************************************
+* Function: dimPopPhase
+*
+* Description:
+*   Collects a change between the lit and blank parts of the period, updating
+*   DIM_BLANKED to match. The client should then blank or relight its outputs.
+*
+* Arguments:
+*   *dimmer     -   pointer to the dimmer object
+*
+* Returns:
+*   unsigned char noChange; 0 if a change was collected, 1 if none was pending
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char dimPopPhase(DIMMER *const dimmer);
+
+/************************************************************************************
+* Function: dimISR
+*
+* Description:
+*   Moves on to the other part of the period, scheduling the next compare for the
+*   end of it; this should be called by the client's ISR for DIM_PHASE_CCR.
+*
+* Arguments:
+*   *dimmer     -   pointer to the dimmer object
+*
+* Returns:
+*   unsigned char noChange; 0 (so the main loop should be woken to blank or relight
+*   the outputs)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char dimISR(DIMMER *const dimmer);
+
+/************************************************************************************
+* Function: dimIdleISR
+*
+* Description:
+*   Counts down one inactivity step, setting the dimmer's idleLevel once none are
+*   left; this should be called by the client's ISR for DIM_IDLE_CCR.
+*
+* Arguments:
+*   *dimmer     -   pointer to the dimmer object
+*
+* Returns:
+*   unsigned char noChange; 0 if a change back to the lit part of the period is
+*   pending (so the main loop should be woken to relight the outputs), otherwise 1
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char dimIdleISR(DIMMER *const dimmer);
+
+#endif /* DISP_DIMMING */
+
+
+#endif /* DIMMER_MODULE_DIMMER_H_ */
@@ -0,0 +1,62 @@
+/************************************************************************************
+* Hardware Abstraction Module
+*
+* A thin register-abstraction shim, included by every module and client in place of
+* <msp430.h>. On the device, it simply includes <msp430.h>, and each of the hook
+* macros below compiles to either nothing or the same register access that was
+* written before; code size and timing are unchanged.
+*
+* When HOST_BUILD is defined (ex: -DHOST_BUILD on the gcc command line), "hostHal.h"
+* is included instead. It declares every register used by the firmware as a plain
+* variable, replaces the compiler intrinsics, and turns the hooks into calls to a
+* small peripheral model (see "hostHal.c"), so the unmodified modules and client
+* can be run and benchmarked on a PC (see "hostBenchClient.c").
+*
+* Hooks:
+*   HAL_SYNC()              -   called in every busy-wait loop, and wherever the
+*                               firmware relies on a pin or peripheral reacting to a
+*                               register write before it reads the result (ex: after
+*                               driving a keypad column), so the host model can
+*                               advance time and update its inputs/flags.
+*   HAL_SPI_TX(txBuf)       -   called right after a byte is written to a USCI TXBUF
+*                               (txBuf is the TXBUF address), so the host model can
+*                               record the byte and start a modelled transfer.
+*   HAL_PIN_SET(reg, mask)  -   sets/clears the given bits of an output register;
+*   HAL_PIN_CLR(reg, mask)      used for chip selects, so the host model can count
+*                               each chip select toggle.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+
+#ifndef HAL_MODULE_HAL_H_
+#define HAL_MODULE_HAL_H_
+
+
+//########## DEPENDENCIES ##########//
+#if defined(HOST_BUILD)
+#include "hostHal.h"
+#else
+#include <msp430.h>
+#endif
+
+
+//########## PREPROCESSOR MACROS ##########//
+#if defined(HOST_BUILD)
+
+#define HAL_SYNC()              hostHalSync()
+#define HAL_SPI_TX(txBuf)       hostHalSpiTx(txBuf)
+#define HAL_PIN_SET(reg, mask)  hostHalPinWrite(&(reg), (mask), 1)
+#define HAL_PIN_CLR(reg, mask)  hostHalPinWrite(&(reg), (mask), 0)
+
+#else
+
+#define HAL_SYNC()
+#define HAL_SPI_TX(txBuf)
+#define HAL_PIN_SET(reg, mask)  ((reg) |= (mask))
+#define HAL_PIN_CLR(reg, mask)  ((reg) &= ~(mask))
+
+#endif
+
+
+#endif /* HAL_MODULE_HAL_H_ */
@@ -0,0 +1,781 @@
+/************************************************************************************
+* See "hostHal.h" for general documentation of the host peripheral model.
+*
+* This file is only built on the host (it is excluded from the CCS project); see
+* "hostBenchClient.c" for the gcc command line.
+************************************************************************************/
+
+
+//########## DEPENDENCIES ##########//
+#include <stdio.h>
+#include <stdlib.h>
+#include "hal.h"
+
+
+//########## SYMBOLIC CONSTANTS ##########//
+#define HOST_NUM_PORTS      3       // ports 1 to 3
+#define HOST_CHAIN_LEN      16      // number of cascaded 8-bit shift registers modelled behind each output pin
+#define HOST_NUM_TIMERS     2       // Timer0_A3 and Timer1_A3
+#define HOST_NUM_USCIS      2       // USCI_A0 and USCI_B0
+#define HOST_SLEEP_STEP     (hostMclkHz() / HOST_ACLK_HZ)   // MCLK periods to advance per step while asleep (about 1 ACLK period)
+#define HOST_MAX_IDLE_CALLS 4       // consecutive hostHalIdle() calls without a wake-up before the model gives up
+#define HOST_MAX_KEYS       4       // matrix keys that can be held at once
+#define HOST_WDTCTL_RESET   0x6900  // what WDTCTL reads as after a reset (the password reads back as 0x69)
+#define HOST_SLAVE_BYTE_HZ  10000UL // bytes per second clocked into a USCI in slave mode by hostHalSpiSlaveXfer() (including the gap between bytes)
+#define HOST_SLAVE_BYTE_CYCLES  (hostMclkHz() / HOST_SLAVE_BYTE_HZ)    // MCLK periods per byte clocked in by the external master
+
+
+//########## STRUCTURES ##########//
+
+// addresses of one port's registers (IE/IES/IFG are 0 for ports without interrupts)
+typedef struct HOST_PORT
+{
+    volatile unsigned char *in, *out, *dir, *sel, *ren, *ie, *ies, *ifg;
+}
+HOST_PORT;
+
+typedef struct HOST_TIMER
+{
+    volatile unsigned int *ctl, *r, *ccr[3], *cctl[3];
+    unsigned long frac;             // clock periods not yet worth a whole timer tick, in MCLK periods * source/divider units
+    unsigned char background;       // CCRn bits (BIT0 << n) of compares left out of hostScheduled(); see hostHalSetBackground()
+}
+HOST_TIMER;
+
+typedef struct HOST_USCI
+{
+    volatile unsigned char *ctl1, *br0, *br1, *stat, *txBuf, *rxBuf;
+    unsigned char rxIfg, txIfg;     // bits within IFG2
+    unsigned char inFlight;         // set while a byte is being shifted out (UCBUSY)
+    unsigned char shiftByte;        // byte being shifted out
+    unsigned char txPending;        // set while a byte written to TXBUF waits for the shift register (TXBUF is double-buffered)
+    unsigned long cyclesLeft;       // MCLK periods until the byte has been completely shifted out
+    const unsigned char *slaveTx;   // next byte for the external master to clock in (slave mode, see hostHalSpiSlaveXfer)
+    unsigned char *slaveRx;         // where to store the next byte clocked back out to the external master
+    unsigned char slaveLeft;        // bytes the external master has left to clock in
+    unsigned long slaveCyclesLeft;  // MCLK periods until the external master's current byte is complete
+    unsigned char csUnwired[HOST_NUM_PORTS]; // chip select bits on each port that this USCI's SIMO/SCLK don't reach; see hostHalSetSpiBus()
+}
+HOST_USCI;
+
+
+//########## REGISTERS ##########//
+volatile unsigned char P1IN, P1OUT, P1DIR, P1SEL, P1SEL2, P1REN, P1IE, P1IES, P1IFG;
+volatile unsigned char P2IN, P2OUT, P2DIR, P2SEL, P2SEL2, P2REN, P2IE, P2IES, P2IFG;
+volatile unsigned char P3IN, P3OUT, P3DIR, P3SEL, P3SEL2, P3REN;
+volatile unsigned char UCA0CTL0, UCA0CTL1 = UCSWRST, UCA0BR0, UCA0BR1, UCA0STAT, UCA0TXBUF, UCA0RXBUF;
+volatile unsigned char UCB0CTL0, UCB0CTL1 = UCSWRST, UCB0BR0, UCB0BR1, UCB0STAT, UCB0TXBUF, UCB0RXBUF;
+volatile unsigned char IFG1 = PORIFG, IFG2 = UCA0TXIFG | UCB0TXIFG, IE1, IE2;
+volatile unsigned char BCSCTL1 = 0x87, BCSCTL2, BCSCTL3, DCOCTL = 0x60;
+volatile unsigned char CALBC1_1MHZ = 0x86, CALDCO_1MHZ = 0xB6, CALBC1_8MHZ = 0x8D, CALDCO_8MHZ = 0x92, CALBC1_16MHZ = 0x8F, CALDCO_16MHZ = 0x95;
+volatile unsigned int WDTCTL = HOST_WDTCTL_RESET;
+volatile unsigned int TA0CTL, TA0R, TA0CCR0, TA0CCR1, TA0CCR2, TA0CCTL0, TA0CCTL1, TA0CCTL2, TA0IV;
+volatile unsigned int TA1CTL, TA1R, TA1CCR0, TA1CCR1, TA1CCR2, TA1CCTL0, TA1CCTL1, TA1CCTL2, TA1IV;
+volatile unsigned int ADC10CTL0, ADC10CTL1, ADC10MEM;
+
+
+//########## PRIVATE GLOBALS ##########//
+static const HOST_PORT hostPorts[HOST_NUM_PORTS] =
+{
+    {&P1IN, &P1OUT, &P1DIR, &P1SEL, &P1REN, &P1IE, &P1IES, &P1IFG},
+    {&P2IN, &P2OUT, &P2DIR, &P2SEL, &P2REN, &P2IE, &P2IES, &P2IFG},
+    {&P3IN, &P3OUT, &P3DIR, &P3SEL, &P3REN, 0, 0, 0}
+};
+
+static HOST_TIMER hostTimers[HOST_NUM_TIMERS] =
+{
+    {&TA0CTL, &TA0R, {&TA0CCR0, &TA0CCR1, &TA0CCR2}, {&TA0CCTL0, &TA0CCTL1, &TA0CCTL2}, 0, 0},
+    {&TA1CTL, &TA1R, {&TA1CCR0, &TA1CCR1, &TA1CCR2}, {&TA1CCTL0, &TA1CCTL1, &TA1CCTL2}, 0, 0}
+};
+
+static HOST_USCI hostUscis[HOST_NUM_USCIS] =
+{
+    {&UCA0CTL1, &UCA0BR0, &UCA0BR1, &UCA0STAT, &UCA0TXBUF, &UCA0RXBUF, UCA0RXIFG, UCA0TXIFG, 0, 0, 0, 0, 0, 0, 0, 0, {0, 0, 0}},
+    {&UCB0CTL1, &UCB0BR0, &UCB0BR1, &UCB0STAT, &UCB0TXBUF, &UCB0RXBUF, UCB0RXIFG, UCB0TXIFG, 0, 0, 0, 0, 0, 0, 0, 0, {0, 0, 0}}
+};
+
+static HOST_ISR hostIsrs[HOST_NUM_VECTORS];
+static HOST_HAL_STATS hostStats;
+
+static unsigned char hostGie = 0;                       // modelled GIE bit
+static unsigned char hostWake = 0;                      // set by __bic_SR_register_on_exit to leave a low power mode
+static unsigned char hostSmclkOff = 0;                  // set while in a low power mode that stops SMCLK (LPM1 and deeper)
+static unsigned char hostInIsr = 0;                     // interrupts don't nest on the MSP430 unless an ISR sets GIE itself
+
+static unsigned char hostDriveMask[HOST_NUM_PORTS];     // pins driven by the bench
+static unsigned char hostDriveLevel[HOST_NUM_PORTS];    // levels of the pins driven by the bench
+static unsigned char hostKeyPort = 0;                   // port holding the pressed keys' row and column pins (1 to 3)
+static unsigned char hostKeyCoords[HOST_MAX_KEYS];      // coordinates of the pressed keys, in the "mtrxKeypad.h" format
+static unsigned char hostNumKeys = 0;                   // number of pressed keys
+
+static unsigned long long hostNow = 0;                  // MCLK periods since reset
+static unsigned long long hostAlarmAt = 0;              // time at which to call hostHalIdle() even if the CPU isn't idle, or 0 if no alarm is set
+static unsigned char hostAlarmWait = 0;                 // set by hostHalWait() to keep the CPU asleep until the alarm, even with nothing scheduled
+
+static unsigned int hostSupplyMv = HOST_SUPPLY_MV;      // modelled VCC, in millivolts
+static unsigned long hostAdcCyclesLeft = 0;             // MCLK periods until the ADC10 conversion in progress is complete, or 0 if there is none
+
+static unsigned char hostChain[HOST_NUM_PORTS][8][HOST_CHAIN_LEN];    // bytes sent while each output pin was HIGH, most recent first (ex: the byte shown by a display)
+
+
+//########## PRIVATE FUNCTIONS ##########//
+
+// returns the modelled DCO frequency, from the calibration constants loaded into BCSCTL1 (RSELx only) and DCOCTL
+static unsigned long hostMclkHz(void)
+{
+    if (((BCSCTL1 & 0x0F) == (CALBC1_16MHZ & 0x0F)) && (DCOCTL == CALDCO_16MHZ))
+        return 16000000UL;
+    if (((BCSCTL1 & 0x0F) == (CALBC1_8MHZ & 0x0F)) && (DCOCTL == CALDCO_8MHZ))
+        return 8000000UL;
+    if (((BCSCTL1 & 0x0F) == (CALBC1_1MHZ & 0x0F)) && (DCOCTL == CALDCO_1MHZ))
+        return 1000000UL;
+    return HOST_MCLK_HZ;
+}
+
+// recalculates the input register of every port, setting PxIFG bits on the selected edges
+static void hostUpdateInputs(void)
+{
+    const HOST_PORT *port;
+    unsigned char portIndex;
+    unsigned char level;
+    unsigned char colBit;
+    unsigned char rowBit;
+    unsigned char rowsConnected;
+    unsigned char rowsHigh;
+    unsigned char key;
+    unsigned char edges;
+
+    for (portIndex = 0; portIndex < HOST_NUM_PORTS; portIndex++)
+    {
+        port = &hostPorts[portIndex];
+
+        // outputs read back their own level, inputs follow the bench or their pull resistor (floating inputs read LOW)
+        level = (*(port->dir) & *(port->out));
+        level |= ~(*(port->dir)) & hostDriveMask[portIndex] & hostDriveLevel[portIndex];
+        level |= ~(*(port->dir)) & ~hostDriveMask[portIndex] & *(port->ren) & *(port->out);
+
+        /* a pressed matrix key connects its column pin to its row pin, so a driven column overrides the row's pull resistor; a row connected
+         * to several driven columns reads HIGH if any of them are HIGH (ghost keys through other connections are not modelled) */
+        if ((portIndex + 1) == hostKeyPort)
+        {
+            rowsConnected = 0;
+            rowsHigh = 0;
+            for (key = 0; key < hostNumKeys; key++)
+            {
+                colBit = BIT0 << (hostKeyCoords[key] >> 4);
+                rowBit = BIT0 << (hostKeyCoords[key] & 0x0F);
+                if (*(port->dir) & colBit)
+                {
+                    rowsConnected |= rowBit;
+                    if (*(port->out) & colBit)
+                        rowsHigh |= rowBit;
+                }
+            }
+            level = (level & ~rowsConnected) | rowsHigh;
+        }
+
+        if (port->ifg)
+        {
+            edges = (level ^ *(port->in)) & ~(*(port->dir));
+            *(port->ifg) |= edges & (level & ~(*(port->ies)));      // L->H edges where PxIES is clear
+            *(port->ifg) |= edges & (~level & *(port->ies));        // H->L edges where PxIES is set
+        }
+        *(port->in) = level;
+    }
+}
+
+// advances one timer by the given number of MCLK periods
+static void hostAdvanceTimer(HOST_TIMER *const timer, const unsigned long cycles)
+{
+    unsigned int ctl = *(timer->ctl);
+    unsigned long perTick;          // MCLK periods per timer tick, scaled by HOST_ACLK_HZ so ACLK ticks stay exact
+    unsigned long ticks;
+    unsigned int count;
+    unsigned char chan;
+
+    // TACLR resets the count and divider, then clears itself
+    if (ctl & TACLR)
+    {
+        *(timer->r) = 0;
+        *(timer->ctl) &= ~TACLR;
+        timer->frac = 0;
+    }
+
+    if ((ctl & MC_3) == MC_0)
+        return;
+
+    if ((ctl & (TASSEL_1 | TASSEL_2)) == TASSEL_2)
+    {
+        if (hostSmclkOff)
+            return;
+        perTick = HOST_ACLK_HZ;
+    }
+    else if ((ctl & (TASSEL_1 | TASSEL_2)) == TASSEL_1)
+        perTick = hostMclkHz();
+    else
+        return;                     // TACLK/INCLK are not modelled
+
+    perTick <<= ((ctl & ID_3) >> 6);
+    timer->frac += cycles * HOST_ACLK_HZ;
+    ticks = timer->frac / perTick;
+    timer->frac -= ticks * perTick;
+
+    // step one tick at a time, so every compare match and rollover is flagged
+    while (ticks--)
+    {
+        count = (unsigned short)(*(timer->r));
+
+        if (((ctl & MC_3) == MC_1) && (count >= (unsigned short)(*(timer->ccr[0]))))
+        {
+            count = 0;
+            *(timer->ctl) |= TAIFG;
+        }
+        else if (count == 0xFFFF)
+        {
+            count = 0;
+            *(timer->ctl) |= TAIFG;
+        }
+        else
+            count++;
+
+        *(timer->r) = count;
+
+        for (chan = 0; chan < 3; chan++)
+        {
+            if (count == (unsigned short)(*(timer->ccr[chan])))
+                *(timer->cctl[chan]) |= CCIFG;
+        }
+    }
+}
+
+// returns what the ADC10 would convert the selected channel to, against the selected reference
+static unsigned int hostAdcCode(void)
+{
+    unsigned long refMv;
+    unsigned long code;
+
+    if ((ADC10CTL1 & 0xF000) != INCH_11)
+        return 0;
+
+    if ((ADC10CTL0 & SREF_1) && (ADC10CTL0 & REFON))
+        refMv = (ADC10CTL0 & REF2_5V) ? 2500 : 1500;
+    else
+        refMv = hostSupplyMv;
+
+    code = ((hostSupplyMv / 2UL) * 1023UL) / refMv;
+    return (code > 1023) ? 1023 : (unsigned int)code;
+}
+
+// moves TXBUF into the shift register; the byte is seen by every slave whose (active HIGH) chip select is asserted right now
+static void hostStartShift(HOST_USCI *const usci)
+{
+    unsigned char index;
+    unsigned char bit;
+    unsigned char csState;
+    unsigned char depth;
+    unsigned int sclkDiv;
+
+    hostStats.spiBytes++;
+    hostStats.trafficSig = (hostStats.trafficSig * 31) + *(usci->txBuf);
+    for (index = 0; index < HOST_NUM_PORTS; index++)
+    {
+        csState = *(hostPorts[index].out) & *(hostPorts[index].dir) & ~(*(hostPorts[index].sel)) & ~(usci->csUnwired[index]);
+        hostStats.trafficSig = (hostStats.trafficSig * 31) + csState;
+        for (bit = 0; bit < 8; bit++)
+        {
+            if (csState & (BIT0 << bit))
+            {
+                // each byte pushes the previous ones one register further down the chain
+                for (depth = HOST_CHAIN_LEN - 1; depth; depth--)
+                    hostChain[index][bit][depth] = hostChain[index][bit][depth - 1];
+                hostChain[index][bit][0] = *(usci->txBuf);
+            }
+        }
+    }
+
+    // 8 SCLK periods, with SCLK = SMCLK / UCxBR (a divider of 0 acts as 1); TXBUF is free again as soon as the byte has moved
+    sclkDiv = *(usci->br0) | ((unsigned int)*(usci->br1) << 8);
+    usci->cyclesLeft = 8UL * ((sclkDiv) ? sclkDiv : 1);
+    usci->shiftByte = *(usci->txBuf);
+    usci->inFlight = 1;
+    *(usci->stat) |= UCBUSY;
+    IFG2 |= usci->txIfg;
+}
+
+// advances every modelled peripheral by the given number of MCLK periods
+static void hostAdvance(const unsigned long cycles)
+{
+    HOST_USCI *usci;
+    unsigned char index;
+
+    hostNow += cycles;
+
+    for (index = 0; index < HOST_NUM_TIMERS; index++)
+        hostAdvanceTimer(&hostTimers[index], cycles);
+
+    // ADC10SC starts a conversion and clears itself; ADC10OSC keeps running in every low power mode
+    if (((ADC10CTL0 & (ADC10ON | ENC | ADC10SC)) == (ADC10ON | ENC | ADC10SC)) && !hostAdcCyclesLeft)
+    {
+        ADC10CTL0 &= ~ADC10SC;
+        ADC10CTL1 |= ADC10BUSY;
+        hostAdcCyclesLeft = (hostMclkHz() / 1000000UL) * HOST_ADC_US;
+    }
+    else if (hostAdcCyclesLeft)
+    {
+        if (hostAdcCyclesLeft > cycles)
+            hostAdcCyclesLeft -= cycles;
+        else
+        {
+            hostAdcCyclesLeft = 0;
+            ADC10MEM = hostAdcCode();
+            ADC10CTL0 |= ADC10IFG;
+            ADC10CTL1 &= ~ADC10BUSY;
+        }
+    }
+
+    for (index = 0; index < HOST_NUM_USCIS; index++)
+    {
+        usci = &hostUscis[index];
+        if (usci->inFlight && !hostSmclkOff)
+        {
+            if (usci->cyclesLeft > cycles)
+                usci->cyclesLeft -= cycles;
+            else
+            {
+                // shifting is complete; the byte comes back in through loopback, and a byte waiting in TXBUF starts right away
+                *(usci->rxBuf) = usci->shiftByte;
+                IFG2 |= usci->rxIfg;
+                if (usci->txPending)
+                {
+                    usci->txPending = 0;
+                    hostStartShift(usci);
+                }
+                else
+                {
+                    usci->inFlight = 0;
+                    *(usci->stat) &= ~UCBUSY;
+                }
+            }
+        }
+
+        // the external master clocks on its own, so bytes keep arriving in any low power mode
+        if (usci->slaveLeft && !(*(usci->ctl1) & UCSWRST))
+        {
+            if (usci->slaveCyclesLeft > cycles)
+                usci->slaveCyclesLeft -= cycles;
+            else
+            {
+                // the whole byte has been clocked; the master got whatever TXBUF held (the byte's clock edges are not modelled separately)
+                *(usci->slaveRx++) = *(usci->txBuf);
+                *(usci->rxBuf) = *(usci->slaveTx++);
+                IFG2 |= usci->rxIfg | usci->txIfg;
+                usci->slaveLeft--;
+                usci->slaveCyclesLeft = HOST_SLAVE_BYTE_CYCLES;
+            }
+        }
+    }
+
+    hostUpdateInputs();
+}
+
+// returns the highest priority interrupt that is pending and enabled, or 0 if there are none
+static unsigned char hostPendingVector(void)
+{
+    if ((TA1CCTL0 & CCIE) && (TA1CCTL0 & CCIFG))
+        return TIMER1_A0_VECTOR;
+    if (((TA1CCTL1 & CCIE) && (TA1CCTL1 & CCIFG)) || ((TA1CCTL2 & CCIE) && (TA1CCTL2 & CCIFG)) || ((TA1CTL & TAIE) && (TA1CTL & TAIFG)))
+        return TIMER1_A1_VECTOR;
+    if ((TA0CCTL0 & CCIE) && (TA0CCTL0 & CCIFG))
+        return TIMER0_A0_VECTOR;
+    if (((TA0CCTL1 & CCIE) && (TA0CCTL1 & CCIFG)) || ((TA0CCTL2 & CCIE) && (TA0CCTL2 & CCIFG)) || ((TA0CTL & TAIE) && (TA0CTL & TAIFG)))
+        return TIMER0_A1_VECTOR;
+    if (IFG2 & IE2 & (UCA0RXIFG | UCB0RXIFG))
+        return USCIAB0RX_VECTOR;
+    if (IFG2 & IE2 & (UCA0TXIFG | UCB0TXIFG))
+        return USCIAB0TX_VECTOR;
+    if ((ADC10CTL0 & ADC10IE) && (ADC10CTL0 & ADC10IFG))
+        return ADC10_VECTOR;
+    if (P2IFG & P2IE)
+        return PORT2_VECTOR;
+    if (P1IFG & P1IE)
+        return PORT1_VECTOR;
+    return 0;
+}
+
+// returns the TAxIV value for a timer's CCR1/CCR2/TAIFG interrupts, clearing the flag that was reported (as reading TAxIV does)
+static unsigned int hostReadTimerIv(HOST_TIMER *const timer)
+{
+    unsigned int iv = 0;
+
+    if ((*(timer->cctl[1]) & CCIE) && (*(timer->cctl[1]) & CCIFG))
+    {
+        *(timer->cctl[1]) &= ~CCIFG;
+        iv = TA0IV_TACCR1;
+    }
+    else if ((*(timer->cctl[2]) & CCIE) && (*(timer->cctl[2]) & CCIFG))
+    {
+        *(timer->cctl[2]) &= ~CCIFG;
+        iv = TA0IV_TACCR2;
+    }
+    else if ((*(timer->ctl) & TAIE) && (*(timer->ctl) & TAIFG))
+    {
+        *(timer->ctl) &= ~TAIFG;
+        iv = TA0IV_TAIFG;
+    }
+
+    return iv;
+}
+
+// calls the ISRs of every pending interrupt while GIE is set, as the CPU would between instructions
+static void hostDispatch(void)
+{
+    unsigned char vector;
+
+    while (hostGie && !hostInIsr && (vector = hostPendingVector()))
+    {
+        if (!hostIsrs[vector])
+        {
+            fprintf(stderr, "hostHal: interrupt %u is pending, but no ISR is registered for it\n", vector);
+            exit(2);
+        }
+
+        // the CCR0 and ADC10IFG flags are cleared on entry, and the TAxIV registers are latched as if the ISR read them
+        if (vector == ADC10_VECTOR)
+            ADC10CTL0 &= ~ADC10IFG;
+        else if (vector == TIMER0_A0_VECTOR)
+            TA0CCTL0 &= ~CCIFG;
+        else if (vector == TIMER1_A0_VECTOR)
+            TA1CCTL0 &= ~CCIFG;
+        else if (vector == TIMER0_A1_VECTOR)
+            TA0IV = hostReadTimerIv(&hostTimers[0]);
+        else if (vector == TIMER1_A1_VECTOR)
+            TA1IV = hostReadTimerIv(&hostTimers[1]);
+
+        hostGie = 0;
+        hostInIsr = 1;
+        hostStats.isrCalls++;
+        hostStats.activeCycles += HOST_ISR_CYCLES;
+        hostAdvance(HOST_ISR_CYCLES);
+        hostIsrs[vector]();
+        hostInIsr = 0;
+        hostGie = 1;
+    }
+}
+
+// runs the CPU for the given number of active cycles, taking interrupts along the way
+static void hostRun(unsigned long cycles)
+{
+    unsigned long chunk;
+
+    do
+    {
+        chunk = (cycles > HOST_SLEEP_STEP) ? HOST_SLEEP_STEP : cycles;
+        hostStats.activeCycles += chunk;
+        hostAdvance(chunk);
+        hostDispatch();
+        cycles -= chunk;
+
+        // a WDTCTL write without WDTPW resets the device
+        if (((WDTCTL & 0xFF00) != WDTPW) && ((WDTCTL & 0xFF00) != (HOST_WDTCTL_RESET & 0xFF00)))
+            hostHalReset();
+
+        // a busy-wait with interrupts disabled never sleeps, so an expired alarm is handled here instead
+        if (!hostGie && !hostInIsr && hostAlarmAt && (hostNow >= hostAlarmAt))
+        {
+            hostAlarmAt = 0;
+            hostAlarmWait = 0;
+            hostHalIdle();
+        }
+    }
+    while (cycles);
+}
+
+// returns nonzero if some modelled peripheral will eventually raise an enabled interrupt without outside stimulus
+static unsigned char hostScheduled(void)
+{
+    unsigned char index;
+    unsigned char chan;
+
+    for (index = 0; index < HOST_NUM_USCIS; index++)
+    {
+        if (hostUscis[index].inFlight || hostUscis[index].slaveLeft)
+            return 1;
+    }
+
+    if (hostAdcCyclesLeft)
+        return 1;
+
+    for (index = 0; index < HOST_NUM_TIMERS; index++)
+    {
+        if ((*(hostTimers[index].ctl) & MC_3) == MC_0)
+            continue;
+        if (*(hostTimers[index].ctl) & TAIE)
+            return 1;
+        for (chan = 0; chan < 3; chan++)
+        {
+            if ((*(hostTimers[index].cctl[chan]) & CCIE) && !(hostTimers[index].background & (BIT0 << chan)))
+                return 1;
+        }
+    }
+
+    return 0;
+}
+
+
+//########## INTRINSICS ##########//
+
+void __delay_cycles(unsigned long cycles)
+{
+    if (cycles)
+        hostRun(cycles);
+}
+
+void __enable_interrupt(void)
+{
+    hostGie = 1;
+    hostDispatch();
+}
+
+void __disable_interrupt(void)
+{
+    hostGie = 0;
+}
+
+unsigned short __get_interrupt_state(void)
+{
+    return (hostGie) ? GIE : 0;
+}
+
+void __set_interrupt_state(unsigned short state)
+{
+    hostGie = (state & GIE) ? 1 : 0;
+    hostDispatch();
+}
+
+void __bis_SR_register(unsigned short bits)
+{
+    unsigned char idleCalls = 0;
+
+    if (bits & GIE)
+        hostGie = 1;
+
+    if (!(bits & CPUOFF))
+    {
+        hostDispatch();
+        return;
+    }
+
+    // sleep until an ISR clears CPUOFF on exit; time passes, but no active cycles are spent
+    hostWake = 0;
+    hostSmclkOff = (bits & SCG1) ? 1 : 0;
+    while (1)
+    {
+        hostDispatch();
+        if (hostWake)
+            break;
+
+        if (hostAlarmAt && (hostNow >= hostAlarmAt))
+        {
+            hostAlarmAt = 0;
+            hostAlarmWait = 0;
+            hostHalIdle();
+            idleCalls = 0;
+        }
+        else if (hostScheduled() || hostAlarmWait)
+        {
+            hostStats.sleepCycles += HOST_SLEEP_STEP;
+            hostAdvance(HOST_SLEEP_STEP);
+            idleCalls = 0;
+        }
+        else if (idleCalls++ < HOST_MAX_IDLE_CALLS)
+            hostHalIdle();
+        else
+        {
+            fprintf(stderr, "hostHal: the CPU is asleep with nothing scheduled, and the bench has no more stimulus\n");
+            exit(2);
+        }
+    }
+    hostSmclkOff = 0;
+}
+
+void __bic_SR_register_on_exit(unsigned short bits)
+{
+    if (bits & CPUOFF)
+        hostWake = 1;
+}
+
+
+//########## HAL HOOKS ##########//
+
+void hostHalSync(void)
+{
+    hostRun(HOST_POLL_CYCLES);
+}
+
+void hostHalSpiTx(volatile unsigned char *const txBuf)
+{
+    HOST_USCI *usci = 0;
+    unsigned char index;
+
+    for (index = 0; index < HOST_NUM_USCIS; index++)
+    {
+        if (hostUscis[index].txBuf == txBuf)
+            usci = &hostUscis[index];
+    }
+    if (!usci)
+    {
+        fprintf(stderr, "hostHal: HAL_SPI_TX called on an unknown TXBUF\n");
+        exit(2);
+    }
+
+    // while a byte is shifting, the new one waits in TXBUF (with TXIFG clear) until the shift register is free
+    if (usci->inFlight)
+    {
+        usci->txPending = 1;
+        IFG2 &= ~(usci->txIfg);
+    }
+    else
+        hostStartShift(usci);
+
+    hostRun(HOST_TX_CYCLES);
+}
+
+void hostHalPinWrite(volatile unsigned char *const reg, const unsigned char mask, const unsigned char level)
+{
+    unsigned char next = (level) ? (*reg | mask) : (*reg & ~mask);
+    unsigned char changed = next ^ *reg;
+
+    while (changed)
+    {
+        hostStats.csToggles += changed & BIT0;
+        changed >>= 1;
+    }
+    *reg = next;
+
+    hostRun(HOST_PIN_CYCLES);
+}
+
+
+//########## BENCH INTERFACE ##########//
+
+// registers the function to call for an interrupt vector (#pragma vector has no effect on the host)
+void hostHalSetIsr(const unsigned char vector, const HOST_ISR isr)
+{
+    if (vector < HOST_NUM_VECTORS)
+        hostIsrs[vector] = isr;
+}
+
+// drives the given pins of a port (1 to 3) HIGH or LOW from outside the MCU, as a button or another device would
+void hostHalDrivePin(const unsigned char port, const unsigned char mask, const unsigned char level)
+{
+    hostDriveMask[port - 1] |= mask;
+    hostDriveLevel[port - 1] = (level) ? (hostDriveLevel[port - 1] | mask) : (hostDriveLevel[port - 1] & ~mask);
+    hostUpdateInputs();
+}
+
+// stops driving the given pins of a port, leaving them to their pull resistors
+void hostHalReleasePin(const unsigned char port, const unsigned char mask)
+{
+    hostDriveMask[port - 1] &= ~mask;
+    hostUpdateInputs();
+}
+
+// presses the matrix key at the given (column, row) coordinate, with both pins on the same port; keys already held stay held
+void hostHalPressKey(const unsigned char port, const unsigned char keyCoord)
+{
+    hostKeyPort = port;
+    if (hostNumKeys < HOST_MAX_KEYS)
+        hostKeyCoords[hostNumKeys++] = keyCoord;
+    hostUpdateInputs();
+}
+
+// releases every pressed matrix key
+void hostHalReleaseKeys(void)
+{
+    hostNumKeys = 0;
+    hostUpdateInputs();
+}
+
+/* has an external SPI master clock len bytes into the USCI with the given RXBUF (set up as a slave), one every HOST_SLAVE_BYTE_CYCLES;
+ * the byte clocked back out with each one is stored in rxBytes. Both arrays must stay valid until the bytes have all been clocked. */
+void hostHalSpiSlaveXfer(volatile unsigned char *const rxBuf, const unsigned char *const txBytes, unsigned char *const rxBytes, const unsigned char len)
+{
+    HOST_USCI *usci = 0;
+    unsigned char index;
+
+    for (index = 0; index < HOST_NUM_USCIS; index++)
+    {
+        if (hostUscis[index].rxBuf == rxBuf)
+            usci = &hostUscis[index];
+    }
+    if (!usci)
+    {
+        fprintf(stderr, "hostHal: hostHalSpiSlaveXfer called on an unknown RXBUF\n");
+        exit(2);
+    }
+
+    usci->slaveTx = txBytes;
+    usci->slaveRx = rxBytes;
+    usci->slaveLeft = len;
+    usci->slaveCyclesLeft = HOST_SLAVE_BYTE_CYCLES;
+}
+
+// has hostHalIdle() called once the given time has passed, the next time the CPU sleeps, even if something is still scheduled
+void hostHalSetAlarm(const unsigned int ms)
+{
+    hostAlarmAt = hostNow + (((unsigned long long)ms * hostMclkHz()) / 1000);
+}
+
+// the same as hostHalSetAlarm(), but hostHalIdle() isn't called before then, even while nothing is scheduled, so the firmware is left to run for that long
+void hostHalWait(const unsigned int ms)
+{
+    hostHalSetAlarm(ms);
+    hostAlarmWait = 1;
+}
+
+// leaves a compare channel (CCR0 to CCR2) of a timer (0 or 1) out of hostScheduled(), for one that fires forever in the background
+void hostHalSetBackground(const unsigned char timer, const unsigned char chan)
+{
+    if ((timer < HOST_NUM_TIMERS) && (chan < 3))
+        hostTimers[timer].background |= BIT0 << chan;
+}
+
+// wires the given chip select bits of a port (1 to 3) to one USCI (0 for USCI_A0, 1 for USCI_B0) only, so bytes sent by any other USCI don't reach them
+void hostHalSetSpiBus(const unsigned char usci, const unsigned char port, const unsigned char csMask)
+{
+    unsigned char index;
+
+    if ((usci >= HOST_NUM_USCIS) || !port || (port > HOST_NUM_PORTS))
+        return;
+
+    for (index = 0; index < HOST_NUM_USCIS; index++)
+    {
+        if (index == usci)
+            hostUscis[index].csUnwired[port - 1] &= ~csMask;
+        else
+            hostUscis[index].csUnwired[port - 1] |= csMask;
+    }
+}
+
+// sets the modelled VCC, as read by the ADC10's (VCC - VSS)/2 channel
+void hostHalSetSupply(const unsigned int mv)
+{
+    hostSupplyMv = mv;
+}
+
+// returns the last byte sent while the given output pin (port 1 to 3, bit 0 to 7) was HIGH
+unsigned char hostHalLastByte(const unsigned char port, const unsigned char bit)
+{
+    return hostChain[port - 1][bit][0];
+}
+
+// returns the byte held by a register depth places down a chain of cascaded shift registers behind the given output pin (0 is the nearest)
+unsigned char hostHalChainByte(const unsigned char port, const unsigned char bit, const unsigned char depth)
+{
+    return (depth < HOST_CHAIN_LEN) ? hostChain[port - 1][bit][depth] : 0;
+}
+
+const HOST_HAL_STATS *hostHalGetStats(void)
+{
+    return &hostStats;
+}
@@ -0,0 +1,283 @@
+/************************************************************************************
+* Host Peripheral Model (HOST_BUILD only)
+*
+* Included by "hal.h" in place of <msp430.h> when HOST_BUILD is defined. Every
+* MSP430G2353 register used by the firmware is declared here as a plain variable
+* (defined in "hostHal.c"), along with the bit/vector constants and replacements
+* for the compiler intrinsics, so the firmware can be compiled with gcc.
+*
+* The registers are driven by a small, deliberately simple peripheral model:
+*   - Time advances in MCLK periods. MCLK/SMCLK run at 1, 8, or 16MHz while
+*     BCSCTL1/DCOCTL hold the matching calibration constants, or HOST_MCLK_HZ
+*     otherwise (MCLK/SMCLK dividers are not modelled). Active CPU time is only
+*     modelled for busy-wait loops (HAL_SYNC), __delay_cycles, pin/TXBUF writes,
+*     and interrupt entry/exit; straight-line C code is not cycle counted, so
+*     cycle figures are best used to compare one firmware revision to another.
+*   - Timer0_A/Timer1_A count from ACLK (HOST_ACLK_HZ, the VLO) or SMCLK (MCLK)
+*     with their ID divider, in up or continuous mode, setting CCIFG/TAIFG.
+*   - USCI_A0/USCI_B0 shift a TXBUF byte out in 8 SCLK periods (SMCLK / UCxBR),
+*     then set RXIFG; RXBUF receives the byte back (loopback). TXBUF is double
+*     buffered: TXIFG is set again as soon as a byte moves into the shift
+*     register, a byte written while one is shifting starts right after it, and
+*     UCxSTAT's UCBUSY is set until the shift register is empty.
+*   - The bench can also act as an external SPI master with hostHalSpiSlaveXfer(),
+*     clocking bytes into a slave mode USCI's RXBUF (setting RXIFG and TXIFG) at
+*     HOST_SLAVE_BYTE_HZ, and collecting whatever TXBUF held for each one.
+*   - The ADC10 converts once ENC and ADC10SC are set while ADC10ON is, taking
+*     HOST_ADC_US, then sets ADC10IFG (and clears ADC10BUSY). Only the (VCC - VSS)/2
+*     channel is modelled, against VREF+ (1.5V or 2.5V) or VCC, with VCC set by
+*     hostHalSetSupply() (HOST_SUPPLY_MV by default); other channels read 0.
+*   - Port 1-3 inputs follow their pull resistors, outputs, pins driven by the
+*     bench, and pressed matrix keys (a pressed key connects its column pin to
+*     its row pin); port 1/2 edges set PxIFG according to PxIES.
+*   - Interrupts are dispatched by priority whenever GIE is set, to the ISRs
+*     registered with hostHalSetIsr(); in a low power mode, time is advanced until
+*     an ISR wakes the CPU with __bic_SR_register_on_exit().
+*   - The watchdog timer itself is not modelled, only its password: once WDTCTL
+*     has been written with anything but WDTPW in its upper byte, the next
+*     modelled cycle is a PUC, which is handed to the bench's hostHalReset() (the
+*     firmware can't be restarted within the same process).
+*
+* When the CPU sleeps and nothing is scheduled (no enabled timer compare, SPI
+* transfer, or ADC10 conversion in progress, and no bytes left for an external master
+* to clock in), or the CPU sleeps after an alarm set with hostHalSetAlarm()
+* has expired, the bench's hostHalIdle() is called to apply the next scripted
+* stimulus; it must either change an input or end the program. An alarm set with
+* hostHalWait() instead holds off hostHalIdle() until it expires, so the firmware
+* can be left to run for a while with nothing pressed. An expired alarm is also
+* handled in a busy-wait with GIE cleared outside of an ISR (such as a fault handler
+* polling a pin), as that can't end in the CPU sleeping. Timer compares that
+* fire forever in the background (such as a periodic sampler) can be left out of
+* this with hostHalSetBackground(); they are still modelled while time passes.
+*
+* Chip selects are assumed to be active HIGH, as on the Gemini control board. Every
+* chip select hears both USCIs unless hostHalSetSpiBus() wires it to just one.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+
+#ifndef HAL_MODULE_HOSTHAL_H_
+#define HAL_MODULE_HOSTHAL_H_
+
+
+//########## SYMBOLIC CONSTANTS ##########//
+
+// modelled clocks
+#ifndef HOST_MCLK_HZ
+#define HOST_MCLK_HZ        1100000UL   // MCLK/SMCLK frequency of the uncalibrated power-up DCO
+#endif
+#ifndef HOST_ACLK_HZ
+#define HOST_ACLK_HZ        12000UL     // ACLK frequency (VLOCLK, typically; parts range from about 4kHz to 20kHz)
+#endif
+#define HOST_ADC_US         62          // ADC10 sample and conversion time, in microseconds (64 + 13 periods of ADC10OSC / 4)
+#ifndef HOST_SUPPLY_MV
+#define HOST_SUPPLY_MV      3300        // modelled VCC until hostHalSetSupply() is called, in millivolts
+#endif
+
+// modelled CPU cycle costs
+#define HOST_POLL_CYCLES    5           // one iteration of a flag-polling loop (bit test + conditional jump)
+#define HOST_ISR_CYCLES     11          // interrupt entry (6 cycles) and RETI (5 cycles)
+#define HOST_PIN_CYCLES     4           // read-modify-write of a port register (BIS.B/BIC.B)
+#define HOST_TX_CYCLES      4           // write to a USCI TXBUF
+
+// port bits
+#define BIT0                0x01
+#define BIT1                0x02
+#define BIT2                0x04
+#define BIT3                0x08
+#define BIT4                0x10
+#define BIT5                0x20
+#define BIT6                0x40
+#define BIT7                0x80
+
+// status register bits
+#define GIE                 0x0008
+#define CPUOFF              0x0010
+#define OSCOFF              0x0020
+#define SCG0                0x0040
+#define SCG1                0x0080
+#define LPM0_bits           (CPUOFF)
+#define LPM1_bits           (SCG0 | CPUOFF)
+#define LPM3_bits           (SCG1 | SCG0 | CPUOFF)
+#define LPM4_bits           (SCG1 | SCG0 | OSCOFF | CPUOFF)
+
+// watchdog and special function register bits
+#define WDTPW               0x5A00
+#define WDTHOLD             0x0080
+#define WDTIFG              0x01
+#define OFIFG               0x02
+#define PORIFG              0x04
+#define RSTIFG              0x08
+#define NMIIFG              0x10
+
+// basic clock system bits
+#define XTS                 0x40
+#define DIVA_0              0x00
+#define DIVM_0              0x00
+#define DIVM_1              0x10
+#define DIVM_2              0x20
+#define DIVM_3              0x30
+#define SELM_0              0x00
+#define DIVS_0              0x00
+#define DIVS_1              0x02
+#define DIVS_2              0x04
+#define DIVS_3              0x06
+#define LFXT1S_2            0x20
+
+// Timer_A bits
+#define TASSEL_0            0x0000
+#define TASSEL_1            0x0100
+#define TASSEL_2            0x0200
+#define ID_0                0x0000
+#define ID_1                0x0040
+#define ID_2                0x0080
+#define ID_3                0x00C0
+#define MC_0                0x0000
+#define MC_1                0x0010
+#define MC_2                0x0020
+#define MC_3                0x0030
+#define TACLR               0x0004
+#define TAIE                0x0002
+#define TAIFG               0x0001
+#define CCIE                0x0010
+#define CCIFG               0x0001
+#define OUTMOD_7            0x00E0
+#define TA0IV_NONE          0x00
+#define TA0IV_TACCR1        0x02
+#define TA0IV_TACCR2        0x04
+#define TA0IV_TAIFG         0x0A
+#define TA1IV_NONE          0x00
+#define TA1IV_TACCR1        0x02
+#define TA1IV_TACCR2        0x04
+#define TA1IV_TAIFG         0x0A
+
+// USCI bits
+#define UCCKPH              0x80
+#define UCCKPL              0x40
+#define UCMSB               0x20
+#define UC7BIT              0x10
+#define UCMST               0x08
+#define UCSYNC              0x01
+#define UCSSEL_1            0x40
+#define UCSSEL_2            0x80
+#define UCSWRST             0x01
+#define UCLISTEN            0x80
+#define UCOE                0x20
+#define UCBUSY              0x01
+#define UCA0RXIFG           0x01
+#define UCA0TXIFG           0x02
+#define UCB0RXIFG           0x04
+#define UCB0TXIFG           0x08
+#define UCA0RXIE            0x01
+#define UCA0TXIE            0x02
+#define UCB0RXIE            0x04
+#define UCB0TXIE            0x08
+
+// ADC10 bits
+#define ADC10SC             0x0001
+#define ENC                 0x0002
+#define ADC10IFG            0x0004
+#define ADC10IE             0x0008
+#define ADC10ON             0x0010
+#define REFON               0x0020
+#define REF2_5V             0x0040
+#define ADC10SHT_3          0x1800
+#define SREF_1              0x2000
+#define ADC10BUSY           0x0001
+#define ADC10SSEL_0         0x0000
+#define ADC10DIV_3          0x0060
+#define INCH_11             0xB000
+
+// interrupt vectors (interrupt numbers; a higher number has a higher priority)
+#define PORT1_VECTOR        2
+#define PORT2_VECTOR        3
+#define ADC10_VECTOR        5
+#define USCIAB0TX_VECTOR    6
+#define USCIAB0RX_VECTOR    7
+#define TIMER0_A1_VECTOR    8
+#define TIMER0_A0_VECTOR    9
+#define WDT_VECTOR          10
+#define TIMER1_A1_VECTOR    12
+#define TIMER1_A0_VECTOR    13
+#define HOST_NUM_VECTORS    16
+
+// compiler keywords and intrinsics that have no meaning on the host
+#define __interrupt
+#define __inline            inline
+#define __no_operation()
+#define __even_in_range(val, range) (val)
+
+
+//########## STRUCTURES ##########//
+
+typedef void (*HOST_ISR)(void);
+
+// running totals kept by the peripheral model; a bench can take the difference of two snapshots to measure one event
+typedef struct HOST_HAL_STATS
+{
+    unsigned long spiBytes;         // bytes written to any USCI TXBUF
+    unsigned long csToggles;        // bits written through HAL_PIN_SET/HAL_PIN_CLR that actually changed state
+    unsigned long activeCycles;     // modelled CPU cycles spent outside of low power modes
+    unsigned long sleepCycles;      // MCLK periods spent in low power modes
+    unsigned long isrCalls;         // number of interrupts dispatched
+    unsigned long trafficSig;       // running hash of every byte sent and the chip selects it was sent to
+}
+HOST_HAL_STATS;
+
+
+//########## REGISTERS ##########//
+extern volatile unsigned char P1IN, P1OUT, P1DIR, P1SEL, P1SEL2, P1REN, P1IE, P1IES, P1IFG;
+extern volatile unsigned char P2IN, P2OUT, P2DIR, P2SEL, P2SEL2, P2REN, P2IE, P2IES, P2IFG;
+extern volatile unsigned char P3IN, P3OUT, P3DIR, P3SEL, P3SEL2, P3REN;
+extern volatile unsigned char UCA0CTL0, UCA0CTL1, UCA0BR0, UCA0BR1, UCA0STAT, UCA0TXBUF, UCA0RXBUF;
+extern volatile unsigned char UCB0CTL0, UCB0CTL1, UCB0BR0, UCB0BR1, UCB0STAT, UCB0TXBUF, UCB0RXBUF;
+extern volatile unsigned char IFG1, IFG2, IE1, IE2;
+extern volatile unsigned char BCSCTL1, BCSCTL2, BCSCTL3, DCOCTL;
+extern volatile unsigned char CALBC1_1MHZ, CALDCO_1MHZ, CALBC1_8MHZ, CALDCO_8MHZ, CALBC1_16MHZ, CALDCO_16MHZ;
+extern volatile unsigned int WDTCTL;
+extern volatile unsigned int TA0CTL, TA0R, TA0CCR0, TA0CCR1, TA0CCR2, TA0CCTL0, TA0CCTL1, TA0CCTL2, TA0IV;
+extern volatile unsigned int TA1CTL, TA1R, TA1CCR0, TA1CCR1, TA1CCR2, TA1CCTL0, TA1CCTL1, TA1CCTL2, TA1IV;
+extern volatile unsigned int ADC10CTL0, ADC10CTL1, ADC10MEM;
+
+
+//########## FUNCTION PROTOTYPES ##########//
+
+// intrinsics
+void __delay_cycles(unsigned long cycles);
+void __enable_interrupt(void);
+void __disable_interrupt(void);
+unsigned short __get_interrupt_state(void);
+void __set_interrupt_state(unsigned short state);
+void __bis_SR_register(unsigned short bits);
+void __bic_SR_register_on_exit(unsigned short bits);
+
+// hal.h hooks
+void hostHalSync(void);
+void hostHalSpiTx(volatile unsigned char *const txBuf);
+void hostHalPinWrite(volatile unsigned char *const reg, const unsigned char mask, const unsigned char level);
+
+// bench interface
+void hostHalSetIsr(const unsigned char vector, const HOST_ISR isr);
+void hostHalDrivePin(const unsigned char port, const unsigned char mask, const unsigned char level);
+void hostHalReleasePin(const unsigned char port, const unsigned char mask);
+void hostHalPressKey(const unsigned char port, const unsigned char keyCoord);
+void hostHalReleaseKeys(void);
+void hostHalSpiSlaveXfer(volatile unsigned char *const rxBuf, const unsigned char *const txBytes, unsigned char *const rxBytes, const unsigned char len);
+void hostHalSetAlarm(const unsigned int ms);
+void hostHalWait(const unsigned int ms);
+void hostHalSetBackground(const unsigned char timer, const unsigned char chan);
+void hostHalSetSpiBus(const unsigned char usci, const unsigned char port, const unsigned char csMask);
+void hostHalSetSupply(const unsigned int mv);
+unsigned char hostHalLastByte(const unsigned char port, const unsigned char bit);
+unsigned char hostHalChainByte(const unsigned char port, const unsigned char bit, const unsigned char depth);
+const HOST_HAL_STATS *hostHalGetStats(void);
+
+// defined by the bench; called whenever the CPU is asleep with nothing scheduled
+void hostHalIdle(void);
+
+// defined by the bench; called once the firmware causes a PUC, and must not return
+void hostHalReset(void);
+
+
+#endif /* HAL_MODULE_HOSTHAL_H_ */
@@ -0,0 +1,175 @@
+/************************************************************************************
+* See header file for general module documentation
+************************************************************************************/
+
+
+//########## DEPENDENCIES ##########//
+#include "hal.h"
+#include "ledComp.h"
+
+
+//########## FUNCTION DEFINITIONS ##########//
+
+/************************************************************************************
+* Function: ledCompInit
+*
+* Description:
+*   Initializes the given compositor with the given base state and every layer
+*   inactive. What the register holds is unknown, so the first ledCompUpdate
+*   reports a change.
+*
+* Arguments:
+*   *comp       -   pointer to the compositor object
+*   base        -   the LED state beneath every layer
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void ledCompInit(LED_COMPOSITOR *const comp, const unsigned char base)
+{
+    unsigned char layer;
+
+    comp->base = base;
+    for (layer = 0; layer < LEDC_NUM_LAYERS; layer++)
+    {
+        comp->layerMask[layer] = 0x00;
+        comp->layerState[layer] = 0x00;
+        comp->layerBlink[layer] = 0x00;
+    }
+
+    comp->blinkOff = 0;
+    comp->blinking = 0;
+    comp->shown = 0x00;
+    comp->stale = 1;
+}
+
+/************************************************************************************
+* Function: ledCompSetLayer
+*
+* Description:
+*   Sets what a layer requests: the LEDs in mask are set to their bits in state,
+*   and those in blink (within mask) blink while lit. A mask of 0 deactivates the
+*   layer (see LEDC_CLEAR_LAYER). The request takes effect from the next
+*   ledCompUpdate.
+*
+* Arguments:
+*   *comp       -   pointer to the compositor object
+*   layer       -   the layer to set (0 to LEDC_NUM_LAYERS - 1)
+*   mask        -   the LEDs the layer sets
+*   state       -   the state the layer sets them to
+*   blink       -   the LEDs the layer blinks
+*
+* Returns:
+*   unsigned char layerError; 0 if the layer was set, nonzero if layer was invalid
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char ledCompSetLayer(LED_COMPOSITOR *const comp, const unsigned char layer, const unsigned char mask, const unsigned char state, const unsigned char blink)
+{
+    if (layer >= LEDC_NUM_LAYERS)
+        return 1;
+
+    comp->layerMask[layer] = mask;
+    comp->layerState[layer] = state;
+    comp->layerBlink[layer] = blink & mask;
+
+    return 0;
+}
+
+/************************************************************************************
+* Function: ledCompToggleBlink
+*
+* Description:
+*   Moves the blink on to its other phase; this should be called by the client at
+*   the blink rate while LEDC_BLINKING is set. The change takes effect from the
+*   next ledCompUpdate.
+*
+* Arguments:
+*   *comp       -   pointer to the compositor object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void ledCompToggleBlink(LED_COMPOSITOR *const comp)
+{
+    comp->blinkOff ^= 1;
+}
+
+/************************************************************************************
+* Function: ledCompInvalidate
+*
+* Description:
+*   Marks the register as no longer holding LEDC_SHOWN, so the next ledCompUpdate
+*   reports a change even if the byte is the same. This is for when the register
+*   has been written, or blanked, by something other than the compositor.
+*
+* Arguments:
+*   *comp       -   pointer to the compositor object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void ledCompInvalidate(LED_COMPOSITOR *const comp)
+{
+    comp->stale = 1;
+}
+
+/************************************************************************************
+* Function: ledCompUpdate
+*
+* Description:
+*   Builds the byte for the register from the base state and every active layer,
+*   as described in the module header, updating LEDC_SHOWN and LEDC_BLINKING. Once
+*   no lit LED is blinking, the blink is reset to its on phase.
+*
+* Arguments:
+*   *comp       -   pointer to the compositor object
+*
+* Returns:
+*   unsigned char unchanged; 0 if the register must be written with LEDC_SHOWN,
+*   1 if it already holds it
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char ledCompUpdate(LED_COMPOSITOR *const comp)
+{
+    unsigned char state = comp->base;
+    unsigned char blink = 0x00;
+    unsigned char layer;
+    unsigned char mask;
+
+    // each layer takes over the state and the blink of the LEDs in its mask from the ones beneath it
+    for (layer = 0; layer < LEDC_NUM_LAYERS; layer++)
+    {
+        mask = comp->layerMask[layer];
+        state = (state & ~mask) | (comp->layerState[layer] & mask);
+        blink = (blink & ~mask) | comp->layerBlink[layer];
+    }
+
+    // only lit LEDs blink; with none left, the next blink starts from its on phase
+    blink &= state;
+    comp->blinking = (blink != 0x00);
+    if (!blink)
+        comp->blinkOff = 0;
+    else if (comp->blinkOff)
+        state &= ~blink;
+
+    if (!(comp->stale) && (state == comp->shown))
+        return 1;
+
+    comp->shown = state;
+    comp->stale = 0;
+
+    return 0;
+}
@@ -0,0 +1,176 @@
+/************************************************************************************
+* LED Compositor Module
+*
+* Contains a compositor for the LEDs of a shift register, so every part of a client
+* that wants to light them (the UI, the power state, a computer, a fault) can make
+* its request independently, instead of each writing the register itself. The
+* byte for the register is built from the compositor's base state, with each of
+* LEDC_NUM_LAYERS layers applied over it in turn: a layer sets the LEDs in its mask
+* to its own state, so higher numbered layers take precedence. A layer with an
+* empty mask is inactive.
+*
+* Along with its state, a layer may ask for some of its LEDs to blink. A blinking
+* LED is turned off for every other blink phase, as long as it is lit and no higher
+* layer has taken it over. The client times the phases itself, calling
+* ledCompToggleBlink at the blink rate only while LEDC_BLINKING is set.
+*
+* The client collects the resulting byte with ledCompUpdate, which reports whether
+* it differs from the one last collected, so the register is only written when
+* something has changed. Layer requests made one after another before the next
+* ledCompUpdate are collected as a single change, and a request that leaves the
+* byte as it was needs no write at all.
+*
+* Please note: nothing in the compositor is used by ISRs, so every call must be made
+* from the main loop (or with interrupts disabled). If the register is written by
+* anything else, ledCompInvalidate must be called so the next ledCompUpdate
+* reports a change.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+
+#ifndef LEDCOMP_MODULE_LEDCOMP_H_
+#define LEDCOMP_MODULE_LEDCOMP_H_
+
+
+//########## SYMBOLIC CONSTANTS ##########//
+
+// user-defined constants
+#define LEDC_NUM_LAYERS     5       // number of layers over the base state, numbered by the client from 0 (lowest precedence)
+
+
+//########## PREPROCESSOR MACROS ##########//
+
+// evaluates as the byte last collected by ledCompUpdate
+#define LEDC_SHOWN(comp)                ((comp)->shown)
+
+// evaluates as nonzero if a lit LED was blinking as of the last ledCompUpdate, so the client should be timing the blink phases
+#define LEDC_BLINKING(comp)             ((comp)->blinking)
+
+// deactivates a layer, leaving its LEDs to the layers beneath it
+#define LEDC_CLEAR_LAYER(comp, layer)   ledCompSetLayer((comp), (layer), 0x00, 0x00, 0x00)
+
+
+//########## STRUCTURES ##########//
+
+// state of a compositor; base may also be changed directly by the client, like any layer request
+typedef struct LED_COMPOSITOR
+{
+    unsigned char base;                         // LED state beneath every layer
+    unsigned char layerMask[LEDC_NUM_LAYERS];   // LEDs each layer sets, or 0 while the layer is inactive
+    unsigned char layerState[LEDC_NUM_LAYERS];  // state each layer sets its LEDs to
+    unsigned char layerBlink[LEDC_NUM_LAYERS];  // LEDs within each layer's mask that should blink
+    unsigned char blinkOff;                     // set during the off phase of the blink
+    unsigned char blinking;                     // see LEDC_BLINKING
+    unsigned char shown;                        // see LEDC_SHOWN
+    unsigned char stale;                        // set until the next ledCompUpdate once shown no longer matches the register (see ledCompInvalidate)
+}
+LED_COMPOSITOR;
+
+
+//########## FUNCTION PROTOTYPES ##########//
+
+/************************************************************************************
+* Function: ledCompInit
+*
+* Description:
+*   Initializes the given compositor with the given base state and every layer
+*   inactive. What the register holds is unknown, so the first ledCompUpdate
+*   reports a change.
+*
+* Arguments:
+*   *comp       -   pointer to the compositor object
+*   base        -   the LED state beneath every layer
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void ledCompInit(LED_COMPOSITOR *const comp, const unsigned char base);
+
+/************************************************************************************
+* Function: ledCompSetLayer
+*
+* Description:
+*   Sets what a layer requests: the LEDs in mask are set to their bits in state,
+*   and those in blink (within mask) blink while lit. A mask of 0 deactivates the
+*   layer (see LEDC_CLEAR_LAYER). The request takes effect from the next
+*   ledCompUpdate.
+*
+* Arguments:
+*   *comp       -   pointer to the compositor object
+*   layer       -   the layer to set (0 to LEDC_NUM_LAYERS - 1)
+*   mask        -   the LEDs the layer sets
+*   state       -   the state the layer sets them to
+*   blink       -   the LEDs the layer blinks
+*
+* Returns:
+*   unsigned char layerError; 0 if the layer was set, nonzero if layer was invalid
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char ledCompSetLayer(LED_COMPOSITOR *const comp, const unsigned char layer, const unsigned char mask, const unsigned char state, const unsigned char blink);
+
+/************************************************************************************
+* Function: ledCompToggleBlink
+*
+* Description:
+*   Moves the blink on to its other phase; this should be called by the client at
+*   the blink rate while LEDC_BLINKING is set. The change takes effect from the
+*   next ledCompUpdate.
+*
+* Arguments:
+*   *comp       -   pointer to the compositor object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void ledCompToggleBlink(LED_COMPOSITOR *const comp);
+
+/************************************************************************************
+* Function: ledCompInvalidate
+*
+* Description:
+*   Marks the register as no longer holding LEDC_SHOWN, so the next ledCompUpdate
+*   reports a change even if the byte is the same. This is for when the register
+*   has been written, or blanked, by something other than the compositor.
+*
+* Arguments:
+*   *comp       -   pointer to the compositor object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void ledCompInvalidate(LED_COMPOSITOR *const comp);
+
+/************************************************************************************
+* Function: ledCompUpdate
+*
+* Description:
+*   Builds the byte for the register from the base state and every active layer,
+*   as described in the module header, updating LEDC_SHOWN and LEDC_BLINKING. Once
+*   no lit LED is blinking, the blink is reset to its on phase.
+*
+* Arguments:
+*   *comp       -   pointer to the compositor object
+*
+* Returns:
+*   unsigned char unchanged; 0 if the register must be written with LEDC_SHOWN,
+*   1 if it already holds it
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char ledCompUpdate(LED_COMPOSITOR *const comp);
+
+
+#endif /* LEDCOMP_MODULE_LEDCOMP_H_ */
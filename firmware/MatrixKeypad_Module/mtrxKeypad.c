@@ -4,12 +4,37 @@
 
 
 //########## DEPENDENCIES ##########//
-#include <msp430.h>
+#include "hal.h"
 #include "mtrxKeypad.h"
 
 
 //########## PRIVATE GLOBALS ##########//
 static unsigned char pendingKeyCoord = 0x00;    // stores the latest keypad coordinate; copied to keypad object in saveKeyPress() after key release
+static unsigned char pressQueued = 0;           // set when a press event was added to the FIFO, meaning its release event must be added as well
+#if (MTRX_BITMAP_SCAN)
+static unsigned int queuedMap = 0x0000;         // bitmap scanning's pressQueued; keys whose press event was added to the FIFO, and whose release event must be added as well
+static unsigned char releasesOwed = 0;          // number of bits set in queuedMap, so FIFO entries can be reserved for every release that is owed
+#endif
+
+#if (MTRX_FAST_SCAN)
+// index of the lowest set bit of each nibble (the entry for 0 is unused)
+static const unsigned char lowBitIndex[16] = {0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0};
+
+// evaluates as the index (0 to 7) of the lowest set bit in a nonzero 8-bit mask
+#define LOW_BIT_INDEX(mask)     (((mask) & 0x0F) ? lowBitIndex[(mask) & 0x0F] : (4 + lowBitIndex[(mask) >> 4]))
+#endif
+
+#if (MTRX_BITMAP_SCAN)
+// evaluates as the (column, row) coordinate of the key at a keyMap bit index
+#define KEY_BIT_COORD(keypad, bitIndex) ((LOW_BIT_INDEX((keypad)->scanCols[(bitIndex) >> 2]) << 4) | ((keypad)->rowShift + ((bitIndex) & 0x03)))
+#endif
+
+#if (MTRX_EVENT_TIMESTAMPS)
+// records the client's timestamp with a FIFO entry
+#define STAMP_EVENT(event, timestamp)   ((event)->timestamp = (timestamp))
+#else
+#define STAMP_EVENT(event, timestamp)   ((void)(timestamp))
+#endif
 
 //########## FUNCTION DEFINITIONS ##########//
 
@@ -23,6 +48,9 @@ static unsigned char pendingKeyCoord = 0x00;    // stores the latest keypad coor
 *   OUTPUTS initialliy set HIGH for interrupt capability. All row pins are configured
 *   for interrupts on a RISING EDGE transition. GIE is also set in the SR.
 *
+*   With MTRX_FAST_SCAN enabled, the keypad's column list is built here as well
+*   (and with MTRX_BITMAP_SCAN, the row pin offset for the key bitmap).
+*
 * Arguments:
 *   *keypad     -   pointer to the keypad object
 *
@@ -31,12 +59,40 @@ static unsigned char pendingKeyCoord = 0x00;    // stores the latest keypad coor
 *
 * Author:       Mason Kury
 * Created:      November 12, 2022
-* Modified:     December 4, 2022
+* Modified:     October 14, 2026
 ************************************************************************************/
 void mtrxKeypadInit(MATRIX_KEYPAD *const keypad)
 {
+#if (MTRX_FAST_SCAN)
+    unsigned char remainingCols = keypad->COL_PINS;     // column pins not yet added to the column list
+#endif
+
     // give initial values to keypad members
     keypad->currKeyCoord = 0x00;
+    keypad->fifoHead = 0;
+    keypad->fifoTail = 0;
+#if (MTRX_BITMAP_SCAN)
+    keypad->keyMap = 0x0000;
+    keypad->rowShift = LOW_BIT_INDEX(keypad->ROW_PINS);
+#endif
+#if (MTRX_INTEGRATE_DBNC)
+    keypad->rawMap = 0x0000;
+    keypad->stableSamples = 0;
+    keypad->slowKeys = 0x0000;
+#endif
+#if (MTRX_TYPEMATIC)
+    keypad->repeatKeys = 0x0000;
+    keypad->repeatIndex = MTRX_NO_REPEAT;
+#endif
+
+#if (MTRX_FAST_SCAN)
+    // list each column pin's mask, lowest first, by repeatedly isolating the lowest remaining bit of COL_PINS
+    for (keypad->numScanCols = 0; remainingCols && (keypad->numScanCols < MTRX_MAX_COLS); keypad->numScanCols++)
+    {
+        keypad->scanCols[keypad->numScanCols] = remainingCols & (~remainingCols + 1);
+        remainingCols &= remainingCols - 1;
+    }
+#endif
 
     // set row pins as inputs pulled LOW
     *(keypad->ROW_SEL) &= ~(keypad->ROW_PINS);
@@ -80,6 +136,11 @@ void mtrxKeypadInit(MATRIX_KEYPAD *const keypad)
 *   standpoint, but are represented by 0x26 -- effectively (2, 6) -- based solely
 *   on the pins within the row and column registers.
 *
+*   With MTRX_FAST_SCAN enabled, only the columns listed by mtrxKeypadInit are
+*   driven, the row register is read once per column, and the lowest HIGH row is
+*   found with a lookup table, instead of shifting through all 8 bits of each
+*   register. The result is the same either way.
+*
 * Arguments:
 *   *keypad     -   pointer to the keypad object
 *
@@ -89,7 +150,7 @@ void mtrxKeypadInit(MATRIX_KEYPAD *const keypad)
 *
 * Author:       Mason Kury
 * Created:      November 12, 2022
-* Modified:     April 3, 2023
+* Modified:     October 14, 2026
 ************************************************************************************/
 unsigned char scanForKeyPress(MATRIX_KEYPAD *const keypad)
 {
@@ -98,6 +159,28 @@ unsigned char scanForKeyPress(MATRIX_KEYPAD *const keypad)
 
     unsigned char scanError = 1;
 
+#if (MTRX_FAST_SCAN)
+    unsigned char colIndex;     // index within the keypad's column list
+    unsigned char rowBits;      // row pins read HIGH while a column is driven
+
+    for (colIndex = 0; colIndex < (keypad->numScanCols); colIndex++)
+    {
+        // clear the columns, then set the current column pin HIGH
+        *(keypad->COL_OUT) &= ~(keypad->COL_PINS);
+        *(keypad->COL_OUT) |= keypad->scanCols[colIndex];
+        HAL_SYNC();     // the rows must settle before they are read
+
+        // if any of the row pins are high, the lowest one is the pressed key's row
+        rowBits = *(keypad->ROW_IN) & (keypad->ROW_PINS);
+        if (rowBits)
+        {
+            pendingKeyCoord = (LOW_BIT_INDEX(keypad->scanCols[colIndex]) << 4) | LOW_BIT_INDEX(rowBits);
+            *(keypad->ROW_IES) |= (keypad->ROW_PINS);   // set row pin edge select to H->L, as a release is required before saving keypress data
+            scanError = 0;
+            break;
+        }
+    }
+#else
     // used to shift through the row and column registers to scan for a press
     unsigned char colPinIndex;
     unsigned char rowPinIndex;
@@ -112,6 +195,7 @@ unsigned char scanForKeyPress(MATRIX_KEYPAD *const keypad)
         // clear the columns, then set the current column pin HIGH
         *(keypad->COL_OUT) &= ~(keypad->COL_PINS);
         *(keypad->COL_OUT) |= (BIT0 << colPinIndex);
+        HAL_SYNC();     // the rows must settle before they are read
 
         // if any of the row pins are high, shift through each one until a matching HIGH signal is found
         if (*(keypad->ROW_IN) & (keypad->ROW_PINS))
@@ -130,6 +214,7 @@ unsigned char scanForKeyPress(MATRIX_KEYPAD *const keypad)
     }
 
 SCAN_FINISH:
+#endif
 
     *(keypad->ROW_IFG) &= ~(keypad->ROW_PINS);  // clear any keypad interrupts that occurred during scanning
     *(keypad->COL_OUT) |= (keypad->COL_PINS);   // make sure column pins are set back to HIGH to allow for future interrupts
@@ -176,3 +261,385 @@ void saveKeyPress(MATRIX_KEYPAD *const keypad)
     *(keypad->ROW_IFG) &= ~(keypad->ROW_PINS);  // clear any keypad interrupts that occurred during saving
     *(keypad->ROW_IE) |= (keypad->ROW_PINS);    // start listening to keypad interrupts again
 }
+
+/************************************************************************************
+* Function: mtrxKeypadDebounce
+*
+* Description:
+*   Handles the end of a debounce delay; this is intended to be called from the
+*   debounce timer ISR. If the keypad is waiting for a press (row edge select L->H),
+*   scanForKeyPress is called, and a KEY_EVENT_PRESS is added to the event FIFO if a
+*   key was found. If the keypad is waiting for a release (edge select H->L),
+*   saveKeyPress is called, and a matching KEY_EVENT_RELEASE is added to the FIFO.
+*
+*   A press is only recorded if the FIFO has room for both it and its release, so
+*   the client will never see a press without the matching release. If there is no
+*   room, the key is still scanned and saved as normal, but no events are recorded.
+*
+*   With MTRX_BITMAP_SCAN enabled, the whole matrix is scanned with
+*   mtrxKeypadScanMatrix instead, and the new bitmap is XORed with keyMap; each key
+*   that changed gets a press or release event, from the lowest bit up. Presses are
+*   only recorded while the FIFO can still fit the releases of every recorded press
+*   still held. If keys are still held afterwards, row interrupts are left off, and
+*   the client should call this again after RESCAN_DBNC_DELAY (see MTRX_KEYS_HELD);
+*   otherwise row interrupts are re-enabled to wait for the next press.
+*
+*   With MTRX_INTEGRATE_DBNC enabled, each call is one debounce sample. The keyMap
+*   only takes on the scanned bitmap once it has been read for as many consecutive
+*   samples as the changed keys require (the most of DBNC_PRESS_SAMPLES,
+*   DBNC_RELEASE_SAMPLES, and the slow class counts for keys in slowKeys). Calls
+*   should continue every MTRX_RESCAN_DELAY while MTRX_KEYS_HELD, which includes
+*   keys still being debounced.
+*
+*   With MTRX_TYPEMATIC enabled, each call while a repeat key is held also counts
+*   down MTRX_RESCAN_DELAY towards its next repeat, queuing a KEY_EVENT_REPEAT once
+*   it is due (see the module documentation for the timing).
+*
+* Arguments:
+*   *keypad     -   pointer to the keypad object
+*   timestamp   -   the time to record with the event (ex: the debounce timer's TAxR); ignored unless MTRX_EVENT_TIMESTAMPS
+*
+* Returns:
+*   unsigned char eventError; 0 if at least one event was added to the FIFO, nonzero
+*   if a pressed key was not found (or nothing changed) or the FIFO was full.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char mtrxKeypadDebounce(MATRIX_KEYPAD *const keypad, const unsigned int timestamp)
+{
+#if (MTRX_BITMAP_SCAN)
+    return mtrxKeypadDebounceMap(keypad, mtrxKeypadScanMatrix(keypad), timestamp);
+#else
+    unsigned char eventError = 1;
+    unsigned char head = keypad->fifoHead;
+    unsigned char freeEntries = (keypad->fifoTail - head - 1) & (KEY_FIFO_SZ - 1);
+    MTRX_KEY_EVENT *event = &(keypad->eventFifo[head]);
+
+    // an H->L edge select on the rows means the last successful scan is waiting for its release
+    if (*(keypad->ROW_IES) & (keypad->ROW_PINS))
+    {
+        saveKeyPress(keypad);
+
+        // room for the release was already reserved when its press was recorded
+        if (pressQueued)
+        {
+            event->keyCoord = keypad->currKeyCoord;
+            event->eventType = KEY_EVENT_RELEASE;
+            STAMP_EVENT(event, timestamp);
+            keypad->fifoHead = (head + 1) & (KEY_FIFO_SZ - 1);  // only publish the event once it is completely written
+            pressQueued = 0;
+            eventError = 0;
+        }
+    }
+    else if (!scanForKeyPress(keypad) && (freeEntries >= 2))
+    {
+        event->keyCoord = pendingKeyCoord;
+        event->eventType = KEY_EVENT_PRESS;
+        STAMP_EVENT(event, timestamp);
+        keypad->fifoHead = (head + 1) & (KEY_FIFO_SZ - 1);
+        pressQueued = 1;
+        eventError = 0;
+    }
+
+    return eventError;
+#endif
+}
+
+#if (MTRX_BITMAP_SCAN)
+/************************************************************************************
+* Function: mtrxKeypadDebounceMap
+*
+* Description:
+*   Does the bitmap scanning work of mtrxKeypadDebounce (see above) for a matrix
+*   bitmap that has already been scanned, in the keyMap format. mtrxKeypadDebounce
+*   passes it the result of mtrxKeypadScanMatrix; a keypad set up with
+*   MTRX_DEFINE_INSTANCE passes it the result of its specialized scan instead.
+*
+* Arguments:
+*   *keypad     -   pointer to the keypad object
+*   scanMap     -   bitmap of the keys read as pressed by this scan
+*   timestamp   -   the time to record with the event (ex: the debounce timer's TAxR); ignored unless MTRX_EVENT_TIMESTAMPS
+*
+* Returns:
+*   unsigned char eventError; 0 if at least one event was added to the FIFO, nonzero
+*   if nothing changed or the FIFO was full.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char mtrxKeypadDebounceMap(MATRIX_KEYPAD *const keypad, const unsigned int scanMap, const unsigned int timestamp)
+{
+    unsigned char eventError = 1;
+    unsigned char head = keypad->fifoHead;
+    unsigned char freeEntries = (keypad->fifoTail - head - 1) & (KEY_FIFO_SZ - 1);
+    MTRX_KEY_EVENT *event = &(keypad->eventFifo[head]);
+    unsigned int newMap = scanMap;
+    unsigned int changedKeys;
+    unsigned int keyBit = 0x0001;
+    unsigned char bitIndex = 0;
+#if (MTRX_TYPEMATIC)
+    unsigned int pressedKeys;
+#endif
+#if (MTRX_INTEGRATE_DBNC)
+    unsigned int pressing;
+    unsigned int releasing;
+    unsigned char samplesNeeded = 0;
+
+    // any change in what is read restarts the count of consistent samples
+    if (newMap != (keypad->rawMap))
+    {
+        keypad->rawMap = newMap;
+        keypad->stableSamples = 0;
+    }
+    if (keypad->stableSamples < 0xFF)
+        keypad->stableSamples++;
+
+    // the keys waiting to change need the longest sample count of their classes
+    pressing = newMap & ~(keypad->keyMap);
+    releasing = (keypad->keyMap) & ~newMap;
+    if ((pressing & ~(keypad->slowKeys)) && (samplesNeeded < DBNC_PRESS_SAMPLES))
+        samplesNeeded = DBNC_PRESS_SAMPLES;
+    if ((releasing & ~(keypad->slowKeys)) && (samplesNeeded < DBNC_RELEASE_SAMPLES))
+        samplesNeeded = DBNC_RELEASE_SAMPLES;
+    if ((pressing & (keypad->slowKeys)) && (samplesNeeded < DBNC_SLOW_PRESS_SAMPLES))
+        samplesNeeded = DBNC_SLOW_PRESS_SAMPLES;
+    if ((releasing & (keypad->slowKeys)) && (samplesNeeded < DBNC_SLOW_RELEASE_SAMPLES))
+        samplesNeeded = DBNC_SLOW_RELEASE_SAMPLES;
+
+    // until then, the debounced bitmap stays as it was
+    if (keypad->stableSamples < samplesNeeded)
+        newMap = keypad->keyMap;
+#endif
+
+    changedKeys = newMap ^ (keypad->keyMap);
+    keypad->keyMap = newMap;
+#if (MTRX_TYPEMATIC)
+    pressedKeys = changedKeys & newMap;
+#endif
+
+    for (; changedKeys; keyBit <<= 1, bitIndex++)
+    {
+        if (!(changedKeys & keyBit))
+            continue;
+        changedKeys &= ~keyBit;
+
+        // presses must leave room for their own release, and every other release that is owed
+        if (newMap & keyBit)
+        {
+            if (freeEntries < (releasesOwed + 2))
+                continue;
+            queuedMap |= keyBit;
+            releasesOwed++;
+            event->eventType = KEY_EVENT_PRESS;
+        }
+        else if (queuedMap & keyBit)
+        {
+            queuedMap &= ~keyBit;
+            releasesOwed--;
+            event->eventType = KEY_EVENT_RELEASE;
+        }
+        else
+            continue;
+
+        event->keyCoord = KEY_BIT_COORD(keypad, bitIndex);
+        STAMP_EVENT(event, timestamp);
+        head = (head + 1) & (KEY_FIFO_SZ - 1);
+        keypad->fifoHead = head;                            // only publish the event once it is completely written
+        event = &(keypad->eventFifo[head]);
+        freeEntries--;
+        eventError = 0;
+    }
+
+#if (MTRX_TYPEMATIC)
+    // a newly pressed repeat key (whose press was queued) takes over repeating, and the repeating key stops once released
+    pressedKeys &= (keypad->repeatKeys) & queuedMap;
+    if (pressedKeys)
+    {
+        for (bitIndex = 0; !(pressedKeys & (0x0001 << bitIndex)); bitIndex++);
+        keypad->repeatIndex = bitIndex;
+        keypad->repeatCountdown = TYPEMATIC_DELAY;
+        keypad->repeatInterval = TYPEMATIC_START_RATE;
+    }
+    else if ((keypad->repeatIndex != MTRX_NO_REPEAT) && !(queuedMap & (0x0001 << (keypad->repeatIndex))))
+        keypad->repeatIndex = MTRX_NO_REPEAT;
+    else if (keypad->repeatIndex != MTRX_NO_REPEAT)
+    {
+        if (keypad->repeatCountdown > MTRX_RESCAN_DELAY)
+            keypad->repeatCountdown -= MTRX_RESCAN_DELAY;
+
+        // once due, the repeat waits for FIFO room (leaving room for every release owed), rather than being skipped
+        else if (freeEntries > releasesOwed)
+        {
+            event->keyCoord = KEY_BIT_COORD(keypad, keypad->repeatIndex);
+            event->eventType = KEY_EVENT_REPEAT;
+            STAMP_EVENT(event, timestamp);
+            keypad->fifoHead = (head + 1) & (KEY_FIFO_SZ - 1);
+            eventError = 0;
+
+            keypad->repeatCountdown = keypad->repeatInterval;
+            keypad->repeatInterval -= (keypad->repeatInterval) >> TYPEMATIC_ACCEL_SHIFT;
+            if (keypad->repeatInterval < TYPEMATIC_MIN_RATE)
+                keypad->repeatInterval = TYPEMATIC_MIN_RATE;
+        }
+    }
+#endif
+
+    // with every key released (and settled), go back to waiting for a press interrupt; otherwise the client keeps rescanning
+    if (!MTRX_KEYS_HELD(keypad))
+    {
+        *(keypad->ROW_IES) &= ~(keypad->ROW_PINS);
+        *(keypad->ROW_IFG) &= ~(keypad->ROW_PINS);
+        *(keypad->ROW_IE) |= (keypad->ROW_PINS);
+    }
+
+    return eventError;
+}
+#endif
+
+/************************************************************************************
+* Function: mtrxKeypadPopEvent
+*
+* Description:
+*   Removes the oldest event from the keypad's event FIFO, copying it to *event.
+*   This should only be called from the main loop (the FIFO's single consumer).
+*
+* Arguments:
+*   *keypad     -   pointer to the keypad object
+*   *event      -   pointer to the event object to copy the oldest event into
+*
+* Returns:
+*   unsigned char fifoEmpty; 0 if an event was copied to *event, nonzero if there
+*   were no events in the FIFO (in which case *event is not modified).
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char mtrxKeypadPopEvent(MATRIX_KEYPAD *const keypad, MTRX_KEY_EVENT *const event)
+{
+    unsigned char fifoEmpty = 1;
+    unsigned char tail = keypad->fifoTail;
+
+    if (tail != keypad->fifoHead)
+    {
+        *event = keypad->eventFifo[tail];
+        keypad->fifoTail = (tail + 1) & (KEY_FIFO_SZ - 1);  // only free the entry once it has been copied
+        fifoEmpty = 0;
+    }
+
+    return fifoEmpty;
+}
+
+/************************************************************************************
+* Function: mtrxKeypadClearEvents
+*
+* Description:
+*   Discards all events in the keypad's event FIFO, including any press still
+*   waiting for its release. This should only be called from the main loop, and
+*   ideally while keypad interrupts and debouncing are disabled.
+*
+* Arguments:
+*   *keypad     -   pointer to the keypad object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void mtrxKeypadClearEvents(MATRIX_KEYPAD *const keypad)
+{
+    keypad->fifoTail = keypad->fifoHead;
+    pressQueued = 0;
+#if (MTRX_BITMAP_SCAN)
+    queuedMap = 0x0000;
+    releasesOwed = 0;
+    keypad->keyMap = 0x0000;    // keys still held will be seen as new presses once the keypad is enabled again
+#endif
+#if (MTRX_INTEGRATE_DBNC)
+    keypad->rawMap = 0x0000;
+    keypad->stableSamples = 0;
+#endif
+#if (MTRX_TYPEMATIC)
+    keypad->repeatIndex = MTRX_NO_REPEAT;
+#endif
+}
+
+#if (MTRX_BITMAP_SCAN)
+
+/************************************************************************************
+* Function: mtrxKeypadScanMatrix
+*
+* Description:
+*   Drives each column in the keypad's column list HIGH in turn, reading the row
+*   pins once per column, and returns a bitmap of every pressed key in the keyMap
+*   format (see the MATRIX_KEYPAD definition). The column pins are left HIGH.
+*   The keypad object is not modified, and no interrupt settings are changed.
+*
+* Arguments:
+*   *keypad     -   pointer to the keypad object
+*
+* Returns:
+*   unsigned int keyMap; the bitmap of pressed keys, or 0 if none are pressed
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned int mtrxKeypadScanMatrix(MATRIX_KEYPAD *const keypad)
+{
+    unsigned int keyMap = 0x0000;
+    unsigned char colIndex = keypad->numScanCols;
+
+    // scan from the last column down, so each column's rows can be shifted in as the lowest nibble
+    while (colIndex--)
+    {
+        *(keypad->COL_OUT) &= ~(keypad->COL_PINS);
+        *(keypad->COL_OUT) |= keypad->scanCols[colIndex];
+        HAL_SYNC();     // the rows must settle before they are read
+
+        keyMap = (keyMap << 4) | (((*(keypad->ROW_IN) & (keypad->ROW_PINS)) >> (keypad->rowShift)) & 0x0F);
+    }
+
+    *(keypad->COL_OUT) |= (keypad->COL_PINS);   // set the column pins back to HIGH to allow for future interrupts
+
+    return keyMap;
+}
+
+/************************************************************************************
+* Function: mtrxKeypadKeyBit
+*
+* Description:
+*   Finds the keyMap bit of a key coordinate (in the currKeyCoord format), such as
+*   to test whether a key is being held as part of a chord.
+*
+* Arguments:
+*   *keypad     -   pointer to the keypad object
+*   keyCoord    -   (column, row) coordinate of the key
+*
+* Returns:
+*   unsigned int keyBit; the key's bit within keyMap, or 0 if the coordinate is not
+*   part of the keypad's bitmap
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned int mtrxKeypadKeyBit(const MATRIX_KEYPAD *const keypad, const unsigned char keyCoord)
+{
+    unsigned int keyBit = 0x0000;
+    unsigned char colBit = BIT0 << (keyCoord >> 4);
+    unsigned char rowPin = keyCoord & 0x0F;
+    unsigned char colIndex;
+
+    if ((rowPin >= keypad->rowShift) && (rowPin < (keypad->rowShift + 4)) && ((BIT0 << rowPin) & (keypad->ROW_PINS)))
+    {
+        for (colIndex = 0; colIndex < (keypad->numScanCols); colIndex++)
+        {
+            if (keypad->scanCols[colIndex] == colBit)
+                keyBit = 0x0001 << ((colIndex << 2) + (rowPin - keypad->rowShift));
+        }
+    }
+
+    return keyBit;
+}
+
+#endif
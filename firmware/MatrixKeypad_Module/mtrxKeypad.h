@@ -36,9 +36,56 @@
 * member of the keypad object; please see the comment above that member in the definition
 * below for details about the coordinate format.
 *
+* Alternatively, the timer ISR can call mtrxKeypadDebounce() once the debounce delay is
+* over; this calls scanForKeyPress() or saveKeyPress() as appropriate, and records a
+* press or release event (coordinate, event type, and, with MTRX_EVENT_TIMESTAMPS, a
+* client-provided timestamp) in the keypad object's event FIFO. The main loop can then drain events in order with
+* mtrxKeypadPopEvent(), so keystrokes arriving while it is busy are not lost. The FIFO
+* is lock-free, as long as the timer ISR is the only producer and the main loop is the
+* only consumer.
+*
+* With MTRX_BITMAP_SCAN enabled, mtrxKeypadDebounce() scans every key instead, storing
+* a 16-bit bitmap of the pressed keys in the keypad object. Press and release events
+* are found by XORing it with the previous bitmap, so any number of keys can be held
+* at once (N-key rollover), and the client can detect chords with mtrxKeypadKeyBit().
+* Each key's events are still queued in the same press/release format. While any key
+* is held, row interrupts stay off and the client's timer ISR rescans the matrix every
+* RESCAN_DBNC_DELAY instead (see MTRX_KEYS_HELD), as a second key in the same row would
+* not cause an edge. Once every key is released, row interrupts are turned back on.
+* Bitmap scanning supports up to 4 columns, with all row pins within a 4-pin window.
+*
+* With MTRX_INTEGRATE_DBNC enabled as well, nothing is trusted from a single read:
+* from the first row interrupt until every key is released, the client's timer calls
+* mtrxKeypadDebounce() every DBNC_SAMPLE_TICKS (MTRX_PRESS_DELAY/MTRX_RESCAN_DELAY),
+* and a change is only accepted once the matrix has read the same for the number of
+* samples required by the changed keys (DBNC_PRESS_SAMPLES, DBNC_RELEASE_SAMPLES, or
+* their slow class counterparts for keys in slowKeys). A clean press is accepted in
+* a few milliseconds, while a noisy one is held off until it settles. The count is
+* kept for the matrix as a whole, so a key still bouncing delays other keys' changes.
+*
+* With MTRX_TYPEMATIC enabled as well, holding a key in the repeatKeys bitmap queues
+* KEY_EVENT_REPEAT events for it between its press and release: the first after
+* TYPEMATIC_DELAY, then every TYPEMATIC_START_RATE, getting faster with each repeat
+* until TYPEMATIC_MIN_RATE. Only the most recently pressed repeat key repeats. The
+* time is counted in the client timer's MTRX_RESCAN_DELAY steps rather than from the
+* event timestamps, as those may come from a faster timer that wraps within a hold.
+* A repeat is only queued while there is room left for every release that is owed.
+*
+* With bitmap scanning, a keypad whose registers are fixed can also be given a
+* specialized scan with MTRX_DEFINE_INSTANCE(NAME, ...), which emits mtrxNAMEScanMatrix()
+* and mtrxNAMEDebounce() with the row/column registers and pin masks built in as
+* constants, rather than reached through the keypad object's pointers on every read.
+* The timer ISR then calls mtrxNAMEDebounce() in place of mtrxKeypadDebounce(); the
+* rest of the keypad (interrupts, events, etc.) still uses the generic functions.
+*
+* With MTRX_FAST_SCAN enabled, mtrxKeypadInit() also stores a list of the column pins,
+* and scanForKeyPress() reads the rows once per listed column, converting the row bits
+* to an index with a lookup table. A scan then takes about the same time whichever
+* key is pressed. Keypads with more than MTRX_MAX_COLS columns need it raised.
+*
 * Author:       Mason Kury
 * Created:      November 12, 2022
-* Modified:     April 3, 2023
+* Modified:     October 14, 2026
 ************************************************************************************/
 
 #ifndef MATRIXKEYPAD_MODULE_MTRXKEYPAD_H_
@@ -48,10 +95,120 @@
 //########## SYMBOLIC CONSTANTS ##########//
 #define PRESS_DBNC_DELAY    300     // number of VLOCLK->ACLK (12kHz) cycles to delay when debouncing a key press
 #define RELEASE_DBNC_DELAY  700     // number of VLOCLK->ACLK (12kHz) cycles to delay when debouncing a key release
+#define KEY_FIFO_SZ         8       // number of key events the event FIFO can hold (MUST be a power of 2; one entry is always kept free)
+#define MTRX_EVENT_TIMESTAMPS   0   // set to 1 to store the client's timestamp with each key event; 0 to leave it out (2 fewer bytes of RAM per FIFO entry)
+#define MTRX_FAST_SCAN      0       // set to 1 to scan from a column list built by mtrxKeypadInit(); 0 to shift through all 8 bits of each register
+#define MTRX_MAX_COLS       4       // number of column pins the fast scan's column list can hold; columns beyond the lowest MTRX_MAX_COLS are not scanned
+#define MTRX_BITMAP_SCAN    0       // set to 1 for mtrxKeypadDebounce() to scan the whole matrix into a pressed-key bitmap (N-key rollover); 0 for single-key scanning
+#define RESCAN_DBNC_DELAY   300     // number of VLOCLK->ACLK (12kHz) cycles between matrix rescans while any key is held (bitmap scanning only)
+
+// integrating debounce (bitmap scanning only); a change is accepted once the matrix has read the same for the changed keys' number of samples
+#define MTRX_INTEGRATE_DBNC 0       // set to 1 to sample the matrix every DBNC_SAMPLE_TICKS until it settles; 0 to wait out PRESS_DBNC_DELAY/RESCAN_DBNC_DELAY instead
+#define DBNC_SAMPLE_TICKS   12      // number of VLOCLK->ACLK (12kHz) cycles between debounce samples (about 1ms)
+#define DBNC_PRESS_SAMPLES          5       // consistent samples required to accept a press
+#define DBNC_RELEASE_SAMPLES        10      // consistent samples required to accept a release (contacts usually bounce longer when opening)
+#define DBNC_SLOW_PRESS_SAMPLES     25      // the same for keys in the keypad's slowKeys bitmap (ex: noisy keys, or keys that shouldn't react to a brief touch)
+#define DBNC_SLOW_RELEASE_SAMPLES   58      // (the slow class matches the fixed PRESS_DBNC_DELAY/RELEASE_DBNC_DELAY timing)
+
+// typematic auto-repeat (bitmap scanning only); all times are in VLOCLK->ACLK (12kHz) cycles, counted in steps of MTRX_RESCAN_DELAY
+#define MTRX_TYPEMATIC          0       // set to 1 to queue KEY_EVENT_REPEAT events while a key in the keypad's repeatKeys bitmap is held; 0 for press/release events only
+#define TYPEMATIC_DELAY         6000    // time a key is held before its first repeat (about 500ms)
+#define TYPEMATIC_START_RATE    2400    // time between the first repeats (about 200ms)
+#define TYPEMATIC_MIN_RATE      600     // shortest time between repeats, reached after holding for a while (about 50ms)
+#define TYPEMATIC_ACCEL_SHIFT   3       // each repeat shortens the time to the next by 1/(2^TYPEMATIC_ACCEL_SHIFT)
+
+#if (MTRX_BITMAP_SCAN) && !(MTRX_FAST_SCAN)
+#error "MTRX_BITMAP_SCAN uses the column list built when MTRX_FAST_SCAN is enabled"
+#endif
+#if (MTRX_BITMAP_SCAN) && (MTRX_MAX_COLS > 4)
+#error "The 16-bit key bitmap holds at most 4 columns of 4 rows"
+#endif
+#if (MTRX_INTEGRATE_DBNC) && !(MTRX_BITMAP_SCAN)
+#error "MTRX_INTEGRATE_DBNC samples the key bitmap built when MTRX_BITMAP_SCAN is enabled"
+#endif
+#if (MTRX_TYPEMATIC) && !(MTRX_BITMAP_SCAN)
+#error "MTRX_TYPEMATIC relies on the periodic rescans done while keys are held when MTRX_BITMAP_SCAN is enabled"
+#endif
+
+// delay from a row interrupt to the first mtrxKeypadDebounce() call for a press, and between calls while MTRX_KEYS_HELD
+#if (MTRX_INTEGRATE_DBNC)
+#define MTRX_PRESS_DELAY    DBNC_SAMPLE_TICKS
+#define MTRX_RESCAN_DELAY   DBNC_SAMPLE_TICKS
+#else
+#define MTRX_PRESS_DELAY    PRESS_DBNC_DELAY
+#define MTRX_RESCAN_DELAY   RESCAN_DBNC_DELAY
+#endif
+
+// key event types stored in MTRX_KEY_EVENT
+#define KEY_EVENT_PRESS     0
+#define KEY_EVENT_RELEASE   1
+#define KEY_EVENT_REPEAT    2       // queued between a key's press and release while it is held (MTRX_TYPEMATIC only)
+
+#define MTRX_NO_REPEAT      0xFF    // repeatIndex while no key is repeating
+
+
+//########## PREPROCESSOR MACROS ##########//
+
+// evaluates as nonzero if there are events waiting in a keypad object's event FIFO
+#define MTRX_KEY_EVENT_PENDING(keypad)  ((keypad)->fifoHead != (keypad)->fifoTail)
+
+#if (MTRX_INTEGRATE_DBNC)
+// evaluates as nonzero while any key is held or still being debounced, meaning the client's timer should call mtrxKeypadDebounce() again after MTRX_RESCAN_DELAY
+#define MTRX_KEYS_HELD(keypad)          (((keypad)->keyMap | (keypad)->rawMap) != 0)
+#elif (MTRX_BITMAP_SCAN)
+// evaluates as nonzero while any key is held, meaning the client's debounce timer should call mtrxKeypadDebounce() again after MTRX_RESCAN_DELAY
+#define MTRX_KEYS_HELD(keypad)          ((keypad)->keyMap != 0)
+#endif
+
+#if (MTRX_BITMAP_SCAN)
+// evaluates as the index (0 to 7) of the lowest set bit in a nonzero constant 8-bit mask, at compile time
+#define MTRX_LOW_PIN(mask)  (((mask) & BIT0) ? 0 : ((mask) & BIT1) ? 1 : ((mask) & BIT2) ? 2 : ((mask) & BIT3) ? 3 : \
+                             ((mask) & BIT4) ? 4 : ((mask) & BIT5) ? 5 : ((mask) & BIT6) ? 6 : 7)
+
+/* Emits mtrx##NAME##ScanMatrix() and mtrx##NAME##Debounce(), which work the same as mtrxKeypadScanMatrix() and mtrxKeypadDebounce(), but with the
+ * row input and column output registers (ex: P2IN and P2OUT) and pin masks of one keypad built in as constants. The arguments must match that
+ * keypad object's ROW_IN, COL_OUT, ROW_PINS, and COL_PINS members, and the column mask must have no more than MTRX_MAX_COLS pins set. */
+#define MTRX_DEFINE_INSTANCE(NAME, ROW_IN_REG, COL_OUT_REG, ROW_MASK, COL_MASK)                                             \
+__inline static unsigned int mtrx##NAME##ScanMatrix(void)                                                                   \
+{                                                                                                                           \
+    unsigned int keyMap = 0x0000;                                                                                           \
+    unsigned char colBit;                                                                                                   \
+                                                                                                                            \
+    /* the column mask is constant, so this loop can be unrolled down to just the column pins */                            \
+    for (colBit = BIT7; colBit; colBit >>= 1)                                                                               \
+    {                                                                                                                       \
+        if ((COL_MASK) & colBit)                                                                                            \
+        {                                                                                                                   \
+            (COL_OUT_REG) = ((COL_OUT_REG) & ~(COL_MASK)) | colBit;                                                         \
+            HAL_SYNC();                                                                                                     \
+            keyMap = (keyMap << 4) | ((((ROW_IN_REG) & (ROW_MASK)) >> MTRX_LOW_PIN(ROW_MASK)) & 0x0F);                      \
+        }                                                                                                                   \
+    }                                                                                                                       \
+                                                                                                                            \
+    (COL_OUT_REG) |= (COL_MASK);                                                                                            \
+    return keyMap;                                                                                                          \
+}                                                                                                                           \
+                                                                                                                            \
+__inline static unsigned char mtrx##NAME##Debounce(MATRIX_KEYPAD *const keypad, const unsigned int timestamp)               \
+{                                                                                                                           \
+    return mtrxKeypadDebounceMap(keypad, mtrx##NAME##ScanMatrix(), timestamp);                                              \
+}
+#endif
 
 
 //########## STRUCTURES ##########//
 
+// a single press or release of a key, as stored in the keypad event FIFO
+typedef struct MTRX_KEY_EVENT
+{
+    unsigned char keyCoord;         // (column, row) coordinate of the key, in the same format as currKeyCoord below
+    unsigned char eventType;        // KEY_EVENT_PRESS, KEY_EVENT_RELEASE, or KEY_EVENT_REPEAT
+#if (MTRX_EVENT_TIMESTAMPS)
+    unsigned int timestamp;         // client-provided time at which the event was debounced (usually a free-running timer count)
+#endif
+}
+MTRX_KEY_EVENT;
+
 // NOTE: if RAM is scarce, make a const struct for all register pointers and masks, and keep the
 // coordinate, count, buffer, and decoded key members in a separate variable struct.
 // Functions in this module would need to be altered to accommodate this change.
@@ -81,6 +238,38 @@ typedef struct MATRIX_KEYPAD
      * are (C1, R3) from a user standpoint, but are represented by 0x26 -- effectively (2, 6) -- based
      * solely on the pins within the row and column registers. This allows for greater wiring flexibility.) */
     unsigned char currKeyCoord;
+
+    /* Single-producer/single-consumer ring buffer of debounced key events; these members do not need to be given initial values.
+     * Only mtrxKeypadDebounce() (from the timer ISR) advances fifoHead, and only mtrxKeypadPopEvent() (from the main loop) advances fifoTail. */
+    MTRX_KEY_EVENT eventFifo[KEY_FIFO_SZ];
+    volatile unsigned char fifoHead;
+    volatile unsigned char fifoTail;
+
+#if (MTRX_FAST_SCAN)
+    // single-bit masks of each column pin, lowest first, and the number of them; built by mtrxKeypadInit() so scans don't need to search COL_PINS
+    unsigned char scanCols[MTRX_MAX_COLS];
+    unsigned char numScanCols;
+#endif
+
+#if (MTRX_BITMAP_SCAN)
+    /* Debounced pressed-key bitmap, as of the last mtrxKeypadDebounce() call; bit ((4 * c) + r) is set while the key on column c of the
+     * column list and row pin r above the lowest row pin (rowShift) is pressed. Use mtrxKeypadKeyBit() to find a coordinate's bit. */
+    volatile unsigned int keyMap;
+    unsigned char rowShift;         // index of the lowest row pin; set by mtrxKeypadInit()
+#endif
+
+#if (MTRX_INTEGRATE_DBNC)
+    volatile unsigned int rawMap;   // bitmap read by the latest debounce sample, which becomes keyMap once it has been stable for long enough
+    unsigned char stableSamples;    // number of consecutive samples that have read rawMap (saturates at 0xFF)
+    unsigned int slowKeys;          // bitmap of keys debounced with the DBNC_SLOW_ sample counts; cleared by mtrxKeypadInit(), then set by the client if needed
+#endif
+
+#if (MTRX_TYPEMATIC)
+    unsigned int repeatKeys;        // bitmap of keys that auto-repeat while held; cleared by mtrxKeypadInit(), then set by the client
+    unsigned char repeatIndex;      // keyMap bit index of the key currently repeating, or MTRX_NO_REPEAT
+    unsigned int repeatCountdown;   // ACLK cycles left until the next repeat
+    unsigned int repeatInterval;    // ACLK cycles between the repeats that follow, shortened after each one
+#endif
 }
 MATRIX_KEYPAD;
 
@@ -97,6 +286,9 @@ MATRIX_KEYPAD;
 *   OUTPUTS initialliy set HIGH for interrupt capability. All row pins are configured
 *   for interrupts on a RISING EDGE transition. GIE is also set in the SR.
 *
+*   With MTRX_FAST_SCAN enabled, the keypad's column list is built here as well
+*   (and with MTRX_BITMAP_SCAN, the row pin offset for the key bitmap).
+*
 * Arguments:
 *   *keypad     -   pointer to the keypad object
 *
@@ -105,7 +297,7 @@ MATRIX_KEYPAD;
 *
 * Author:       Mason Kury
 * Created:      November 12, 2022
-* Modified:     December 4, 2022
+* Modified:     October 14, 2026
 ************************************************************************************/
 void mtrxKeypadInit(MATRIX_KEYPAD *const keypad);
 
@@ -133,6 +325,11 @@ void mtrxKeypadInit(MATRIX_KEYPAD *const keypad);
 *   standpoint, but are represented by 0x26 -- effectively (2, 6) -- based solely
 *   on the pins within the row and column registers.
 *
+*   With MTRX_FAST_SCAN enabled, only the columns listed by mtrxKeypadInit are
+*   driven, the row register is read once per column, and the lowest HIGH row is
+*   found with a lookup table, instead of shifting through all 8 bits of each
+*   register. The result is the same either way.
+*
 * Arguments:
 *   *keypad     -   pointer to the keypad object
 *
@@ -142,7 +339,7 @@ void mtrxKeypadInit(MATRIX_KEYPAD *const keypad);
 *
 * Author:       Mason Kury
 * Created:      November 12, 2022
-* Modified:     April 3, 2023
+* Modified:     October 14, 2026
 ************************************************************************************/
 unsigned char scanForKeyPress(MATRIX_KEYPAD *const keypad);
 
@@ -174,5 +371,155 @@ unsigned char scanForKeyPress(MATRIX_KEYPAD *const keypad);
 ************************************************************************************/
 void saveKeyPress(MATRIX_KEYPAD *const keypad);
 
+/************************************************************************************
+* Function: mtrxKeypadDebounce
+*
+* Description:
+*   Handles the end of a debounce delay; this is intended to be called from the
+*   debounce timer ISR. If the keypad is waiting for a press (row edge select L->H),
+*   scanForKeyPress is called, and a KEY_EVENT_PRESS is added to the event FIFO if a
+*   key was found. If the keypad is waiting for a release (edge select H->L),
+*   saveKeyPress is called, and a matching KEY_EVENT_RELEASE is added to the FIFO.
+*
+*   A press is only recorded if the FIFO has room for both it and its release, so
+*   the client will never see a press without the matching release. If there is no
+*   room, the key is still scanned and saved as normal, but no events are recorded.
+*
+*   With MTRX_BITMAP_SCAN enabled, the whole matrix is scanned with
+*   mtrxKeypadScanMatrix instead, and the new bitmap is XORed with keyMap; each key
+*   that changed gets a press or release event, from the lowest bit up. Presses are
+*   only recorded while the FIFO can still fit the releases of every recorded press
+*   still held. If keys are still held afterwards, row interrupts are left off, and
+*   the client should call this again after RESCAN_DBNC_DELAY (see MTRX_KEYS_HELD);
+*   otherwise row interrupts are re-enabled to wait for the next press.
+*
+*   With MTRX_INTEGRATE_DBNC enabled, each call is one debounce sample. The keyMap
+*   only takes on the scanned bitmap once it has been read for as many consecutive
+*   samples as the changed keys require (the most of DBNC_PRESS_SAMPLES,
+*   DBNC_RELEASE_SAMPLES, and the slow class counts for keys in slowKeys). Calls
+*   should continue every MTRX_RESCAN_DELAY while MTRX_KEYS_HELD, which includes
+*   keys still being debounced.
+*
+*   With MTRX_TYPEMATIC enabled, each call while a repeat key is held also counts
+*   down MTRX_RESCAN_DELAY towards its next repeat, queuing a KEY_EVENT_REPEAT once
+*   it is due (see the module documentation for the timing).
+*
+* Arguments:
+*   *keypad     -   pointer to the keypad object
+*   timestamp   -   the time to record with the event (ex: the debounce timer's TAxR); ignored unless MTRX_EVENT_TIMESTAMPS
+*
+* Returns:
+*   unsigned char eventError; 0 if at least one event was added to the FIFO, nonzero
+*   if a pressed key was not found (or nothing changed) or the FIFO was full.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char mtrxKeypadDebounce(MATRIX_KEYPAD *const keypad, const unsigned int timestamp);
+
+/************************************************************************************
+* Function: mtrxKeypadPopEvent
+*
+* Description:
+*   Removes the oldest event from the keypad's event FIFO, copying it to *event.
+*   This should only be called from the main loop (the FIFO's single consumer).
+*
+* Arguments:
+*   *keypad     -   pointer to the keypad object
+*   *event      -   pointer to the event object to copy the oldest event into
+*
+* Returns:
+*   unsigned char fifoEmpty; 0 if an event was copied to *event, nonzero if there
+*   were no events in the FIFO (in which case *event is not modified).
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char mtrxKeypadPopEvent(MATRIX_KEYPAD *const keypad, MTRX_KEY_EVENT *const event);
+
+/************************************************************************************
+* Function: mtrxKeypadClearEvents
+*
+* Description:
+*   Discards all events in the keypad's event FIFO, including any press still
+*   waiting for its release. This should only be called from the main loop, and
+*   ideally while keypad interrupts and debouncing are disabled.
+*
+* Arguments:
+*   *keypad     -   pointer to the keypad object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void mtrxKeypadClearEvents(MATRIX_KEYPAD *const keypad);
+
+#if (MTRX_BITMAP_SCAN)
+/************************************************************************************
+* Function: mtrxKeypadDebounceMap
+*
+* Description:
+*   Does the bitmap scanning work of mtrxKeypadDebounce (see above) for a matrix
+*   bitmap that has already been scanned, in the keyMap format. mtrxKeypadDebounce
+*   passes it the result of mtrxKeypadScanMatrix; a keypad set up with
+*   MTRX_DEFINE_INSTANCE passes it the result of its specialized scan instead.
+*
+* Arguments:
+*   *keypad     -   pointer to the keypad object
+*   scanMap     -   bitmap of the keys read as pressed by this scan
+*   timestamp   -   the time to record with the event (ex: the debounce timer's TAxR); ignored unless MTRX_EVENT_TIMESTAMPS
+*
+* Returns:
+*   unsigned char eventError; 0 if at least one event was added to the FIFO, nonzero
+*   if nothing changed or the FIFO was full.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char mtrxKeypadDebounceMap(MATRIX_KEYPAD *const keypad, const unsigned int scanMap, const unsigned int timestamp);
+
+/************************************************************************************
+* Function: mtrxKeypadScanMatrix
+*
+* Description:
+*   Drives each column in the keypad's column list HIGH in turn, reading the row
+*   pins once per column, and returns a bitmap of every pressed key in the keyMap
+*   format (see the MATRIX_KEYPAD definition). The column pins are left HIGH.
+*   The keypad object is not modified, and no interrupt settings are changed.
+*
+* Arguments:
+*   *keypad     -   pointer to the keypad object
+*
+* Returns:
+*   unsigned int keyMap; the bitmap of pressed keys, or 0 if none are pressed
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned int mtrxKeypadScanMatrix(MATRIX_KEYPAD *const keypad);
+
+/************************************************************************************
+* Function: mtrxKeypadKeyBit
+*
+* Description:
+*   Finds the keyMap bit of a key coordinate (in the currKeyCoord format), such as
+*   to test whether a key is being held as part of a chord.
+*
+* Arguments:
+*   *keypad     -   pointer to the keypad object
+*   keyCoord    -   (column, row) coordinate of the key
+*
+* Returns:
+*   unsigned int keyBit; the key's bit within keyMap, or 0 if the coordinate is not
+*   part of the keypad's bitmap
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned int mtrxKeypadKeyBit(const MATRIX_KEYPAD *const keypad, const unsigned char keyCoord);
+#endif
+
 
 #endif /* MATRIXKEYPAD_MODULE_MTRXKEYPAD_H_ */
@@ -0,0 +1,131 @@
+/************************************************************************************
+* See header file for general module documentation
+************************************************************************************/
+
+
+//########## DEPENDENCIES ##########//
+#include "hal.h"
+#include "profiler.h"
+
+
+//########## FUNCTION DEFINITIONS ##########//
+#if (LATENCY_PROFILE)
+
+/************************************************************************************
+* Function: profInit
+*
+* Description:
+*   Starts the profiler timer in continuous mode from SMCLK, and clears the given
+*   profile if it does not already hold a valid profile (this allows a profile
+*   in .TI.noinit RAM to survive a reset).
+*
+* Arguments:
+*   *prof       -   pointer to the profile object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void profInit(PROF_DATA *const prof)
+{
+    PROF_TIMER_CTL = TASSEL_2 | PROF_TIMER_DIV | MC_2 | TACLR;  // set source as SMCLK, divided by PROF_TIMER_DIV, continuous mode
+
+    if (prof->validKey != PROF_VALID_KEY)
+        profClear(prof);
+}
+
+/************************************************************************************
+* Function: profClear
+*
+* Description:
+*   Discards all samples in the given profile and marks it as valid.
+*
+* Arguments:
+*   *prof       -   pointer to the profile object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void profClear(PROF_DATA *const prof)
+{
+    unsigned char index;
+    unsigned short intState = __get_interrupt_state();
+
+    __disable_interrupt();
+    for (index = 0; index < PROF_NUM_STAGES; index++)
+        prof->stages[index] = (PROF_STAGE_STATS){0xFFFF, 0, 0, 0};
+    for (index = 0; index < PROF_HIST_BINS; index++)
+        prof->histogram[index] = 0;
+    prof->validKey = PROF_VALID_KEY;
+    __set_interrupt_state(intState);
+}
+
+/************************************************************************************
+* Function: profRecord
+*
+* Description:
+*   Adds a sample to the statistics of the given stage, and to the histogram if
+*   the stage is PROF_HIST_STAGE. Interrupts are held off while the sample is
+*   added, so this can be called from both ISRs and the main loop.
+*
+* Arguments:
+*   *prof       -   pointer to the profile object
+*   stage       -   the stage the sample belongs to (0 to PROF_NUM_STAGES - 1)
+*   ticks       -   length of the stage, usually PROF_NOW() minus the stage's start timestamp
+*
+* Returns:
+*   unsigned char stageError; 0 if the sample was recorded, nonzero if the stage
+*   was invalid.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char profRecord(PROF_DATA *const prof, const unsigned char stage, const unsigned int ticks)
+{
+    unsigned char stageError = 1;
+    unsigned char bin = 0;
+    unsigned int binTicks = ticks;
+    PROF_STAGE_STATS *stats;
+    unsigned short intState;
+
+    if (stage < PROF_NUM_STAGES)
+    {
+        // find the histogram bin before disabling interrupts; each bin covers 4 times the ticks of the last
+        while ((binTicks >= 4) && (bin < (PROF_HIST_BINS - 1)))
+        {
+            binTicks >>= 2;
+            bin++;
+        }
+
+        intState = __get_interrupt_state();
+        __disable_interrupt();
+
+        stats = &(prof->stages[stage]);
+        if (ticks < stats->minTicks)
+            stats->minTicks = ticks;
+        if (ticks > stats->maxTicks)
+            stats->maxTicks = ticks;
+
+        // stop accumulating once the count saturates, so the average stays correct
+        if (stats->count < 0xFFFF)
+        {
+            stats->sumTicks += ticks;
+            stats->count++;
+        }
+
+        if ((stage == PROF_HIST_STAGE) && (prof->histogram[bin] < 0xFF))
+            prof->histogram[bin]++;
+
+        __set_interrupt_state(intState);
+        stageError = 0;
+    }
+
+    return stageError;
+}
+
+#endif
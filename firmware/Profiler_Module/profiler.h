@@ -0,0 +1,141 @@
+/************************************************************************************
+* Latency Profiler Module
+*
+* Contains a small, compile-time-enabled instrumentation layer for measuring how
+* long various stages of the firmware take on real hardware. Timestamps are read
+* from a free-running timer (Timer1_A by default) clocked from SMCLK, with no
+* division by default (PROF_TIMER_DIV), so one tick is one MCLK cycle as long as
+* MCLK and SMCLK share a source and divider.
+*
+* The client defines its own stages (numbered 0 to PROF_NUM_STAGES - 1), takes a
+* timestamp with PROF_NOW() at the start of each stage, and passes the elapsed ticks
+* to profRecord() at the end of it. For each stage, the minimum, maximum, sum, and
+* count of all samples are kept; the last stage (PROF_HIST_STAGE) also has a
+* histogram of its samples, as it is intended to be the end-to-end latency.
+*
+* All profile data lives in a PROF_DATA object owned by the client. The object is
+* intended to be placed in .TI.noinit with "#pragma NOINIT", so a profile survives
+* a watchdog reset (such as the one done by a critical fault handler); profInit()
+* only clears it if it does not contain a valid profile already.
+*
+* Please note: the timer does not run in LPM3 or deeper, as SMCLK is stopped.
+* Stages that span a low power mode are only measured correctly if the client
+* sleeps in LPM0 while profiling.
+*
+* Setting LATENCY_PROFILE to 0 leaves the module's functions out of the build.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+
+#ifndef PROFILER_MODULE_PROFILER_H_
+#define PROFILER_MODULE_PROFILER_H_
+
+
+//########## SYMBOLIC CONSTANTS ##########//
+
+// user-defined constants
+#define LATENCY_PROFILE     0       // set to 1 to build the profiler and instrument the client; 0 to leave it out entirely
+#define PROF_NUM_STAGES     4       // number of stages timed by the client
+#define PROF_HIST_STAGE     (PROF_NUM_STAGES - 1)   // the stage that also keeps a histogram of its samples
+#define PROF_HIST_BINS      8       // number of histogram bins; bin n counts samples from 4^n to 4^(n+1) - 1 ticks (bin 0 also counts 0, and the last bin counts everything longer)
+#define PROF_VALID_KEY      0x5AFE  // stored in the profile object so a profile kept through a reset can be told apart from power-up garbage
+
+// free-running timer used for timestamps
+#define PROF_TIMER_CTL      TA1CTL
+#define PROF_TIMER_R        TA1R
+#define PROF_TIMER_DIV      ID_0    // SMCLK division for the timer (ID_0 to ID_3); at 16MHz, 65535 undivided ticks are only about 4ms
+
+
+//########## PREPROCESSOR MACROS ##########//
+
+// current profiler timestamp, in MCLK cycles (while MCLK == SMCLK and PROF_TIMER_DIV is ID_0); differences between timestamps are valid up to 65535 ticks
+#define PROF_NOW()          (PROF_TIMER_R)
+
+
+//########## STRUCTURES ##########//
+
+// statistics kept for each profiled stage; ticks are in profiler timer counts
+typedef struct PROF_STAGE_STATS
+{
+    unsigned int minTicks;          // shortest sample (0xFFFF if there are no samples)
+    unsigned int maxTicks;          // longest sample
+    unsigned long sumTicks;         // sum of all samples; the average is sumTicks / count
+    unsigned int count;             // number of samples; stops increasing (along with sumTicks) at 0xFFFF
+}
+PROF_STAGE_STATS;
+
+typedef struct PROF_DATA
+{
+    unsigned int validKey;                      // PROF_VALID_KEY once the profile has been cleared at least once
+    PROF_STAGE_STATS stages[PROF_NUM_STAGES];
+    unsigned char histogram[PROF_HIST_BINS];    // PROF_HIST_STAGE samples per bin; each bin saturates at 0xFF
+}
+PROF_DATA;
+
+
+//########## FUNCTION PROTOTYPES ##########//
+#if (LATENCY_PROFILE)
+
+/************************************************************************************
+* Function: profInit
+*
+* Description:
+*   Starts the profiler timer in continuous mode from SMCLK, and clears the given
+*   profile if it does not already hold a valid profile (this allows a profile
+*   in .TI.noinit RAM to survive a reset).
+*
+* Arguments:
+*   *prof       -   pointer to the profile object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void profInit(PROF_DATA *const prof);
+
+/************************************************************************************
+* Function: profClear
+*
+* Description:
+*   Discards all samples in the given profile and marks it as valid.
+*
+* Arguments:
+*   *prof       -   pointer to the profile object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void profClear(PROF_DATA *const prof);
+
+/************************************************************************************
+* Function: profRecord
+*
+* Description:
+*   Adds a sample to the statistics of the given stage, and to the histogram if
+*   the stage is PROF_HIST_STAGE. Interrupts are held off while the sample is
+*   added, so this can be called from both ISRs and the main loop.
+*
+* Arguments:
+*   *prof       -   pointer to the profile object
+*   stage       -   the stage the sample belongs to (0 to PROF_NUM_STAGES - 1)
+*   ticks       -   length of the stage, usually PROF_NOW() minus the stage's start timestamp
+*
+* Returns:
+*   unsigned char stageError; 0 if the sample was recorded, nonzero if the stage
+*   was invalid.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char profRecord(PROF_DATA *const prof, const unsigned char stage, const unsigned int ticks);
+
+#endif
+
+
+#endif /* PROFILER_MODULE_PROFILER_H_ */
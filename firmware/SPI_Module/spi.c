@@ -4,7 +4,7 @@
 
 
 //########## DEPENDENCIES ##########//
-#include <msp430.h>
+#include "hal.h"
 #include "spi.h"
 
 
@@ -125,6 +125,7 @@ void usciXNSpiPutChar(const USCIXNSPI *const usciXN, const unsigned char txByte)
 {
 	WAIT_FOR_TX;
 	*(usciXN->UCXNTXBUF) = txByte;
+	HAL_SPI_TX(usciXN->UCXNTXBUF);
 #if (WAIT_FOR_PUTCHAR)
     WAIT_FOR_RX;
 #endif
@@ -172,3 +173,286 @@ unsigned char usciXNSpiTxBuffer(const USCIXNSPI *const usciXN, const unsigned ch
 
     return txFail;
 }
+
+/************************************************************************************
+* Function: usciXNSpiTxBurst
+*
+* Description:
+*   Sends an array of bytes back to back, making use of the double-buffered TXBUF:
+*   each byte is loaded as soon as TXIFG shows the previous one has moved into the
+*   shift register, so SCLK never stops between bytes. Only the end of the last
+*   byte is waited for (UCBUSY), after which the chip select bits are released.
+*   This is about twice as fast as usciXNSpiTxBuffer, which waits for RXIFG after
+*   every byte. Received bytes are discarded; RXBUF is read once at the end, which
+*   also clears RXIFG and the overrun flag left by the bytes that were not read.
+*
+*   If csOut is nonzero, the csMask bits are asserted before the first byte, and
+*   released once the last byte has been completely shifted out, with the polarity
+*   set by SPI_QUEUE_CS_ACTIVE_HIGH.
+*
+*   Just as with usciXNSpiTxBuffer, this must not be called while an async transmit
+*   queue on the same peripheral is not drained.
+*
+* Arguments:
+*   *usciXN     -   pointer to the USCI peripheral object
+*   *buffer     -   pointer to the first element of the buffer
+*   buffLen     -   number of bytes to send from the buffer (usually length of buffer)
+*   *csOut      -   address of the chip select output register, or 0 for no chip select
+*   csMask      -   chip select bit(s) to hold asserted for the whole burst
+*
+* Returns:
+*   char txFail; 0 if transmission was successful, nonzero if buffLen was greater than
+*   the length of the SPI buffer defined in the header (nothing is sent in that case).
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char usciXNSpiTxBurst(const USCIXNSPI *const usciXN, const unsigned char *const buffer, const int buffLen, volatile unsigned char *const csOut, const unsigned char csMask)
+{
+    unsigned char txFail = 0;
+    unsigned int currentChar;   // counter for txloop
+
+    // ensure buffLen is valid based on header file definition
+    if (buffLen <= SPI_BUF_SZ)
+    {
+        if (csOut)
+            SPI_CS_ASSERT(csOut, csMask);
+
+        // TXIFG is set again as soon as a byte moves into the shift register, while the byte before it may still be shifting
+        for (currentChar = 0; currentChar < buffLen; currentChar++)
+        {
+            WAIT_FOR_TX;
+            *(usciXN->UCXNTXBUF) = buffer[currentChar];
+            HAL_SPI_TX(usciXN->UCXNTXBUF);
+        }
+
+        // the last byte is only done once the USCI is no longer busy
+        while (*(usciXN->UCXNSTAT) & UCBUSY) HAL_SYNC();
+
+        if (csOut)
+            SPI_CS_RELEASE(csOut, csMask);
+
+        (void)*(usciXN->UCXNRXBUF);
+        *(usciXN->UCXNIFG) &= ~(usciXN->UCXNRXIFG);
+    }
+    else
+        txFail = 1;
+
+    return txFail;
+}
+
+#if (SPI_ASYNC_QUEUE)
+
+// asserts/releases the chip select bits of a queued entry
+#define QUEUE_CS_ASSERT(entry)  SPI_CS_ASSERT((entry)->csOut, (entry)->csMask)
+#define QUEUE_CS_RELEASE(entry) SPI_CS_RELEASE((entry)->csOut, (entry)->csMask)
+
+#define QUEUE_IDX_MASK  (SPI_QUEUE_SZ - 1)  // used to wrap ring buffer indexes, as SPI_QUEUE_SZ is a power of 2
+
+/************************************************************************************
+* Function: usciXNSpiQueueInit
+*
+* Description:
+*   Resets the given transmit queue to an empty, drained state, and ensures the
+*   peripheral's RX interrupt is disabled until bytes are queued. This should be
+*   called after usciXNSpiInit, and before any calls to usciXNSpiEnqueue.
+*
+* Arguments:
+*   *usciXN     -   pointer to the USCI peripheral object
+*   *queue      -   pointer to the transmit queue object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void usciXNSpiQueueInit(const USCIXNSPI *const usciXN, USCIXNSPI_QUEUE *const queue)
+{
+    *(usciXN->UCXNIE) &= ~(usciXN->UCXNRXIE);   // the RX interrupt is only enabled while the queue is transmitting
+
+    queue->head = 0;
+    queue->tail = 0;
+    queue->drained = 1;
+}
+
+/************************************************************************************
+* Function: usciXNSpiEnqueue
+*
+* Description:
+*   Adds a byte to the transmit queue without waiting for it to be shifted out.
+*   If the queue was drained, the transfer is started immediately: the entry's chip
+*   select bits are asserted, TXBUF is loaded, and the RX interrupt is enabled so
+*   usciXNSpiQueueISR can release the chip select and start the next entry once
+*   the byte has finished shifting.
+*
+*   While the queue is not drained, usciXNSpiPutChar and usciXNSpiTxBuffer must
+*   not be called on the same peripheral, as the ISR will consume their RXIFG.
+*
+* Arguments:
+*   *usciXN     -   pointer to the USCI peripheral object
+*   *queue      -   pointer to the transmit queue object
+*   *csOut      -   address of the chip select output register, or 0 for no chip select
+*   csMask      -   chip select bit(s) to assert while the byte is shifted out
+*   txByte      -   the byte to be shifted out
+*
+* Returns:
+*   char queueFull; 0 if the byte was queued, nonzero if the queue was full and the
+*   byte was NOT queued.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char usciXNSpiEnqueue(const USCIXNSPI *const usciXN, USCIXNSPI_QUEUE *const queue, volatile unsigned char *const csOut, const unsigned char csMask, const unsigned char txByte)
+{
+    unsigned char queueFull = 0;
+    unsigned char nextHead = (queue->head + 1) & QUEUE_IDX_MASK;
+    unsigned short intState;    // GIE state upon entry, restored once the queue indexes are updated
+    USCIXNSPI_TX_ENTRY *entry;
+
+    // one entry is always kept free so a full queue can be told apart from an empty one
+    if (nextHead != queue->tail)
+    {
+        entry = &(queue->entries[queue->head]);
+        entry->csOut = csOut;
+        entry->csMask = csMask;
+        entry->txByte = txByte;
+
+        // the ISR may drain the queue between checking and starting it, so this must be atomic
+        intState = __get_interrupt_state();
+        __disable_interrupt();
+
+        queue->head = nextHead;
+
+        // nothing is being transmitted, so the ISR won't pick this entry up on its own; start it here
+        if (queue->drained)
+        {
+            queue->drained = 0;
+            if (entry->csOut)
+                QUEUE_CS_ASSERT(entry);
+            *(usciXN->UCXNIFG) &= ~(usciXN->UCXNRXIFG);
+            *(usciXN->UCXNTXBUF) = entry->txByte;
+            HAL_SPI_TX(usciXN->UCXNTXBUF);
+            *(usciXN->UCXNIE) |= (usciXN->UCXNRXIE);
+        }
+
+        __set_interrupt_state(intState);
+    }
+    else
+        queueFull = 1;
+
+    return queueFull;
+}
+
+/************************************************************************************
+* Function: usciXNSpiQueueISR
+*
+* Description:
+*   Services the completion of the byte at the tail of the queue; this must be
+*   called from the client's ISR for the peripheral's RX vector. The finished
+*   entry's chip select is released, and the next entry (if any) is started.
+*   Once the queue is empty, the drained flag is set and the RX interrupt is
+*   disabled so synchronous transfers can use the peripheral again.
+*
+* Arguments:
+*   *usciXN     -   pointer to the USCI peripheral object
+*   *queue      -   pointer to the transmit queue object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void usciXNSpiQueueISR(const USCIXNSPI *const usciXN, USCIXNSPI_QUEUE *const queue)
+{
+    USCIXNSPI_TX_ENTRY *entry;
+
+    *(usciXN->UCXNIFG) &= ~(usciXN->UCXNRXIFG); // the received (loopback) byte is never needed
+
+    if (!(queue->drained))
+    {
+        // the byte at the tail has been completely shifted out, so its chip select can be released
+        entry = &(queue->entries[queue->tail]);
+        if (entry->csOut)
+            QUEUE_CS_RELEASE(entry);
+
+        queue->tail = (queue->tail + 1) & QUEUE_IDX_MASK;
+
+        // start the next entry, or signal that the queue is drained
+        if (queue->tail != queue->head)
+        {
+            entry = &(queue->entries[queue->tail]);
+            if (entry->csOut)
+                QUEUE_CS_ASSERT(entry);
+            *(usciXN->UCXNTXBUF) = entry->txByte;
+            HAL_SPI_TX(usciXN->UCXNTXBUF);
+        }
+        else
+        {
+            *(usciXN->UCXNIE) &= ~(usciXN->UCXNRXIE);
+            queue->drained = 1;
+        }
+    }
+    else
+        *(usciXN->UCXNIE) &= ~(usciXN->UCXNRXIE);   // nothing to service; make sure this interrupt doesn't keep firing
+}
+
+/************************************************************************************
+* Function: usciXNSpiQueuePoll
+*
+* Description:
+*   Services a completed queue transfer by polling RXIFG rather than waiting for
+*   the interrupt; this allows the queue to make progress while GIE is cleared
+*   (in a critical fault handler, for example). Interrupts are disabled while the
+*   flag is checked and serviced, so this is also safe to call with GIE set.
+*
+* Arguments:
+*   *usciXN     -   pointer to the USCI peripheral object
+*   *queue      -   pointer to the transmit queue object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void usciXNSpiQueuePoll(const USCIXNSPI *const usciXN, USCIXNSPI_QUEUE *const queue)
+{
+    unsigned short intState;
+
+    HAL_SYNC();     // every caller polls in a loop
+
+    intState = __get_interrupt_state();
+    __disable_interrupt();
+
+    if (!(queue->drained) && (*(usciXN->UCXNIFG) & (usciXN->UCXNRXIFG)))
+        usciXNSpiQueueISR(usciXN, queue);
+
+    __set_interrupt_state(intState);
+}
+
+/************************************************************************************
+* Function: usciXNSpiQueueFlush
+*
+* Description:
+*   Blocks until every queued byte has been shifted out, using usciXNSpiQueuePoll
+*   so the queue is guaranteed to drain whether or not interrupts are enabled.
+*
+* Arguments:
+*   *usciXN     -   pointer to the USCI peripheral object
+*   *queue      -   pointer to the transmit queue object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void usciXNSpiQueueFlush(const USCIXNSPI *const usciXN, USCIXNSPI_QUEUE *const queue)
+{
+    while (!(queue->drained))
+        usciXNSpiQueuePoll(usciXN, queue);
+}
+
+#endif
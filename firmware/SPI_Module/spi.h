@@ -19,11 +19,28 @@
 * This could save a lot of SPI bus bandwidth under certain circumstances, and would
 * not be possible if slave select was managed by this module.
 *
-* THIS MODULE CURRENTLY ONLY SUPPORTS 3-WIRE MASTER MODE
+* The one exception is the optional asynchronous transmit queue (SPI_ASYNC_QUEUE).
+* A USCIXNSPI_QUEUE object holds (chip select register, chip select mask, byte)
+* entries which are shifted out one at a time by the USCI RX interrupt; since the
+* client is no longer in control of when each byte finishes, the queue asserts and
+* releases the chip select bits of each entry itself. The client must still define
+* the ISR for the USCI RX vector, and simply call usciXNSpiQueueISR() from it.
+* Chip selects are treated as active HIGH by default (SPI_QUEUE_CS_ACTIVE_HIGH).
+*
+* Likewise, usciXNSpiTxBurst can hold a chip select for a whole multi-byte burst,
+* since only it knows when the last byte has finished shifting out.
+*
+* Where a peripheral is fixed at build time, SPI_DEFINE_INSTANCE(NAME, ...) can also
+* be used by the client to emit spiNAMEPutChar(), spiNAMETxBuffer(), and spiNAMETxBurst()
+* versions of the transmit functions for that one peripheral, with its registers and
+* flags as constants rather than read through the usciXN object each time.
+*
+* THIS MODULE CURRENTLY ONLY SUPPORTS 3-WIRE MODE; usciXNSpiInit can also set up a
+* slave (see "ctrlLink.h"), but every transmit function here is for master mode only
 *
 * Author:       Mason Kury
 * Created:      November 10, 2022
-* Modified:     November 18, 2022
+* Modified:     October 14, 2026
 ************************************************************************************/
 
 #ifndef SPI_MODULE_SPI_H_
@@ -54,15 +71,85 @@
 #define WAIT_FOR_PUTCHAR    1       // set to 1 if usciXNSpiPutChar() should wait for transmission to finish before returning; 0 to not wait
 #define SPI_BUF_SZ          100     // the maximum size of an SPI buffer to transmit
 #define SECONDARY_UCXNSEL   1       // set to 1 if your device has a secondary function select register for peripheral devices
+#define SPI_ASYNC_QUEUE     0       // set to 1 to build the interrupt-driven transmit queue functions; 0 to leave them out
+#define SPI_QUEUE_SZ        8       // number of entries in an async transmit queue (MUST be a power of 2; one entry is always kept free)
+#define SPI_QUEUE_CS_ACTIVE_HIGH 1  // set to 1 if queued (and burst) chip selects are asserted by setting their bits HIGH; 0 for active low
 
 
 //########## PREPROCESSOR MACROS ##########//
 
 // waits for TXIFG to determine when TXBUF is available to load and transmit
-#define WAIT_FOR_TX     while (!(*(usciXN->UCXNIFG) & (usciXN->UCXNTXIFG)))
+#define WAIT_FOR_TX     while (!(*(usciXN->UCXNIFG) & (usciXN->UCXNTXIFG))) HAL_SYNC()
 
 // waits for RXIFG to determine when transmission is complete; used within functions where a UCXNSPI object is passed as *ucsiXN
-#define WAIT_FOR_RX     while (!(*(usciXN->UCXNIFG) & usciXN->UCXNRXIFG)); *(usciXN->UCXNIFG) &= ~(usciXN->UCXNRXIFG)
+#define WAIT_FOR_RX     while (!(*(usciXN->UCXNIFG) & usciXN->UCXNRXIFG)) HAL_SYNC(); *(usciXN->UCXNIFG) &= ~(usciXN->UCXNRXIFG)
+
+// asserts/releases chip select bits managed by this module (burst transfers and queued entries) based on the configured chip select polarity
+#if (SPI_QUEUE_CS_ACTIVE_HIGH)
+#define SPI_CS_ASSERT(csOut, csMask)    HAL_PIN_SET(*(csOut), (csMask))
+#define SPI_CS_RELEASE(csOut, csMask)   HAL_PIN_CLR(*(csOut), (csMask))
+#else
+#define SPI_CS_ASSERT(csOut, csMask)    HAL_PIN_CLR(*(csOut), (csMask))
+#define SPI_CS_RELEASE(csOut, csMask)   HAL_PIN_SET(*(csOut), (csMask))
+#endif
+
+/* Emits spi##NAME##PutChar(), spi##NAME##TxBuffer(), and spi##NAME##TxBurst(), which work the same as the usciXNSpi functions of the same names, but
+ * with the registers and flags of one USCI peripheral (ex: IFG2, UCA0TXIFG, UCA0RXIFG, UCA0STAT, UCA0TXBUF, UCA0RXBUF) built in as constants, so
+ * the compiler can address them directly instead of loading each one from a USCIXNSPI object. The peripheral must still be set up with
+ * usciXNSpiInit(), and the generic functions remain available for other peripherals, or for code that selects a peripheral at run time. */
+#define SPI_DEFINE_INSTANCE(NAME, IFG_REG, TXIFG_BIT, RXIFG_BIT, STAT_REG, TXBUF_REG, RXBUF_REG)                            \
+__inline static void spi##NAME##PutChar(const unsigned char txByte)                                                         \
+{                                                                                                                           \
+    while (!((IFG_REG) & (TXIFG_BIT))) HAL_SYNC();                                                                          \
+    (TXBUF_REG) = txByte;                                                                                                   \
+    HAL_SPI_TX(&(TXBUF_REG));                                                                                               \
+    if (WAIT_FOR_PUTCHAR)                                                                                                   \
+    {                                                                                                                       \
+        while (!((IFG_REG) & (RXIFG_BIT))) HAL_SYNC();                                                                      \
+        (IFG_REG) &= ~(RXIFG_BIT);                                                                                          \
+    }                                                                                                                       \
+}                                                                                                                           \
+                                                                                                                            \
+__inline static unsigned char spi##NAME##TxBuffer(const unsigned char *const buffer, const int buffLen)                     \
+{                                                                                                                           \
+    int currentChar;                                                                                                        \
+                                                                                                                            \
+    if (buffLen > SPI_BUF_SZ)                                                                                               \
+        return 1;                                                                                                           \
+    for (currentChar = 0; currentChar < buffLen; currentChar++)                                                             \
+    {                                                                                                                       \
+        spi##NAME##PutChar(buffer[currentChar]);                                                                            \
+        if (!WAIT_FOR_PUTCHAR)                                                                                              \
+        {                                                                                                                   \
+            while (!((IFG_REG) & (RXIFG_BIT))) HAL_SYNC();                                                                  \
+            (IFG_REG) &= ~(RXIFG_BIT);                                                                                      \
+        }                                                                                                                   \
+    }                                                                                                                       \
+    return 0;                                                                                                               \
+}                                                                                                                           \
+                                                                                                                            \
+__inline static unsigned char spi##NAME##TxBurst(const unsigned char *const buffer, const int buffLen,                      \
+                                                 volatile unsigned char *const csOut, const unsigned char csMask)           \
+{                                                                                                                           \
+    int currentChar;                                                                                                        \
+                                                                                                                            \
+    if (buffLen > SPI_BUF_SZ)                                                                                               \
+        return 1;                                                                                                           \
+    if (csOut)                                                                                                              \
+        SPI_CS_ASSERT(csOut, csMask);                                                                                       \
+    for (currentChar = 0; currentChar < buffLen; currentChar++)                                                             \
+    {                                                                                                                       \
+        while (!((IFG_REG) & (TXIFG_BIT))) HAL_SYNC();                                                                      \
+        (TXBUF_REG) = buffer[currentChar];                                                                                  \
+        HAL_SPI_TX(&(TXBUF_REG));                                                                                           \
+    }                                                                                                                       \
+    while ((STAT_REG) & UCBUSY) HAL_SYNC();                                                                                 \
+    if (csOut)                                                                                                              \
+        SPI_CS_RELEASE(csOut, csMask);                                                                                      \
+    (void)(RXBUF_REG);                                                                                                      \
+    (IFG_REG) &= ~(RXIFG_BIT);                                                                                              \
+    return 0;                                                                                                               \
+}
 
 
 //########## STRUCTURES ##########//
@@ -87,9 +174,35 @@ typedef struct USCIXNSPI
     volatile unsigned char *const UCXNIFG;
     const unsigned char UCXNTXIFG;
     const unsigned char UCXNRXIFG;
+
+    // interrupt enable register and RX interrupt bit (only required by the async transmit queue; ex: &IE2 and UCA0RXIE)
+    volatile unsigned char *const UCXNIE;
+    const unsigned char UCXNRXIE;
 }
 USCIXNSPI;
 
+#if (SPI_ASYNC_QUEUE)
+// a single byte waiting to be shifted out by the async transmit queue, along with the chip select(s) to hold active during the transfer
+typedef struct USCIXNSPI_TX_ENTRY
+{
+    volatile unsigned char *csOut;  // address of the chip select output register (ex: &P3OUT); may be 0 if no chip select is required
+    unsigned char csMask;           // chip select bit(s) within *csOut to assert for this byte; multiple bits allow for broadcast writes
+    unsigned char txByte;           // the byte to be shifted out
+}
+USCIXNSPI_TX_ENTRY;
+
+/* Ring buffer drained by the USCI RX interrupt. The client is the only producer (head), and the ISR is the only consumer (tail).
+ * The entry at the tail is the one currently being shifted out; it is not released until its RXIFG is serviced. */
+typedef struct USCIXNSPI_QUEUE
+{
+    USCIXNSPI_TX_ENTRY entries[SPI_QUEUE_SZ];
+    volatile unsigned char head;    // index of the next free entry
+    volatile unsigned char tail;    // index of the entry currently being transmitted
+    volatile unsigned char drained; // 1 once every queued byte has been shifted out and its chip select released; 0 while transmitting
+}
+USCIXNSPI_QUEUE;
+#endif
+
 
 //########## FUNCTION PROTOTYPES ##########//
 
@@ -192,5 +305,153 @@ void usciXNSpiPutChar(const USCIXNSPI *const usciXN, const unsigned char txByte)
 ************************************************************************************/
 unsigned char usciXNSpiTxBuffer(const USCIXNSPI *const usciXN, const unsigned char *const buffer, const int buffLen);
 
+/************************************************************************************
+* Function: usciXNSpiTxBurst
+*
+* Description:
+*   Sends an array of bytes back to back, making use of the double-buffered TXBUF:
+*   each byte is loaded as soon as TXIFG shows the previous one has moved into the
+*   shift register, so SCLK never stops between bytes. Only the end of the last
+*   byte is waited for (UCBUSY), after which the chip select bits are released.
+*   This is about twice as fast as usciXNSpiTxBuffer, which waits for RXIFG after
+*   every byte. Received bytes are discarded; RXBUF is read once at the end, which
+*   also clears RXIFG and the overrun flag left by the bytes that were not read.
+*
+*   If csOut is nonzero, the csMask bits are asserted before the first byte, and
+*   released once the last byte has been completely shifted out, with the polarity
+*   set by SPI_QUEUE_CS_ACTIVE_HIGH.
+*
+*   Just as with usciXNSpiTxBuffer, this must not be called while an async transmit
+*   queue on the same peripheral is not drained.
+*
+* Arguments:
+*   *usciXN     -   pointer to the USCI peripheral object
+*   *buffer     -   pointer to the first element of the buffer
+*   buffLen     -   number of bytes to send from the buffer (usually length of buffer)
+*   *csOut      -   address of the chip select output register, or 0 for no chip select
+*   csMask      -   chip select bit(s) to hold asserted for the whole burst
+*
+* Returns:
+*   char txFail; 0 if transmission was successful, nonzero if buffLen was greater than
+*   the length of the SPI buffer defined in the header (nothing is sent in that case).
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char usciXNSpiTxBurst(const USCIXNSPI *const usciXN, const unsigned char *const buffer, const int buffLen, volatile unsigned char *const csOut, const unsigned char csMask);
+
+#if (SPI_ASYNC_QUEUE)
+/************************************************************************************
+* Function: usciXNSpiQueueInit
+*
+* Description:
+*   Resets the given transmit queue to an empty, drained state, and ensures the
+*   peripheral's RX interrupt is disabled until bytes are queued. This should be
+*   called after usciXNSpiInit, and before any calls to usciXNSpiEnqueue.
+*
+* Arguments:
+*   *usciXN     -   pointer to the USCI peripheral object
+*   *queue      -   pointer to the transmit queue object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void usciXNSpiQueueInit(const USCIXNSPI *const usciXN, USCIXNSPI_QUEUE *const queue);
+
+/************************************************************************************
+* Function: usciXNSpiEnqueue
+*
+* Description:
+*   Adds a byte to the transmit queue without waiting for it to be shifted out.
+*   If the queue was drained, the transfer is started immediately: the entry's chip
+*   select bits are asserted, TXBUF is loaded, and the RX interrupt is enabled so
+*   usciXNSpiQueueISR can release the chip select and start the next entry once
+*   the byte has finished shifting.
+*
+*   While the queue is not drained, usciXNSpiPutChar and usciXNSpiTxBuffer must
+*   not be called on the same peripheral, as the ISR will consume their RXIFG.
+*
+* Arguments:
+*   *usciXN     -   pointer to the USCI peripheral object
+*   *queue      -   pointer to the transmit queue object
+*   *csOut      -   address of the chip select output register, or 0 for no chip select
+*   csMask      -   chip select bit(s) to assert while the byte is shifted out
+*   txByte      -   the byte to be shifted out
+*
+* Returns:
+*   char queueFull; 0 if the byte was queued, nonzero if the queue was full and the
+*   byte was NOT queued.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char usciXNSpiEnqueue(const USCIXNSPI *const usciXN, USCIXNSPI_QUEUE *const queue, volatile unsigned char *const csOut, const unsigned char csMask, const unsigned char txByte);
+
+/************************************************************************************
+* Function: usciXNSpiQueueISR
+*
+* Description:
+*   Services the completion of the byte at the tail of the queue; this must be
+*   called from the client's ISR for the peripheral's RX vector. The finished
+*   entry's chip select is released, and the next entry (if any) is started.
+*   Once the queue is empty, the drained flag is set and the RX interrupt is
+*   disabled so synchronous transfers can use the peripheral again.
+*
+* Arguments:
+*   *usciXN     -   pointer to the USCI peripheral object
+*   *queue      -   pointer to the transmit queue object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void usciXNSpiQueueISR(const USCIXNSPI *const usciXN, USCIXNSPI_QUEUE *const queue);
+
+/************************************************************************************
+* Function: usciXNSpiQueuePoll
+*
+* Description:
+*   Services a completed queue transfer by polling RXIFG rather than waiting for
+*   the interrupt; this allows the queue to make progress while GIE is cleared
+*   (in a critical fault handler, for example). Interrupts are disabled while the
+*   flag is checked and serviced, so this is also safe to call with GIE set.
+*
+* Arguments:
+*   *usciXN     -   pointer to the USCI peripheral object
+*   *queue      -   pointer to the transmit queue object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void usciXNSpiQueuePoll(const USCIXNSPI *const usciXN, USCIXNSPI_QUEUE *const queue);
+
+/************************************************************************************
+* Function: usciXNSpiQueueFlush
+*
+* Description:
+*   Blocks until every queued byte has been shifted out, using usciXNSpiQueuePoll
+*   so the queue is guaranteed to drain whether or not interrupts are enabled.
+*
+* Arguments:
+*   *usciXN     -   pointer to the USCI peripheral object
+*   *queue      -   pointer to the transmit queue object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void usciXNSpiQueueFlush(const USCIXNSPI *const usciXN, USCIXNSPI_QUEUE *const queue);
+#endif
+
 
 #endif /* SPI_MODULE_SPI_H_ */
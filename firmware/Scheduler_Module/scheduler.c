@@ -0,0 +1,217 @@
+/************************************************************************************
+* See header file for general module documentation
+************************************************************************************/
+
+
+//########## DEPENDENCIES ##########//
+#include "hal.h"
+#include "scheduler.h"
+
+
+//########## FUNCTION DEFINITIONS ##########//
+
+/************************************************************************************
+* Function: schedInit
+*
+* Description:
+*   Disarms every task in the given scheduler, and stops the tick.
+*
+* Arguments:
+*   *sched      -   pointer to the scheduler object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void schedInit(SCHEDULER *const sched)
+{
+    unsigned short intState = __get_interrupt_state();
+
+    __disable_interrupt();
+    SCHED_TIMER_CCTL &= ~CCIE;
+    sched->tick = 0;
+    sched->armedMask = 0x00;
+    sched->dueMask = 0x00;
+    __set_interrupt_state(intState);
+}
+
+/************************************************************************************
+* Function: schedStart
+*
+* Description:
+*   Arms a task to become due delayTicks ticks from now, and then every periodTicks
+*   ticks after that (or only once, if periodTicks is 0). A task that was already
+*   armed is rescheduled, and any run of it not yet collected is discarded. The tick
+*   is started if it was not already running.
+*
+*   Interrupts are held off while the task is armed, so this can be called from both
+*   ISRs and the main loop.
+*
+* Arguments:
+*   *sched      -   pointer to the scheduler object
+*   taskIndex   -   the task to arm (0 to SCHED_NUM_TASKS - 1)
+*   delayTicks  -   ticks until the task is first due; 0 is taken as 1
+*   periodTicks -   ticks between each following run, or 0 for a one-shot task
+*
+* Returns:
+*   unsigned char taskError; 0 if the task was armed, nonzero if taskIndex was
+*   invalid.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char schedStart(SCHEDULER *const sched, const unsigned char taskIndex, unsigned int delayTicks, const unsigned int periodTicks)
+{
+    unsigned char taskError = 1;
+    unsigned char taskBit;
+    unsigned short intState;
+
+    if (taskIndex < SCHED_NUM_TASKS)
+    {
+        taskBit = SCHED_TASK_BIT(taskIndex);
+
+        // a due tick equal to the current tick would not come up again until the count wraps around
+        if (!delayTicks)
+            delayTicks = 1;
+
+        intState = __get_interrupt_state();
+        __disable_interrupt();
+
+        // start the tick if nothing else was armed, so the first tick comes a whole period from now (this also clears any stale CCIFG)
+        if (!(sched->armedMask))
+        {
+            SCHED_TIMER_CCR = SCHED_TIMER_R + SCHED_TICK_PERIOD;
+            SCHED_TIMER_CCTL = CCIE;
+        }
+
+        sched->tasks[taskIndex].dueTick = sched->tick + delayTicks;
+        sched->tasks[taskIndex].period = periodTicks;
+        sched->armedMask |= taskBit;
+        sched->dueMask &= ~taskBit;
+
+        __set_interrupt_state(intState);
+        taskError = 0;
+    }
+
+    return taskError;
+}
+
+/************************************************************************************
+* Function: schedStop
+*
+* Description:
+*   Disarms a task, discarding any run of it not yet collected. The tick is stopped
+*   once no tasks are left armed. Interrupts are held off while the task is
+*   disarmed, so this can be called from both ISRs and the main loop.
+*
+* Arguments:
+*   *sched      -   pointer to the scheduler object
+*   taskIndex   -   the task to disarm (0 to SCHED_NUM_TASKS - 1)
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void schedStop(SCHEDULER *const sched, const unsigned char taskIndex)
+{
+    unsigned char taskBit = SCHED_TASK_BIT(taskIndex);
+    unsigned short intState = __get_interrupt_state();
+
+    __disable_interrupt();
+    sched->armedMask &= ~taskBit;
+    sched->dueMask &= ~taskBit;
+
+    // nothing is left to count ticks for
+    if (!(sched->armedMask))
+        SCHED_TIMER_CCTL &= ~CCIE;
+    __set_interrupt_state(intState);
+}
+
+/************************************************************************************
+* Function: schedTick
+*
+* Description:
+*   Counts one tick, and schedules the next one on SCHED_TIMER_CCR. Every armed task
+*   whose due tick has come up is marked as due; periodic tasks are rescheduled for
+*   their next run, and one-shot tasks are disarmed. The tick is stopped once no
+*   tasks are left armed.
+*
+*   This should only be called by the ISR for SCHED_TIMER_CCR.
+*
+* Arguments:
+*   *sched      -   pointer to the scheduler object
+*
+* Returns:
+*   unsigned char noneDue; 0 if a task became due (so the main loop should be woken
+*   to collect it), otherwise 1
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char schedTick(SCHEDULER *const sched)
+{
+    unsigned char noneDue = 1;
+    unsigned char taskBit = 0x01;   // bit within the armed and due masks representing the current task
+    unsigned char taskIndex;
+    SCHED_TASK *task;
+
+    SCHED_TIMER_CCR += SCHED_TICK_PERIOD;
+    sched->tick++;
+
+    for (taskIndex = 0; taskIndex < SCHED_NUM_TASKS; taskIndex++)
+    {
+        task = &(sched->tasks[taskIndex]);
+        if ((sched->armedMask & taskBit) && (task->dueTick == sched->tick))
+        {
+            sched->dueMask |= taskBit;
+            noneDue = 0;
+
+            if (task->period)
+                task->dueTick += task->period;
+            else
+                sched->armedMask &= ~taskBit;
+        }
+
+        taskBit <<= 1;
+    }
+
+    // stop ticking once nothing is armed, so the CPU can stay asleep
+    if (!(sched->armedMask))
+        SCHED_TIMER_CCTL &= ~CCIE;
+
+    return noneDue;
+}
+
+/************************************************************************************
+* Function: schedPopDue
+*
+* Description:
+*   Collects every task that has become due since the last call, clearing them from
+*   the scheduler's due mask. The caller is then responsible for running each task
+*   in the returned mask. Interrupts are held off while the mask is collected.
+*
+* Arguments:
+*   *sched      -   pointer to the scheduler object
+*
+* Returns:
+*   unsigned char dueMask; bit n (see SCHED_TASK_BIT) is set if task n is due
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char schedPopDue(SCHEDULER *const sched)
+{
+    unsigned char dueMask;
+    unsigned short intState = __get_interrupt_state();
+
+    __disable_interrupt();
+    dueMask = sched->dueMask;
+    sched->dueMask = 0x00;
+    __set_interrupt_state(intState);
+
+    return dueMask;
+}
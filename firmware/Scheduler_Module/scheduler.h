@@ -0,0 +1,195 @@
+/************************************************************************************
+* Tick Scheduler Module
+*
+* Contains a small cooperative scheduler, so every timed behaviour of a client can
+* share a single low-power timebase instead of each needing its own timer channel
+* (or a blocking __delay_cycles spin). One compare channel of a timer running in
+* continuous mode from ACLK (VLOCLK by default) generates a periodic tick, every
+* SCHED_TICK_MS; the tick keeps running in LPM3.
+*
+* The scheduler holds a fixed table of SCHED_NUM_TASKS tasks, numbered by the client.
+* schedStart arms a task to become due after a given number of ticks, either once or
+* repeatedly with a given period. schedTick, called by the client's ISR for the tick
+* channel, marks tasks as due when their tick comes up, and reports whether the main
+* loop should be woken. The main loop then collects the due tasks with schedPopDue,
+* and runs them itself; no task code is ever run from the ISR.
+*
+* The tick is only generated while at least one task is armed, so the CPU is not
+* woken at all while nothing is scheduled. Since the tick is started when the first
+* task is armed, that task's first run is exactly its delay after schedStart; tasks
+* armed while the tick is already running may run up to a tick early.
+*
+* A periodic task whose previous run has not been collected by the time it is due
+* again is only reported once.
+*
+* Please note: the client must have started the timer (see SCHED_TIMER_R) in
+* continuous mode from ACLK before arming any task, and must call schedTick from the
+* interrupt for SCHED_TIMER_CCR; the channel may not be used for anything else.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+
+#ifndef SCHEDULER_MODULE_SCHEDULER_H_
+#define SCHEDULER_MODULE_SCHEDULER_H_
+
+
+//########## SYMBOLIC CONSTANTS ##########//
+
+// user-defined constants
+#define SCHED_NUM_TASKS     4       // number of tasks in the scheduler's table (due masks are 8 bits wide, so this must not be greater than 8)
+#define SCHED_TICK_MS       10      // length of one scheduler tick, in milliseconds
+#define SCHED_ACLK_HZ       12000UL // frequency of ACLK, which the tick timer runs from (typical VLOCLK)
+
+// timer compare channel used for the tick; the timer itself must already be running in continuous mode from ACLK
+#define SCHED_TIMER_R       TA0R
+#define SCHED_TIMER_CCR     TA0CCR1
+#define SCHED_TIMER_CCTL    TA0CCTL1
+
+#define SCHED_TICK_PERIOD   ((SCHED_TICK_MS * SCHED_ACLK_HZ) / 1000UL)  // number of ACLK cycles per scheduler tick
+
+
+//########## PREPROCESSOR MACROS ##########//
+
+// converts a number of milliseconds to scheduler ticks, rounding up so a delay is never shorter than asked for
+#define SCHED_MS_TO_TICKS(ms)       (((ms) + SCHED_TICK_MS - 1) / SCHED_TICK_MS)
+
+// evaluates as the bit representing a task in the scheduler's armed and due masks
+#define SCHED_TASK_BIT(taskIndex)   (0x01 << (taskIndex))
+
+// evaluates as nonzero if a task is due and has not been collected by schedPopDue (for checking before entering a low power mode)
+#define SCHED_TASKS_DUE(sched)      ((sched)->dueMask)
+
+// evaluates as nonzero while a task is armed
+#define SCHED_TASK_ARMED(sched, taskIndex)  ((sched)->armedMask & SCHED_TASK_BIT(taskIndex))
+
+
+//########## STRUCTURES ##########//
+
+typedef struct SCHED_TASK
+{
+    unsigned int dueTick;           // value of the scheduler's tick count at which the task is next due
+    unsigned int period;            // ticks between runs of a periodic task, or 0 for a one-shot task
+}
+SCHED_TASK;
+
+typedef struct SCHEDULER
+{
+    volatile unsigned int tick;             // ticks counted by schedTick; wraps around, as tasks are only compared for equality
+    volatile unsigned char armedMask;       // bit n is set while task n is armed
+    volatile unsigned char dueMask;         // bit n is set once task n is due, until collected by schedPopDue
+    SCHED_TASK tasks[SCHED_NUM_TASKS];
+}
+SCHEDULER;
+
+
+//########## FUNCTION PROTOTYPES ##########//
+
+/************************************************************************************
+* Function: schedInit
+*
+* Description:
+*   Disarms every task in the given scheduler, and stops the tick.
+*
+* Arguments:
+*   *sched      -   pointer to the scheduler object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void schedInit(SCHEDULER *const sched);
+
+/************************************************************************************
+* Function: schedStart
+*
+* Description:
+*   Arms a task to become due delayTicks ticks from now, and then every periodTicks
+*   ticks after that (or only once, if periodTicks is 0). A task that was already
+*   armed is rescheduled, and any run of it not yet collected is discarded. The tick
+*   is started if it was not already running.
+*
+*   Interrupts are held off while the task is armed, so this can be called from both
+*   ISRs and the main loop.
+*
+* Arguments:
+*   *sched      -   pointer to the scheduler object
+*   taskIndex   -   the task to arm (0 to SCHED_NUM_TASKS - 1)
+*   delayTicks  -   ticks until the task is first due; 0 is taken as 1
+*   periodTicks -   ticks between each following run, or 0 for a one-shot task
+*
+* Returns:
+*   unsigned char taskError; 0 if the task was armed, nonzero if taskIndex was
+*   invalid.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char schedStart(SCHEDULER *const sched, const unsigned char taskIndex, unsigned int delayTicks, const unsigned int periodTicks);
+
+/************************************************************************************
+* Function: schedStop
+*
+* Description:
+*   Disarms a task, discarding any run of it not yet collected. The tick is stopped
+*   once no tasks are left armed. Interrupts are held off while the task is
+*   disarmed, so this can be called from both ISRs and the main loop.
+*
+* Arguments:
+*   *sched      -   pointer to the scheduler object
+*   taskIndex   -   the task to disarm (0 to SCHED_NUM_TASKS - 1)
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void schedStop(SCHEDULER *const sched, const unsigned char taskIndex);
+
+/************************************************************************************
+* Function: schedTick
+*
+* Description:
+*   Counts one tick, and schedules the next one on SCHED_TIMER_CCR. Every armed task
+*   whose due tick has come up is marked as due; periodic tasks are rescheduled for
+*   their next run, and one-shot tasks are disarmed. The tick is stopped once no
+*   tasks are left armed.
+*
+*   This should only be called by the ISR for SCHED_TIMER_CCR.
+*
+* Arguments:
+*   *sched      -   pointer to the scheduler object
+*
+* Returns:
+*   unsigned char noneDue; 0 if a task became due (so the main loop should be woken
+*   to collect it), otherwise 1
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char schedTick(SCHEDULER *const sched);
+
+/************************************************************************************
+* Function: schedPopDue
+*
+* Description:
+*   Collects every task that has become due since the last call, clearing them from
+*   the scheduler's due mask. The caller is then responsible for running each task
+*   in the returned mask. Interrupts are held off while the mask is collected.
+*
+* Arguments:
+*   *sched      -   pointer to the scheduler object
+*
+* Returns:
+*   unsigned char dueMask; bit n (see SCHED_TASK_BIT) is set if task n is due
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char schedPopDue(SCHEDULER *const sched);
+
+
+#endif /* SCHEDULER_MODULE_SCHEDULER_H_ */
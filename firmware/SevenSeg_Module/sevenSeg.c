@@ -4,10 +4,16 @@
 
 
 //########## DEPENDENCIES ##########//
-#include <msp430.h>
+#include "hal.h"
 #include "sevenSeg.h"
 
 
+//########## PRIVATE GLOBALS ##########//
+// a 1-dimensional lookup table for binary segment codes based on a 0x0 to 0xF hex digit input, or a 0x10 OFF_CODE and 0x11 DASH_CODE;
+// hexToSevSeg indexes it directly, and SevSegToHex searches it for the reverse conversion
+static const unsigned char segCodeTable[NUM_SEG_CODES] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71, 0x00, 0x40};
+
+
 //########## FUNCTION DEFINITIONS ##########//
 
 /************************************************************************************
@@ -29,20 +35,17 @@
 *
 * Author:       Mason Kury
 * Date:         November 9, 2022
-* Modified:     December 2, 2022
+* Modified:     October 14, 2026
 ************************************************************************************/
 unsigned char hexToSevSeg(SEVEN_SEG_DISP *const display)
 {
-    // a 1-dimensional lookup table for binary segment codes based on a 0x0 to 0xF hex digit input, or a 0x10 OFF_CODE
-    static const unsigned char segCodeTable[0x12] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71, 0x00, 0x40};
-
     unsigned char convFail = 0;
 
     // begin by storing the decimal place bit in the segment code if the dp member is set
     (display->nextBinSegCode) = (display->dp) ? BIT7 : 0x00;
 
     // if hexDigit is valid, append the segment code for the hex digit
-    if ((display->hexDigit) < 0x12)
+    if ((display->hexDigit) < NUM_SEG_CODES)
         (display->nextBinSegCode) |= segCodeTable[display->hexDigit];
     else
         convFail = 1;
@@ -60,9 +63,13 @@ unsigned char hexToSevSeg(SEVEN_SEG_DISP *const display)
 *
 * Description:
 *   Attempts to convert the binary code currently displayed on a 7seg display back
-*   into a hexadecimal digit (or the OFF_CODE). If successful, the hex digit is
-*   stored in the display object's hexDigit member, and the decimal point state is
-*   stored in the dp member.
+*   into a hexadecimal digit (or the OFF_CODE/DASH_CODE). If successful, the hex
+*   digit is stored in the display object's hexDigit member, and the decimal point
+*   state is stored in the dp member.
+*
+*   The active-low inversion and decimal point extraction are done without
+*   branching, and the segment bits are then matched by searching the same
+*   segCodeTable used by hexToSevSeg, so both conversions always agree.
 *
 * Arguments:
 *   *display    -   pointer to the 7seg display object
@@ -73,81 +80,135 @@ unsigned char hexToSevSeg(SEVEN_SEG_DISP *const display)
 *
 * Author:       Mason Kury
 * Date:         November 9, 2022
-* Modified:     December 2, 2022
+* Modified:     October 14, 2026
 ************************************************************************************/
 unsigned char SevSegToHex(SEVEN_SEG_DISP *const display)
 {
-    unsigned char convFail = 0;
-    unsigned char sevSegCode; // code for current 7seg state excluding decimal, and inverted for 1=ON/0=OFF within code
+    unsigned char convFail = 1;
+    unsigned char sevSegCode;   // code for current 7seg state, inverted for 1=ON/0=OFF within code
+    unsigned char codeIndex;
 
-    // store only bits corresponding to segments (no dp) and invert code if display is common anode/active-low
-    sevSegCode = (display->currBinSegCode) & 0x7F;
-    sevSegCode = (display->activeLow) ? ~sevSegCode : sevSegCode;
+    // invert the whole code for a common anode/active-low display (0xFF mask), or leave it as-is (0x00 mask), before splitting off the dp
+    sevSegCode = (display->currBinSegCode) ^ (unsigned char)(-((display->activeLow) != 0));
 
-    // attempt to find a hex digit (or OFF code) match to the currently output binary code
-    switch (sevSegCode)
+    // attempt to find a hex digit (or OFF/DASH code) match to the segments (no dp) currently being output
+    for (codeIndex = 0; codeIndex < NUM_SEG_CODES; codeIndex++)
     {
-    case 0x3F: // 0011 1111
-        display->hexDigit = 0x0;
-        break;
-    case 0x06: // 0000 0110
-        display->hexDigit = 0x1;
-        break;
-    case 0x5B: // 0101 1011
-        display->hexDigit = 0x2;
-        break;
-    case 0x4F: // 0100 1111
-        display->hexDigit = 0x3;
-        break;
-    case 0x66: // 0110 0110
-        display->hexDigit = 0x4;
-        break;
-    case 0x6D: // 0110 1101
-        display->hexDigit = 0x5;
-        break;
-    case 0x7D: // 0111 1101
-        display->hexDigit = 0x6;
-        break;
-    case 0x07: // 0000 0111
-        display->hexDigit = 0x7;
-        break;
-    case 0x7F: // 0111 1111
-        display->hexDigit = 0x8;
-        break;
-    case 0x6F: // 0110 1111
-        display->hexDigit = 0x9;
-        break;
-    case 0x77: // 0111 0111
-        display->hexDigit = 0XA;
-        break;
-    case 0x7C: // 0111 1100
-        display->hexDigit = 0xB;
-        break;
-    case 0x39: // 0011 1001
-        display->hexDigit = 0xC;
-        break;
-    case 0x5E: // 0101 1110
-        display->hexDigit = 0xD;
-        break;
-    case 0x79: // 0111 1001
-        display->hexDigit = 0xE;
-        break;
-    case 0x71: // 0111 0001
-        display->hexDigit = 0xF;
-        break;
-    case 0x00: // OFF
-        display->hexDigit = OFF_CODE;
-        break;
-    case 0x40: // DASH
-        display->hexDigit = DASH_CODE;
-    default:
-        convFail = 1;
-        break;
+        if (segCodeTable[codeIndex] == (sevSegCode & 0x7F))
+        {
+            display->hexDigit = codeIndex;
+            display->dp = sevSegCode >> 7;
+            convFail = 0;
+            break;
+        }
     }
 
-    // only store the decimal place state if a hex digit or code was successfully recognized from the display above
-    if (!convFail)
-        display->dp = ((display->currBinSegCode) & BIT7) ? 1 : 0;
-
     return convFail;
 }
+
+
+/************************************************************************************
+* Function: sevSegArrCode
+*
+* Description:
+*   Converts the packed hex digit and decimal point of one display in a packed
+*   display array into binary segment code, in the format <BIT7:BIT0>
+*   {dp, G, F, E, D, C, B, A}. The code is inverted if the array is active-low.
+*   As with hexToSevSeg, an invalid hex digit converts to the decimal point alone.
+*
+*   Nothing is stored in the array; see sevSegArrRender to convert every display
+*   into the back frame at once.
+*
+* Arguments:
+*   *dispArr    -   pointer to the packed 7seg display array
+*   dispIndex   -   index of the display within the array
+*
+* Returns:
+*   unsigned char binSegCode; the segment code the display should be showing
+*
+* Date:         October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char sevSegArrCode(const SEVEN_SEG_ARR *const dispArr, const unsigned char dispIndex)
+{
+    unsigned char packed = dispArr->digits[dispIndex];
+    unsigned char binSegCode = packed & SEVSEG_DP_BIT;  // the dp bit of a packed display byte is already in its segment code position
+
+    if (SEVSEG_DIGIT(packed) < NUM_SEG_CODES)
+        binSegCode |= segCodeTable[SEVSEG_DIGIT(packed)];
+
+    // automatically invert binary code for an active-low common anode display
+    if (dispArr->activeLow)
+        binSegCode = ~binSegCode;
+
+    return binSegCode;
+}
+
+
+/************************************************************************************
+* Function: sevSegArrRender
+*
+* Description:
+*   Converts the packed hex digit and decimal point of each display in a packed
+*   display array with sevSegArrCode, and stores the codes in the array's back
+*   frame. The front frame is left alone, so the displays can keep showing it while
+*   the client overlays the back frame and writes it out.
+*
+* Arguments:
+*   *dispArr    -   pointer to the packed 7seg display array
+*   numDisps    -   number of displays to convert (must not be greater than SEVSEG_ARR_LEN)
+*
+* Returns:
+*   (none)
+*
+* Date:         October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void sevSegArrRender(SEVEN_SEG_ARR *const dispArr, const unsigned char numDisps)
+{
+    unsigned char *const backFrame = SEVSEG_BACK(dispArr);
+    unsigned char dispIndex;
+
+    for (dispIndex = 0; dispIndex < numDisps; dispIndex++)
+        backFrame[dispIndex] = sevSegArrCode(dispArr, dispIndex);
+}
+
+
+/************************************************************************************
+* Function: sevSegArrDirtyMask
+*
+* Description:
+*   Compares the back frame of a packed display array against its front frame. The
+*   returned mask has bit n set if display n needs to be written before the frames
+*   are swapped with SEVSEG_SWAP.
+*
+*   This function does not modify the array.
+*
+* Arguments:
+*   *dispArr    -   pointer to the packed 7seg display array
+*   numDisps    -   number of displays to check (must not be greater than SEVSEG_ARR_LEN)
+*
+* Returns:
+*   unsigned char dirtyMask; bit n is set if display n has changed
+*
+* Date:         October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char sevSegArrDirtyMask(const SEVEN_SEG_ARR *const dispArr, const unsigned char numDisps)
+{
+    const unsigned char *const frontFrame = SEVSEG_FRONT(dispArr);
+    const unsigned char *const backFrame = SEVSEG_BACK(dispArr);
+    unsigned char dirtyMask = 0x00;
+    unsigned char dispBit = BIT0;   // bit within dirtyMask representing the current display
+    unsigned char dispIndex;
+
+    for (dispIndex = 0; dispIndex < numDisps; dispIndex++)
+    {
+        if (backFrame[dispIndex] != frontFrame[dispIndex])
+            dirtyMask |= dispBit;
+
+        dispBit <<= 1;
+    }
+
+    return dirtyMask;
+}
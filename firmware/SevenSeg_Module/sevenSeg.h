@@ -18,6 +18,17 @@
 * member matches what is displayed, and need a convenient way to read the display
 * contents in hex.
 *
+* Where RAM is tight, a SEVEN_SEG_ARR can be used in place of an array of display
+* objects. It shares one activeLow member across every display, packs each display's
+* hex digit and decimal point into a single byte (see SEVSEG_PACK), and keeps its
+* segment codes in two frames: the FRONT frame holds the codes currently being
+* displayed, and the BACK frame holds the next frame being composed. The client has
+* sevSegArrRender convert every packed digit into the back frame, overlays anything
+* else it needs to onto the back frame, writes the displays that sevSegArrDirtyMask
+* reports as differing from the front frame, then swaps the frames with SEVSEG_SWAP.
+* The swap only toggles an index, so it is atomic, and a frame is either shown in
+* full or not at all. An array of 8 displays then takes 26 bytes rather than 40.
+*
 * Please note: this module does not contain any functionality to write to an actual
 * seven segment display; it is anticipated that the binary segment code will be
 * accessed externally from this module and written to the display there.
@@ -26,7 +37,7 @@
 *
 * Author:       Mason Kury
 * Created:      November 9, 2022
-* Modified:     December 2, 2022
+* Modified:     October 14, 2026
 ************************************************************************************/
 
 #ifndef SEVENSEG_MODULE_SEVENSEG_H_
@@ -38,6 +49,22 @@
 // DO NOT CHANGE THESE VALUES; A LOOKUP TABLE IS USED TO DECODE HEX TO SEGMENT CODE, WHICH DEPENDS ON THESE AS INDEXES
 #define OFF_CODE            0x10    // represents a blank/OFF display
 #define DASH_CODE           0x11    // represents a dash across the middle of the display (segment G)
+#define NUM_SEG_CODES       0x12    // number of entries in the segment code lookup table (hex digits 0x0 to 0xF, then OFF_CODE and DASH_CODE)
+
+// packed display array constants; a packed display byte <BIT7:BIT0> is {dp, 0, 0, hexDigit[4:0]}, as OFF_CODE and DASH_CODE need 5 bits
+#define SEVSEG_ARR_LEN      8       // number of displays held by a SEVEN_SEG_ARR (dirty masks are 8 bits wide, so this must not be greater than 8)
+#define SEVSEG_DIGIT_MASK   0x1F    // bits of a packed display byte holding the hex digit (or OFF_CODE/DASH_CODE)
+#define SEVSEG_DP_BIT       0x80    // bit of a packed display byte holding the decimal point state
+
+
+//########## MACROS ##########//
+#define SEVSEG_PACK(hexDigit, dp)   (((hexDigit) & SEVSEG_DIGIT_MASK) | ((dp) ? SEVSEG_DP_BIT : 0x00))    // evaluates as a packed display byte
+#define SEVSEG_DIGIT(packed)        ((packed) & SEVSEG_DIGIT_MASK)                                      // evaluates as the hex digit of a packed display byte
+#define SEVSEG_DP(packed)           (((packed) & SEVSEG_DP_BIT) ? 1 : 0)                                 // evaluates as the decimal point state of a packed display byte
+
+#define SEVSEG_FRONT(dispArr)       ((dispArr)->segFrames[(dispArr)->frontFrame])        // evaluates as a packed display array's front frame (segment codes being displayed)
+#define SEVSEG_BACK(dispArr)        ((dispArr)->segFrames[(dispArr)->frontFrame ^ 1])    // evaluates as a packed display array's back frame (segment codes being composed)
+#define SEVSEG_SWAP(dispArr)        ((dispArr)->frontFrame ^= 1)                         // makes the back frame the front frame, once it has been written to the displays
 
 
 //########## STRUCTURES ##########//
@@ -52,6 +79,15 @@ typedef struct SEVEN_SEG_DISP
 }
 SEVEN_SEG_DISP;
 
+typedef struct SEVEN_SEG_ARR
+{
+    unsigned char activeLow;                        // boolean with 1=active low / 0=active high, shared by every display in the array
+    unsigned char digits[SEVSEG_ARR_LEN];           // packed hex digit and decimal point state of each display (see SEVSEG_PACK)
+    unsigned char segFrames[2][SEVSEG_ARR_LEN];     // front and back frames of segment codes, in the SEVEN_SEG_DISP binSegCode format (see SEVSEG_FRONT/SEVSEG_BACK)
+    unsigned char frontFrame;                       // index of the front frame (the one CURRENTLY BEING DISPLAYED) within segFrames; 0 or 1
+}
+SEVEN_SEG_ARR;
+
 
 //########## FUNCTION PROTOTYPES ##########//
 
@@ -83,9 +119,9 @@ unsigned char hexToSevSeg(SEVEN_SEG_DISP *const display);
 *
 * Description:
 *   Attempts to convert the binary code currently displayed on a 7seg display back
-*   into a hexadecimal digit (or the OFF_CODE). If successful, the hex digit is
-*   stored in the display object's hexDigit member, and the decimal point state is
-*   stored in the dp member.
+*   into a hexadecimal digit (or the OFF_CODE/DASH_CODE). If successful, the hex
+*   digit is stored in the display object's hexDigit member, and the decimal point
+*   state is stored in the dp member.
 *
 * Arguments:
 *   *display    -   pointer to the 7seg display object
@@ -96,9 +132,76 @@ unsigned char hexToSevSeg(SEVEN_SEG_DISP *const display);
 *
 * Author:       Mason Kury
 * Date:         November 9, 2022
-* Modified:     November 11, 2022
+* Modified:     October 14, 2026
 ************************************************************************************/
 unsigned char SevSegToHex(SEVEN_SEG_DISP *const display);
 
+/************************************************************************************
+* Function: sevSegArrCode
+*
+* Description:
+*   Converts the packed hex digit and decimal point of one display in a packed
+*   display array into binary segment code, in the format <BIT7:BIT0>
+*   {dp, G, F, E, D, C, B, A}. The code is inverted if the array is active-low.
+*   As with hexToSevSeg, an invalid hex digit converts to the decimal point alone.
+*
+*   Nothing is stored in the array; see sevSegArrRender to convert every display
+*   into the back frame at once.
+*
+* Arguments:
+*   *dispArr    -   pointer to the packed 7seg display array
+*   dispIndex   -   index of the display within the array
+*
+* Returns:
+*   unsigned char binSegCode; the segment code the display should be showing
+*
+* Date:         October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char sevSegArrCode(const SEVEN_SEG_ARR *const dispArr, const unsigned char dispIndex);
+
+/************************************************************************************
+* Function: sevSegArrRender
+*
+* Description:
+*   Converts the packed hex digit and decimal point of each display in a packed
+*   display array with sevSegArrCode, and stores the codes in the array's back
+*   frame. The front frame is left alone, so the displays can keep showing it while
+*   the client overlays the back frame and writes it out.
+*
+* Arguments:
+*   *dispArr    -   pointer to the packed 7seg display array
+*   numDisps    -   number of displays to convert (must not be greater than SEVSEG_ARR_LEN)
+*
+* Returns:
+*   (none)
+*
+* Date:         October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void sevSegArrRender(SEVEN_SEG_ARR *const dispArr, const unsigned char numDisps);
+
+/************************************************************************************
+* Function: sevSegArrDirtyMask
+*
+* Description:
+*   Compares the back frame of a packed display array against its front frame. The
+*   returned mask has bit n set if display n needs to be written before the frames
+*   are swapped with SEVSEG_SWAP.
+*
+*   This function does not modify the array.
+*
+* Arguments:
+*   *dispArr    -   pointer to the packed 7seg display array
+*   numDisps    -   number of displays to check (must not be greater than SEVSEG_ARR_LEN)
+*
+* Returns:
+*   unsigned char dirtyMask; bit n is set if display n has changed
+*
+* Date:         October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char sevSegArrDirtyMask(const SEVEN_SEG_ARR *const dispArr, const unsigned char numDisps);
+
 
 #endif /* SEVENSEG_MODULE_SEVENSEG_H_ */
@@ -0,0 +1,226 @@
+/************************************************************************************
+* See header file for general module documentation
+************************************************************************************/
+
+
+//########## DEPENDENCIES ##########//
+#include "hal.h"
+#include "supply.h"
+
+#if (SUPPLY_MONITOR)
+
+
+//########## PRIVATE FUNCTIONS ##########//
+
+// takes a single conversion with the given ADC10CTL0 settings and the ADC10 interrupt disabled, waiting for it to complete, and powers the ADC10 and its reference back down
+static unsigned int supplyConvertRef(const unsigned int ctl0)
+{
+    unsigned int code;
+
+    ADC10CTL1 = SUPPLY_ADC_CTL1;
+    ADC10CTL0 = ctl0;
+    ADC10CTL0 |= ENC | ADC10SC;
+
+    while (!(ADC10CTL0 & ADC10IFG)) HAL_SYNC();
+    code = ADC10MEM;
+
+    ADC10CTL0 &= ~ENC;
+    ADC10CTL0 = 0;
+
+    return code;
+}
+
+// takes a single reading as described in the module header, waiting for it to complete; returns it on the 2.5V reference's scale
+static unsigned int supplyConvert(void)
+{
+    const unsigned int lowCode = supplyConvertRef(SUPPLY_ADC_CTL0_LOW);
+
+    if (lowCode < SUPPLY_MV_TO_LOW_CODE(SUPPLY_RANGE_MV))
+        return SUPPLY_LOW_TO_CODE(lowCode);
+
+    return supplyConvertRef(SUPPLY_ADC_CTL0_HIGH);
+}
+
+
+//########## FUNCTION DEFINITIONS ##########//
+
+/************************************************************************************
+* Function: supplyInit
+*
+* Description:
+*   Takes a single reading (waiting for it to complete), and decides whether the
+*   board is on plug power from it, without any hysteresis. This is used in place
+*   of supplyWaitSettled when the supply is known to be settled already.
+*
+* Arguments:
+*   *supply     -   pointer to the supply monitor object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void supplyInit(SUPPLY_SENSE *const supply)
+{
+    supply->readingReady = 0;
+    supply->lastCode = supplyConvert();
+    supply->onPlug = (supply->lastCode >= SUPPLY_MV_TO_CODE(SUPPLY_PLUG_MV));
+}
+
+/************************************************************************************
+* Function: supplyWaitSettled
+*
+* Description:
+*   Takes a reading every SUPPLY_SETTLE_MS until the supply has settled, as
+*   described in the module header, or until SUPPLY_SETTLE_MAX_MS have passed.
+*   Whether the board is on plug power is then decided from the last reading, as
+*   in supplyInit. This must be called with MCLK at SUPPLY_BOOT_MCLK_HZ.
+*
+* Arguments:
+*   *supply     -   pointer to the supply monitor object
+*
+* Returns:
+*   unsigned char timedOut; 0 if the supply settled, 1 if SUPPLY_SETTLE_MAX_MS
+*   passed first
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char supplyWaitSettled(SUPPLY_SENSE *const supply)
+{
+    unsigned int readingsLeft = SUPPLY_SETTLE_READINGS;
+    unsigned char settledCount = 0;     // readings in a row that have been within tolerance
+    unsigned int prevCode;
+    unsigned int code;
+
+    supplyInit(supply);
+    prevCode = supply->lastCode;
+
+    while (settledCount < SUPPLY_SETTLE_COUNT)
+    {
+        if (!(--readingsLeft))
+            return 1;
+
+        __delay_cycles(SUPPLY_SETTLE_DELAY);
+        code = supplyConvert();
+
+        // a reading only counts if it is high enough, and close enough to the one before; anything else starts the count over
+        if ((code >= SUPPLY_MV_TO_CODE(SUPPLY_SETTLE_MIN_MV)) && (((code > prevCode) ? (code - prevCode) : (prevCode - code)) <= SUPPLY_MV_TO_CODE(SUPPLY_SETTLE_TOL_MV)))
+            settledCount++;
+        else
+            settledCount = 0;
+
+        prevCode = code;
+        supply->lastCode = code;
+        supply->onPlug = (code >= SUPPLY_MV_TO_CODE(SUPPLY_PLUG_MV));
+    }
+
+    return 0;
+}
+
+/************************************************************************************
+* Function: supplyStartReading
+*
+* Description:
+*   Powers up the ADC10 and its reference, and starts a reading with the ADC10
+*   interrupt enabled; the client's ADC10 ISR must call supplyISR to collect it.
+*   Nothing is done if a reading is already in progress.
+*
+* Arguments:
+*   (none)
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void supplyStartReading(void)
+{
+    if (ADC10CTL0 & ENC)
+        return;
+
+    ADC10CTL1 = SUPPLY_ADC_CTL1;
+    ADC10CTL0 = SUPPLY_ADC_CTL0_LOW | ADC10IE;
+    ADC10CTL0 |= ENC | ADC10SC;
+}
+
+/************************************************************************************
+* Function: supplyISR
+*
+* Description:
+*   Collects a reading started by supplyStartReading, and powers the ADC10 and its
+*   reference back down; this should be called by the client's ADC10 ISR. If the
+*   reading against the 1.5V reference is at or above SUPPLY_RANGE_MV, it is
+*   started again against the 2.5V reference instead, and collected by the next
+*   call.
+*
+* Arguments:
+*   *supply     -   pointer to the supply monitor object
+*
+* Returns:
+*   unsigned char noReading; 0 if a reading was collected (so the main loop should
+*   be woken to handle it), 1 if it was started again against the 2.5V reference
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char supplyISR(SUPPLY_SENSE *const supply)
+{
+    const unsigned int code = ADC10MEM;
+
+    // ENC must be cleared before the rest of ADC10CTL0 can be changed
+    ADC10CTL0 &= ~ENC;
+
+    if (ADC10CTL0 & REF2_5V)
+        supply->lastCode = code;
+    else if (code < SUPPLY_MV_TO_LOW_CODE(SUPPLY_RANGE_MV))
+        supply->lastCode = SUPPLY_LOW_TO_CODE(code);
+    else
+    {
+        // VCC is high enough for the 2.5V reference; the reading is only collected once that conversion is done
+        ADC10CTL0 = SUPPLY_ADC_CTL0_HIGH | ADC10IE;
+        ADC10CTL0 |= ENC | ADC10SC;
+        return 1;
+    }
+
+    supply->readingReady = 1;
+    ADC10CTL0 = 0;
+
+    return 0;
+}
+
+/************************************************************************************
+* Function: supplyUpdate
+*
+* Description:
+*   Handles the reading collected by supplyISR, deciding again whether the board is
+*   on plug power (see SUPPLY_PLUG_MV and SUPPLY_HYST_MV).
+*
+* Arguments:
+*   *supply     -   pointer to the supply monitor object
+*
+* Returns:
+*   unsigned char unchanged; 0 if the board has moved to or from plug power,
+*   otherwise 1
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char supplyUpdate(SUPPLY_SENSE *const supply)
+{
+    const unsigned char wasOnPlug = supply->onPlug;
+
+    supply->readingReady = 0;
+
+    if (wasOnPlug)
+        supply->onPlug = (supply->lastCode >= SUPPLY_MV_TO_CODE(SUPPLY_PLUG_MV - SUPPLY_HYST_MV));
+    else
+        supply->onPlug = (supply->lastCode >= SUPPLY_MV_TO_CODE(SUPPLY_PLUG_MV));
+
+    return (supply->onPlug == wasOnPlug);
+}
+
+
+#endif /* SUPPLY_MONITOR */
@@ -0,0 +1,204 @@
+/************************************************************************************
+* Supply Monitor Module
+*
+* Contains a sampler for the board's supply rail, using the ADC10's (VCC - VSS)/2
+* channel against its internal references, so VCC can be read without any external
+* parts. The ADC10 and its reference are only powered for each reading, and run
+* from ADC10OSC, so readings can be taken in LPM3.
+*
+* The 2.5V reference is only specified for VCC >= 2.9V, which rules it out for a
+* battery, so every reading is first taken against the 1.5V reference (specified
+* down to 2.2V), which reads VCC up to 3V. Only if that reading is at or above
+* SUPPLY_RANGE_MV is it taken again against the 2.5V reference (reading VCC up to
+* 5V), so a plug supply can still be told apart. Either way, the reading is kept on
+* the 2.5V reference's scale (see SUPPLY_MV_TO_CODE).
+*
+* supplyWaitSettled is used at boot in place of a fixed delay, to ride out AC power
+* transients: it takes a reading every SUPPLY_SETTLE_MS, and returns as soon as
+* SUPPLY_SETTLE_COUNT readings in a row are above SUPPLY_SETTLE_MIN_MV and within
+* SUPPLY_SETTLE_TOL_MV of the one before, or after SUPPLY_SETTLE_MAX_MS regardless.
+*
+* In the background, the client starts a reading with supplyStartReading (from a
+* timer ISR, at a low duty cycle), and calls supplyISR from its ADC10 ISR to collect
+* it. The main loop then calls supplyUpdate, which decides whether the board is on
+* plug power (a regulated supply at or above SUPPLY_PLUG_MV) or on battery, with
+* SUPPLY_HYST_MV of hysteresis so a supply near the threshold doesn't flicker.
+*
+* Please note: the reference needs up to 30us to settle once it is turned on (or
+* switched to 2.5V); the sample time (64 ADC10CLK periods of ADC10OSC / 4, about
+* 50us) covers this, so each conversion is started right away. Readings are only
+* trustworthy down to the 1.5V reference's 2.2V minimum VCC (and the MSP430's own
+* 1.8V minimum); SUPPLY_SETTLE_MIN_MV is well above this.
+*
+* Setting SUPPLY_MONITOR to 0 leaves the module's functions out of the build.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+
+#ifndef SUPPLY_MODULE_SUPPLY_H_
+#define SUPPLY_MODULE_SUPPLY_H_
+
+
+//########## SYMBOLIC CONSTANTS ##########//
+
+// user-defined constants
+#define SUPPLY_MONITOR          0           // set to 1 to wait for the supply to settle at boot and measure it in the background; 0 to leave the module out entirely
+#define SUPPLY_BOOT_MCLK_HZ     1100000UL   // MCLK frequency while supplyWaitSettled runs (the power-up DCO, as the clocks are only raised once the supply has settled)
+#define SUPPLY_SETTLE_MS        10          // time between readings while waiting for the supply to settle, in milliseconds
+#define SUPPLY_SETTLE_COUNT     8           // readings in a row within SUPPLY_SETTLE_TOL_MV of the one before that count as a settled supply
+#define SUPPLY_SETTLE_TOL_MV    40          // largest change between readings of a settled supply, in millivolts
+#define SUPPLY_SETTLE_MIN_MV    2700        // readings below this never count towards a settled supply, in millivolts
+#define SUPPLY_SETTLE_MAX_MS    2000        // longest time to wait for the supply to settle before continuing anyway, in milliseconds
+#define SUPPLY_PLUG_MV          3150        // VCC at or above which the board is taken to be on plug power (regulated 3.3V), in millivolts
+#define SUPPLY_HYST_MV          100         // how far VCC must fall below SUPPLY_PLUG_MV before the board is taken to be on battery, in millivolts
+#define SUPPLY_RANGE_MV         2950        // VCC at or above which a reading is taken again against the 2.5V reference, in millivolts (from 2900 to below 3000)
+
+// ADC10 settings for a reading
+#define SUPPLY_ADC_CTL0_LOW     (SREF_1 | ADC10SHT_3 | REFON | ADC10ON)            // VREF+ = 1.5V reference, 64 ADC10CLK sample time
+#define SUPPLY_ADC_CTL0_HIGH    (SREF_1 | ADC10SHT_3 | REFON | REF2_5V | ADC10ON)  // VREF+ = 2.5V reference, 64 ADC10CLK sample time
+#define SUPPLY_ADC_CTL1         (INCH_11 | ADC10DIV_3 | ADC10SSEL_0)              // (VCC - VSS)/2 channel, from ADC10OSC / 4
+
+#if (SUPPLY_RANGE_MV < 2900) || (SUPPLY_RANGE_MV >= 3000)
+#error "SUPPLY_RANGE_MV must be within the 2.5V reference's VCC range (2900mV and up), and below the 1.5V reference's full scale (3000mV)"
+#endif
+
+// derived constants
+#define SUPPLY_SETTLE_DELAY     ((SUPPLY_SETTLE_MS * SUPPLY_BOOT_MCLK_HZ) / 1000UL)    // number of MCLK cycles between readings while waiting for the supply to settle
+#define SUPPLY_SETTLE_READINGS  (SUPPLY_SETTLE_MAX_MS / SUPPLY_SETTLE_MS)               // most readings taken while waiting for the supply to settle
+
+
+//########## PREPROCESSOR MACROS ##########//
+
+// converts a supply voltage in millivolts to the ADC10 reading of it (VCC/2 against 2.5V, so 5V full scale); every kept reading is on this scale
+#define SUPPLY_MV_TO_CODE(mv)       ((unsigned int)(((mv) * 1023UL) / 5000UL))
+
+// converts a supply voltage in millivolts to the ADC10 reading of it against the 1.5V reference (so 3V full scale)
+#define SUPPLY_MV_TO_LOW_CODE(mv)   ((unsigned int)(((mv) * 1023UL) / 3000UL))
+
+// converts a reading against the 1.5V reference to the 2.5V reference's scale
+#define SUPPLY_LOW_TO_CODE(code)    ((unsigned int)(((code) * 3U) / 5U))
+
+// evaluates as nonzero if a background reading has been collected by supplyISR, but not yet handled by supplyUpdate (for checking before entering a low power mode)
+#define SUPPLY_READING_READY(supply)    ((supply)->readingReady)
+
+
+//########## STRUCTURES ##########//
+
+// state of a supply monitor; readingReady is only set by supplyISR, and only cleared by supplyUpdate
+typedef struct SUPPLY_SENSE
+{
+    volatile unsigned int lastCode;         // latest reading (see SUPPLY_MV_TO_CODE)
+    volatile unsigned char readingReady;    // set once a background reading has been collected
+    unsigned char onPlug;                   // nonzero while the board is taken to be on plug power, 0 while on battery
+}
+SUPPLY_SENSE;
+
+
+//########## FUNCTION PROTOTYPES ##########//
+#if (SUPPLY_MONITOR)
+
+/************************************************************************************
+* Function: supplyInit
+*
+* Description:
+*   Takes a single reading (waiting for it to complete), and decides whether the
+*   board is on plug power from it, without any hysteresis. This is used in place
+*   of supplyWaitSettled when the supply is known to be settled already.
+*
+* Arguments:
+*   *supply     -   pointer to the supply monitor object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void supplyInit(SUPPLY_SENSE *const supply);
+
+/************************************************************************************
+* Function: supplyWaitSettled
+*
+* Description:
+*   Takes a reading every SUPPLY_SETTLE_MS until the supply has settled, as
+*   described in the module header, or until SUPPLY_SETTLE_MAX_MS have passed.
+*   Whether the board is on plug power is then decided from the last reading, as
+*   in supplyInit. This must be called with MCLK at SUPPLY_BOOT_MCLK_HZ.
+*
+* Arguments:
+*   *supply     -   pointer to the supply monitor object
+*
+* Returns:
+*   unsigned char timedOut; 0 if the supply settled, 1 if SUPPLY_SETTLE_MAX_MS
+*   passed first
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char supplyWaitSettled(SUPPLY_SENSE *const supply);
+
+/************************************************************************************
+* Function: supplyStartReading
+*
+* Description:
+*   Powers up the ADC10 and its reference, and starts a reading with the ADC10
+*   interrupt enabled; the client's ADC10 ISR must call supplyISR to collect it.
+*   Nothing is done if a reading is already in progress.
+*
+* Arguments:
+*   (none)
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void supplyStartReading(void);
+
+/************************************************************************************
+* Function: supplyISR
+*
+* Description:
+*   Collects a reading started by supplyStartReading, and powers the ADC10 and its
+*   reference back down; this should be called by the client's ADC10 ISR. If the
+*   reading against the 1.5V reference is at or above SUPPLY_RANGE_MV, it is
+*   started again against the 2.5V reference instead, and collected by the next
+*   call.
+*
+* Arguments:
+*   *supply     -   pointer to the supply monitor object
+*
+* Returns:
+*   unsigned char noReading; 0 if a reading was collected (so the main loop should
+*   be woken to handle it), 1 if it was started again against the 2.5V reference
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char supplyISR(SUPPLY_SENSE *const supply);
+
+/************************************************************************************
+* Function: supplyUpdate
+*
+* Description:
+*   Handles the reading collected by supplyISR, deciding again whether the board is
+*   on plug power (see SUPPLY_PLUG_MV and SUPPLY_HYST_MV).
+*
+* Arguments:
+*   *supply     -   pointer to the supply monitor object
+*
+* Returns:
+*   unsigned char unchanged; 0 if the board has moved to or from plug power,
+*   otherwise 1
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+unsigned char supplyUpdate(SUPPLY_SENSE *const supply);
+
+#endif /* SUPPLY_MONITOR */
+
+
+#endif /* SUPPLY_MODULE_SUPPLY_H_ */
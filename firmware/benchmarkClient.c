@@ -0,0 +1,954 @@
+/************************************************************************************
+* Gemini Interface Control Board -- Hardware Benchmark Client
+* Property of Super Props Inc., all rights reserved
+*
+* Client file to take repeatable performance numbers on a real board, for qualifying
+* new PCB revisions and keypad variants (such as the PAUSE_STOP_DOWN/PAUSE_STOP_ALT
+* layouts) with numbers instead of a visual check. Timer1_A runs from SMCLK with no
+* division as a cycle counter, extended to 32 bits by its overflow interrupt (see
+* benchNow); Timer0_A runs from ACLK (VLOCLK) for keypad debouncing and timed waits.
+*
+* If INFOB does not hold a saved run, the benchmark is started right away after
+* boot; otherwise, the saved report is shown, and pressing the power button starts
+* a new run. The tests are run in this order:
+*   FRAME:
+*       For each of the main client's transmit paths, BENCH_FRAMES full frames (a
+*       byte for each display register and the LED shift register) are written:
+*           0   blocking spiA0PutChar, each byte on its own chip select
+*           1   usciXNSpiTxBurst, each byte on its own chip select
+*           2   the SPI_ASYNC_QUEUE transmit queue, each byte on its own chip
+*               select, timed until the queue has drained (only if SPI_ASYNC_QUEUE
+*               is enabled in "spi.h"; otherwise, the rate is left at 0)
+*           3   the DISP_DAISY_CHAIN frame: one spiA0TxBurst of every byte, with a
+*               single chip select held for the whole burst (the LED shift
+*               register's, which is left holding the last byte)
+*       The fastest frame of each path gives its maximum full-frame refresh rate.
+*       Every frame is blank, so it does not matter how the registers are wired.
+*   KEYS:
+*       The displays show "--------" until the first key is pressed. Every key
+*       press is then measured until the power button is pressed: the debounce scan
+*       that queued the press is timed in MCLK cycles (the longest is kept for each
+*       key coordinate), and the time from the row interrupt to the main loop
+*       collecting the press event is timed in microseconds. The top row shows the
+*       coordinate of the last key pressed, and the bottom row its latency. Each
+*       key of the keypad variant should be pressed at least once; presses made
+*       while another key is held have no row interrupt, so only their scan is timed.
+*   IDLE:
+*       Three windows of BENCH_IDLE_MS, for measuring supply current with a meter:
+*       the CPU spinning (E0), LPM0 (E1), and LPM3 (E2). Each window's tag is shown
+*       for BENCH_TAG_MS first; the displays and LEDs are then turned off for the
+*       window itself. VLOCLK is measured against MCLK during the first window, as
+*       every window (and the keypad debounce) is timed from it.
+*
+* The results are then saved to INFOB (see BENCH_RESULTS), and the report is scrolled
+* across all 8 displays, one digit every BENCH_SCROLL_MS, as read back from INFOB.
+* Each record takes 8 digits: a 2-digit tag, a dash, a 4-digit hex value, and a blank:
+*       F0 to F3    maximum full-frame refresh rate of transmit path 0 to 3, in frames/s
+*       40 to 73    longest debounce scan for the key at that coordinate, in MCLK
+*                   cycles (only for keys that were pressed)
+*       A0, A1, A2  minimum, average, and maximum press latency, in microseconds
+*       B0          measured VLOCLK frequency, in Hz
+*
+* This client is built in place of the main client, by excluding geminiControlClient.c
+* from the build instead of this file (as for the other test clients). It uses the
+* same pins, keypad, and clock settings as the main client.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+
+
+//########## DEPENDENCIES ##########//
+#include "hal.h"
+#include "spi.h"
+#include "sevenSeg.h"
+#include "mtrxKeypad.h"
+
+
+//########## SYMBOLIC CONSTANTS ##########//
+
+// display registers and chip select pins
+#define DISPS_CSDIR             P3DIR
+#define DISPS_CSOUT             P3OUT
+#define DISP0                   BIT0
+#define ALL_DISPS               0xFF
+
+// LED registers and chip select pins
+#define LEDSR_CSDIR             P1DIR
+#define LEDSR_CSOUT             P1OUT
+#define LEDSR                   BIT6
+
+// keypad power button registers and pin (separate from the rest of the keypad)
+#define KEYPAD_PWR_DIR          P1DIR
+#define KEYPAD_PWR_REN          P1REN
+#define KEYPAD_PWR_OUT          P1OUT
+#define KEYPAD_PWR_IN           P1IN
+#define KEYPAD_PWR_IE           P1IE
+#define KEYPAD_PWR_IES          P1IES
+#define KEYPAD_PWR_IFG          P1IFG
+#define KEYPAD_PWR_BTN          BIT0
+
+#define PWRBTN_ISR_VECTOR       PORT1_VECTOR    // keypad power button port vector for interrupts
+#define KEYPAD_ISR_VECTOR       PORT2_VECTOR    // keypad port vector for interrupts (should be interrupt vector for row port)
+
+#define NUM_DISPS               8               // number of displays on the interface (masks are 8 bits wide, so this must not be greater than 8)
+
+// clocks; the calibrated 8MHz DCO is used, as in the main client's default CLK_PROFILE
+#define DCO_DEFAULT_HZ          1100000UL       // typical power-up DCO frequency (RSELx = 7, DCOx = 3)
+#define VLOCLK_HZ               12000UL         // typical VLOCLK frequency (ACLK)
+#define F_CPU                   8000000UL       // MCLK/SMCLK frequency, and the rate of the benchmark timer
+#define SPI_SCLK_MAX_HZ         8000000UL       // fastest SCLK to run the display/LED shift registers at on a 3.3V supply
+#define SPI_SCLK_DIV            ((F_CPU + SPI_SCLK_MAX_HZ - 1) / SPI_SCLK_MAX_HZ)   // smallest SMCLK divisor keeping SCLK within SPI_SCLK_MAX_HZ
+#define STARTUP_DELAY           ((950 * DCO_DEFAULT_HZ) / 1000UL)     // number of MCLK cycles to delay on boot, which is done on the power-up DCO
+
+#define PWR_BTN_PRESS_DELAY     ((90 * F_CPU) / 1000UL)     // number of MCLK cycles to ignore the power button for once it is pressed
+#define PWR_BTN_RELEASE_DELAY   ((270 * F_CPU) / 1000UL)    // number of MCLK cycles to ignore the power button for once it is released
+
+// benchmark settings
+#define BENCH_FRAMES            64              // full frames written through each transmit path; the fastest one is kept
+#define BENCH_NUM_KEYS          16              // key coordinates timed by the key test (columns P2.4 to P2.7, rows P2.0 to P2.3)
+#define BENCH_IDLE_MS           5000            // length of each idle current window, in milliseconds (at most about 5400ms at the typical VLOCLK)
+#define BENCH_TAG_MS            1000            // time each idle window's tag is shown before the window starts, in milliseconds
+#define BENCH_SCROLL_MS         300             // time between each step of the scrolling report, in milliseconds
+#define BENCH_VALID_KEY         0xBE4C          // stored in INFOB once a complete run has been saved (erased flash reads 0xFFFF)
+
+// INFOB flash segment (see lnk_msp430g2353.cmd), and the flash timing generator, which must run at 257kHz to 476kHz
+#define BENCH_INFO_ADDR         0x1080          // start of INFOB; BENCH_RESULTS must fit in its 64 bytes
+#define BENCH_FLASH_HZ          350000UL        // targeted flash timing generator frequency
+#define BENCH_FLASH_DIV         (((F_CPU + BENCH_FLASH_HZ - 1) / BENCH_FLASH_HZ) - 1)  // FN5:0 divider of MCLK for the flash timing generator
+
+// transmit paths timed by the frame test, in the order they are run (see the file header)
+#define BENCH_TX_PUTCHAR        0
+#define BENCH_TX_BURST          1
+#define BENCH_TX_QUEUE          2
+#define BENCH_TX_CHAIN          3
+#define BENCH_TX_PATHS          4
+
+#define BENCH_FRAME_LEN         (NUM_DISPS + 1) // bytes in a full frame: one per display register, then the LED shift register
+
+// report records, in the order they are scrolled; see benchRecord
+#define BENCH_REC_FRAME         0               // BENCH_TX_PATHS records, one per transmit path
+#define BENCH_REC_KEY           (BENCH_REC_FRAME + BENCH_TX_PATHS)      // BENCH_NUM_KEYS records, one per key coordinate
+#define BENCH_REC_LATENCY       (BENCH_REC_KEY + BENCH_NUM_KEYS)        // 3 records: minimum, average, and maximum press latency
+#define BENCH_REC_VLO           (BENCH_REC_LATENCY + 3)
+#define BENCH_NUM_RECS          (BENCH_REC_VLO + 1)
+#define BENCH_REC_DIGITS        8               // digits taken by each record on the scrolling report
+
+
+//########## PREPROCESSOR MACROS ##########//
+
+// converts a number of milliseconds to VLOCLK (ACLK) ticks
+#define MS_TO_ACLK(ms)          ((unsigned int)(((ms) * VLOCLK_HZ) / 1000UL))
+
+// the lower 16 bits of the benchmark timer, for timing anything shorter than 65535 MCLK cycles
+#define BENCH_NOW()             (TA1R)
+
+// converts a key coordinate (column pin in the high nibble, row pin in the low nibble) to its index within BENCH_RESULTS.scanTicks, and back
+#define BENCH_KEY_INDEX(coord)  (((((coord) >> 4) - 4) << 2) | ((coord) & 0x03))
+#define BENCH_KEY_COORD(index)  ((unsigned char)(((((index) >> 2) + 4) << 4) | ((index) & 0x03)))
+#define BENCH_KEY_VALID(coord)  (((coord) >= 0x40) && (((coord) & 0x0F) < 4))
+
+
+//########## STRUCTURES ##########//
+
+// the results of one benchmark run, as saved in INFOB; this must stay within 64 bytes
+typedef struct BENCH_RESULTS
+{
+    unsigned int validKey;                      // BENCH_VALID_KEY once the run has been saved
+    unsigned int frameRates[BENCH_TX_PATHS];    // maximum full-frame refresh rate through each transmit path, in frames/s (0 if not built)
+    unsigned int scanTicks[BENCH_NUM_KEYS];     // longest debounce scan that queued a press of each key, in MCLK cycles; 0 if never pressed
+    unsigned int latencyMin;                    // shortest row interrupt -> press event collected, in microseconds (0xFFFF if no presses were timed)
+    unsigned int latencyAvg;
+    unsigned int latencyMax;
+    unsigned int vloHz;                         // VLOCLK frequency, measured against MCLK
+}
+BENCH_RESULTS;
+
+
+//########## GLOBALS ##########//
+
+// define registers and pin masks for a matrix keypad with row pins PORT2<3:0> and column pins PORT2<7:4>
+static MATRIX_KEYPAD geminiKeypad = {&P2IN, &P2OUT, &P2DIR, &P2SEL, &P2REN, &P2IE, &P2IES, &P2IFG, &P2OUT, &P2DIR, &P2SEL, 0x0F, 0xF0};
+
+// define registers for USCI_A0 on PORT1, with only SOMI and SCLK; this peripheral will run with loopback, as no SOMI is needed
+static const USCIXNSPI USCIA0SPI = {&P1SEL, &P1SEL2, 0x0, BIT2, 0x0, BIT4, &UCA0CTL0, &UCA0CTL1, &UCA0BR0, &UCA0BR1, &UCA0STAT, &UCA0TXBUF, &UCA0RXBUF, &IFG2, UCA0TXIFG, UCA0RXIFG, &IE2, UCA0RXIE};
+
+// the same USCI_A0 registers and keypad pins as constants, as used by the main client
+SPI_DEFINE_INSTANCE(A0, IFG2, UCA0TXIFG, UCA0RXIFG, UCA0STAT, UCA0TXBUF, UCA0RXBUF)
+#if (MTRX_BITMAP_SCAN)
+MTRX_DEFINE_INSTANCE(Gemini, P2IN, P2OUT, 0x0F, 0xF0)
+#endif
+
+#if (SPI_ASYNC_QUEUE)
+static USCIXNSPI_QUEUE benchTxQueue;                // transmit queue timed by the frame test, drained by the USCI_A0 RX interrupt
+#endif
+static const unsigned char benchBlankFrame[BENCH_FRAME_LEN] = {0};  // the frame written by every transmit path
+
+static volatile unsigned int benchTimerHigh = 0;    // upper 16 bits of the benchmark timer, counted by timer1A1ISR
+static volatile unsigned long benchEdgeTime;        // benchNow() at the row interrupt of the press being debounced
+static volatile unsigned char benchEdgeValid = 0;   // set while benchEdgeTime belongs to a press that hasn't been collected yet
+static volatile unsigned int benchScanTicks;        // length of the debounce scan that last queued an event, in MCLK cycles
+static volatile unsigned char benchWaitDone;        // set by timer0A1ISR once benchWait's delay is over
+static volatile unsigned char benchPwrPressed = 0;  // set by pwrbtnPressISR; cleared once the press has been debounced
+
+static BENCH_RESULTS benchRun;                      // results of the run in progress, until they are saved
+#define BENCH_INFO  ((const BENCH_RESULTS *)BENCH_INFO_ADDR)    // the results saved in INFOB
+
+
+//########## FUNCTION PROTOTYPES ##########//
+static void benchFrames(BENCH_RESULTS *const results);
+static void benchTxFrame(const unsigned char txPath);
+static void benchKeys(SEVEN_SEG_ARR *const displayArr, BENCH_RESULTS *const results);
+static void benchIdle(SEVEN_SEG_ARR *const displayArr, BENCH_RESULTS *const results);
+static void benchSave(const BENCH_RESULTS *const results);
+static void benchReport(SEVEN_SEG_ARR *const displayArr, const BENCH_RESULTS *const results);
+static unsigned char benchRecord(const BENCH_RESULTS *const results, const unsigned char record, unsigned int *const value);
+static unsigned long benchNow(void);
+static unsigned char benchWait(const unsigned int aclkTicks, const unsigned short lpmBits);
+static void benchPwrRearm(void);
+static void writeDisps(SEVEN_SEG_ARR *const displayArr, const unsigned char dispMask);
+static void writeHexDigits(SEVEN_SEG_ARR *const displayArr, const unsigned char firstDisp, const unsigned int hexWord, const unsigned char numDigits);
+
+
+//########## MAIN FUNCTION ##########//
+void main(void)
+{
+    SEVEN_SEG_ARR sevSegDispArr;                // packed array of seven segment displays, representing the 8 on the gemini interface
+    unsigned char dispIndex;                    // used to index displays within the array
+    unsigned char runBench;                     // set when a new run should be started, rather than showing the saved report
+
+    WDTCTL = WDTPW | WDTHOLD;   // stop watchdog timer
+
+    // set display and LED SR chip select ports to output, initializing chip selects as inactive
+    DISPS_CSDIR |= ALL_DISPS;
+    LEDSR_CSDIR |= LEDSR;
+    HAL_PIN_CLR(DISPS_CSOUT, ALL_DISPS);
+    HAL_PIN_CLR(LEDSR_CSOUT, LEDSR);
+
+    __delay_cycles(STARTUP_DELAY);  // delay before initializing keypad and other subsystems to avoid interference from AC power transients
+
+    // without valid DCO calibration constants, none of the numbers can be trusted, so stop here
+    if (CALBC1_8MHZ == 0xFF)
+        while (1);
+    DCOCTL = 0;                                 // select the lowest DCOx and MODx settings while changing RSELx, so MCLK can't overshoot
+    BCSCTL1 = CALBC1_8MHZ;
+    DCOCTL = CALDCO_8MHZ;
+    BCSCTL2 = SELM_0 | DIVM_0 | DIVS_0;         // MCLK and SMCLK from the DCO with no division
+
+    // Timer0_A free-runs from ACLK (VLOCLK) for the keypad debounce (CCR0) and benchWait (CCR1); Timer1_A free-runs from SMCLK as the benchmark timer
+    BCSCTL1 &= ~(BIT4 | BIT5 | XTS);            // ensure no ACLK division, and low-frequency mode for LFXT1 to allow for VLOCLK selection
+    BCSCTL3 |= LFXT1S_2;                        // set ACLK source to VLOCLK (12kHz)
+    TA0CCTL0 = 0;
+    TA0CCTL1 = 0;
+    TA0CTL = TASSEL_1 | MC_2 | TACLR;
+    TA1CTL = TASSEL_2 | ID_0 | MC_2 | TACLR | TAIE;
+
+    // displays are active high, and start out blank
+    sevSegDispArr.activeLow = 0;
+    sevSegDispArr.frontFrame = 0;
+    for (dispIndex = 0; dispIndex < NUM_DISPS; dispIndex++)
+        sevSegDispArr.digits[dispIndex] = SEVSEG_PACK(OFF_CODE, 0);
+
+    // init USCI_A0 in master mode, sclkdiv of SPI_SCLK_DIV, sclk active high with capture on first edge, 8-bit mode, MSB first, with loopback
+    usciXNSpiInit(&USCIA0SPI, SPI_MST, SPI_SCLK_DIV, 0x0, SPI_DAT8BIT, SPI_MSB, SPI_LOOPBACK);
+#if (SPI_ASYNC_QUEUE)
+    usciXNSpiQueueInit(&USCIA0SPI, &benchTxQueue);
+#endif
+    writeDisps(&sevSegDispArr, ALL_DISPS);
+    HAL_PIN_SET(LEDSR_CSOUT, LEDSR);
+    spiA0PutChar(0x00);
+    HAL_PIN_CLR(LEDSR_CSOUT, LEDSR);
+
+    mtrxKeypadInit(&geminiKeypad);
+    *(geminiKeypad.ROW_IE) &= ~(geminiKeypad.ROW_PINS);     // the keypad is only listened to during the key test
+
+    // power button is an input with a pullup, interrupting on its H -> L press
+    KEYPAD_PWR_DIR &= ~KEYPAD_PWR_BTN;
+    KEYPAD_PWR_REN |= KEYPAD_PWR_BTN;
+    KEYPAD_PWR_OUT |= KEYPAD_PWR_BTN;
+    KEYPAD_PWR_IES |= KEYPAD_PWR_BTN;
+    KEYPAD_PWR_IFG &= ~KEYPAD_PWR_BTN;
+    KEYPAD_PWR_IE |= KEYPAD_PWR_BTN;
+    __enable_interrupt();
+
+    runBench = (BENCH_INFO->validKey != BENCH_VALID_KEY);
+
+    // MAIN LOOP
+    while (1)
+    {
+        if (runBench)
+        {
+            benchFrames(&benchRun);
+            writeDisps(&sevSegDispArr, ALL_DISPS);     // the frame test left every display blank behind the front frame's back
+            benchKeys(&sevSegDispArr, &benchRun);
+            benchIdle(&sevSegDispArr, &benchRun);
+
+            benchRun.validKey = BENCH_VALID_KEY;
+            benchSave(&benchRun);
+        }
+
+        // the report is shown from INFOB, so what is shown is what was saved; it runs until the power button is pressed
+        benchReport(&sevSegDispArr, BENCH_INFO);
+        benchPwrRearm();
+        runBench = 1;
+    }
+}
+
+
+//########## CLIENT FUNCTIONS ##########//
+
+/************************************************************************************
+* Function: benchFrames
+*
+* Description:
+*   Runs the FRAME test described in the file header: BENCH_FRAMES blank full
+*   frames are written and timed through each transmit path in turn (see
+*   benchTxFrame). The fastest frame of each path is converted to frames per
+*   second (saturating at 0xFFFF). A path that is not built is left at 0.
+*
+* Arguments:
+*   *results    -   pointer to the results of the run in progress
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void benchFrames(BENCH_RESULTS *const results)
+{
+    unsigned char txPath;
+    unsigned char frameIndex;
+    unsigned int frameStart;
+    unsigned int frameTicks;
+    unsigned int bestTicks;
+    unsigned long frameRate;
+
+    for (txPath = 0; txPath < BENCH_TX_PATHS; txPath++)
+    {
+        results->frameRates[txPath] = 0;
+#if !(SPI_ASYNC_QUEUE)
+        if (txPath == BENCH_TX_QUEUE)
+            continue;
+#endif
+
+        bestTicks = 0xFFFF;
+        for (frameIndex = 0; frameIndex < BENCH_FRAMES; frameIndex++)
+        {
+            frameStart = BENCH_NOW();
+            benchTxFrame(txPath);
+
+            // the fastest frame is the one least disturbed by the benchmark timer's overflow interrupt
+            frameTicks = BENCH_NOW() - frameStart;
+            if (frameTicks < bestTicks)
+                bestTicks = frameTicks;
+        }
+
+        frameRate = (bestTicks) ? (F_CPU / bestTicks) : 0xFFFF;
+        results->frameRates[txPath] = (frameRate > 0xFFFF) ? 0xFFFF : (unsigned int)frameRate;
+    }
+}
+
+/************************************************************************************
+* Function: benchTxFrame
+*
+* Description:
+*   Writes benchBlankFrame through the given transmit path, returning once the last
+*   byte has been shifted out and its chip select released. The display registers
+*   get the frame's first NUM_DISPS bytes, lowest display first, and the LED shift
+*   register the last, except on BENCH_TX_CHAIN, where the whole frame is shifted
+*   out on the LED shift register's chip select, as it would be down a chain.
+*
+* Arguments:
+*   txPath      -   the BENCH_TX_ path to write the frame through
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void benchTxFrame(const unsigned char txPath)
+{
+    unsigned char dispBit;
+    unsigned char byteIndex = 0;
+
+    switch (txPath)
+    {
+    case BENCH_TX_PUTCHAR:
+        for (dispBit = DISP0; dispBit; dispBit <<= 1)
+        {
+            HAL_PIN_SET(DISPS_CSOUT, dispBit);
+            spiA0PutChar(benchBlankFrame[byteIndex++]);
+            HAL_PIN_CLR(DISPS_CSOUT, dispBit);
+        }
+        HAL_PIN_SET(LEDSR_CSOUT, LEDSR);
+        spiA0PutChar(benchBlankFrame[byteIndex]);
+        HAL_PIN_CLR(LEDSR_CSOUT, LEDSR);
+        break;
+
+    case BENCH_TX_BURST:
+        for (dispBit = DISP0; dispBit; dispBit <<= 1)
+            usciXNSpiTxBurst(&USCIA0SPI, &benchBlankFrame[byteIndex++], 1, &DISPS_CSOUT, dispBit);
+        usciXNSpiTxBurst(&USCIA0SPI, &benchBlankFrame[byteIndex], 1, &LEDSR_CSOUT, LEDSR);
+        break;
+
+#if (SPI_ASYNC_QUEUE)
+    case BENCH_TX_QUEUE:
+        // as in the main client, a full queue is polled until an entry is freed
+        for (dispBit = DISP0; dispBit; dispBit <<= 1)
+        {
+            while (usciXNSpiEnqueue(&USCIA0SPI, &benchTxQueue, &DISPS_CSOUT, dispBit, benchBlankFrame[byteIndex]))
+                usciXNSpiQueuePoll(&USCIA0SPI, &benchTxQueue);
+            byteIndex++;
+        }
+        while (usciXNSpiEnqueue(&USCIA0SPI, &benchTxQueue, &LEDSR_CSOUT, LEDSR, benchBlankFrame[byteIndex]))
+            usciXNSpiQueuePoll(&USCIA0SPI, &benchTxQueue);
+        usciXNSpiQueueFlush(&USCIA0SPI, &benchTxQueue);
+        break;
+#endif
+
+    case BENCH_TX_CHAIN:
+        spiA0TxBurst(benchBlankFrame, BENCH_FRAME_LEN, &LEDSR_CSOUT, LEDSR);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/************************************************************************************
+* Function: benchKeys
+*
+* Description:
+*   Runs the KEYS test described in the file header, until the power button is
+*   pressed. Keypad interrupts are only enabled for the test, and the main loop
+*   sleeps in LPM0 in between so the benchmark timer keeps counting. The scan and
+*   latency of each press are measured by the keypad ISRs (see benchEdgeTime and
+*   benchScanTicks), and collected here as each press event is popped.
+*
+* Arguments:
+*   *displayArr -   pointer to the packed 7seg display array
+*   *results    -   pointer to the results of the run in progress
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void benchKeys(SEVEN_SEG_ARR *const displayArr, BENCH_RESULTS *const results)
+{
+    MTRX_KEY_EVENT keyEvent;
+    unsigned char keyIndex;
+    unsigned char dispIndex;
+    unsigned long latency;
+    unsigned long latencySum = 0;
+    unsigned int latencyCount = 0;
+
+    for (keyIndex = 0; keyIndex < BENCH_NUM_KEYS; keyIndex++)
+        results->scanTicks[keyIndex] = 0;
+    results->latencyMin = 0xFFFF;
+    results->latencyMax = 0;
+
+    for (dispIndex = 0; dispIndex < NUM_DISPS; dispIndex++)
+        displayArr->digits[dispIndex] = SEVSEG_PACK(DASH_CODE, 0);
+    writeDisps(displayArr, 0x00);
+
+    mtrxKeypadClearEvents(&geminiKeypad);
+    benchEdgeValid = 0;
+    *(geminiKeypad.ROW_IFG) &= ~(geminiKeypad.ROW_PINS);
+    *(geminiKeypad.ROW_IE) |= (geminiKeypad.ROW_PINS);
+
+    while (!benchPwrPressed)
+    {
+        while (!mtrxKeypadPopEvent(&geminiKeypad, &keyEvent))
+        {
+            if (keyEvent.eventType != KEY_EVENT_PRESS)
+                continue;
+
+            // the scan that queued this press; with N-key rollover, a few presses could be queued by one scan, and they all get its time
+            if (BENCH_KEY_VALID(keyEvent.keyCoord))
+            {
+                keyIndex = BENCH_KEY_INDEX(keyEvent.keyCoord);
+                if (benchScanTicks > results->scanTicks[keyIndex])
+                    results->scanTicks[keyIndex] = benchScanTicks;
+            }
+
+            writeHexDigits(displayArr, 0, keyEvent.keyCoord, 2);
+
+            // presses made while another key is held don't have a row interrupt of their own to be timed from
+            __disable_interrupt();
+            latency = (benchEdgeValid) ? (benchNow() - benchEdgeTime) / (F_CPU / 1000000UL) : 0xFFFFFFFF;
+            benchEdgeValid = 0;
+            __enable_interrupt();
+
+            if (latency != 0xFFFFFFFF)
+            {
+                if (latency > 0xFFFF)
+                    latency = 0xFFFF;
+                if (latency < results->latencyMin)
+                    results->latencyMin = latency;
+                if (latency > results->latencyMax)
+                    results->latencyMax = latency;
+                latencySum += latency;
+                latencyCount++;
+
+                writeHexDigits(displayArr, 4, latency, 4);
+            }
+            writeDisps(displayArr, 0x00);
+        }
+
+        __disable_interrupt();
+        if (!benchPwrPressed && !MTRX_KEY_EVENT_PENDING(&geminiKeypad))
+            __bis_SR_register(LPM0_bits | GIE);
+        else
+            __enable_interrupt();
+    }
+
+    // stop listening to the keypad, including any debounce still in progress
+    *(geminiKeypad.ROW_IE) &= ~(geminiKeypad.ROW_PINS);
+    TA0CCTL0 = 0;
+    *(geminiKeypad.ROW_IES) &= ~(geminiKeypad.ROW_PINS);
+    *(geminiKeypad.ROW_IFG) &= ~(geminiKeypad.ROW_PINS);
+    mtrxKeypadClearEvents(&geminiKeypad);
+
+    results->latencyAvg = (latencyCount) ? (unsigned int)(latencySum / latencyCount) : 0;
+
+    benchPwrRearm();
+}
+
+/************************************************************************************
+* Function: benchIdle
+*
+* Description:
+*   Runs the IDLE windows described in the file header. VLOCLK is measured during
+*   the first (active) window, by timing its ACLK ticks with the benchmark timer.
+*   Pressing the power button ends a window early; VLOCLK is then reported as 0.
+*
+* Arguments:
+*   *displayArr -   pointer to the packed 7seg display array
+*   *results    -   pointer to the results of the run in progress
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void benchIdle(SEVEN_SEG_ARR *const displayArr, BENCH_RESULTS *const results)
+{
+    static const unsigned short windowBits[3] = {0, LPM0_bits, LPM3_bits};     // CPU spinning, then LPM0, then LPM3
+    unsigned char window;
+    unsigned char dispIndex;
+    unsigned long windowStart;
+    unsigned long windowTicks;
+
+    results->vloHz = 0;
+
+    for (window = 0; window < 3; window++)
+    {
+        // show the window's tag ("E0" to "E2") first, so the meter reading can be matched to it
+        for (dispIndex = 0; dispIndex < NUM_DISPS; dispIndex++)
+            displayArr->digits[dispIndex] = SEVSEG_PACK(OFF_CODE, 0);
+        displayArr->digits[0] = SEVSEG_PACK(0xE, 0);
+        displayArr->digits[1] = SEVSEG_PACK(window, 0);
+        writeDisps(displayArr, 0x00);
+        benchWait(MS_TO_ACLK(BENCH_TAG_MS), LPM3_bits);
+
+        displayArr->digits[0] = SEVSEG_PACK(OFF_CODE, 0);
+        displayArr->digits[1] = SEVSEG_PACK(OFF_CODE, 0);
+        writeDisps(displayArr, 0x00);
+
+        windowStart = benchNow();
+        if (!benchWait(MS_TO_ACLK(BENCH_IDLE_MS), windowBits[window]) && !window)
+        {
+            // ACLK ticks * (MCLK cycles per ms) / (elapsed MCLK cycles / 1000), kept within 32 bits
+            windowTicks = (benchNow() - windowStart) / 1000UL;
+            if (windowTicks)
+                results->vloHz = (unsigned int)(((unsigned long)MS_TO_ACLK(BENCH_IDLE_MS) * (F_CPU / 1000UL)) / windowTicks);
+        }
+
+        if (benchPwrPressed)
+            benchPwrRearm();
+    }
+}
+
+/************************************************************************************
+* Function: benchSave
+*
+* Description:
+*   Erases INFOB, and writes the given results into it one word at a time.
+*   Interrupts are held off while the flash controller is busy, as flash cannot be
+*   read (including the interrupt vectors) while a segment is being erased. INFOA,
+*   which holds the DCO calibration constants, is left locked.
+*
+* Arguments:
+*   *results    -   pointer to the results to save
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void benchSave(const BENCH_RESULTS *const results)
+{
+    volatile unsigned int *const infoB = (volatile unsigned int *)BENCH_INFO_ADDR;
+    const unsigned int *const resultWords = (const unsigned int *)results;
+    const unsigned short intState = __get_interrupt_state();
+    unsigned char wordIndex;
+
+    __disable_interrupt();
+
+    FCTL2 = FWKEY | FSSEL_1 | BENCH_FLASH_DIV;  // flash timing generator from MCLK
+    FCTL3 = FWKEY;                              // clear LOCK (writing 0 to LOCKA leaves INFOA locked)
+    FCTL1 = FWKEY | ERASE;
+    *infoB = 0;                                 // a dummy write starts the segment erase
+
+    FCTL1 = FWKEY | WRT;
+    for (wordIndex = 0; wordIndex < (sizeof(BENCH_RESULTS) >> 1); wordIndex++)
+        infoB[wordIndex] = resultWords[wordIndex];
+
+    FCTL1 = FWKEY;
+    FCTL3 = FWKEY | LOCK;
+
+    __set_interrupt_state(intState);
+}
+
+/************************************************************************************
+* Function: benchReport
+*
+* Description:
+*   Scrolls the report described in the file header across all 8 displays, one
+*   digit every BENCH_SCROLL_MS, wrapping around after the last record, until the
+*   power button is pressed. The records of keys that were never pressed are
+*   skipped.
+*
+* Arguments:
+*   *displayArr -   pointer to the packed 7seg display array
+*   *results    -   pointer to the results to show (normally those saved in INFOB)
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void benchReport(SEVEN_SEG_ARR *const displayArr, const BENCH_RESULTS *const results)
+{
+    unsigned char records[BENCH_NUM_RECS];      // the records being shown, in order
+    unsigned char numRecords = 0;
+    unsigned char record;
+    unsigned char tag;
+    unsigned int value;
+    unsigned int scrollPos = 0;                 // report digit shown on the first display
+    unsigned int reportPos;
+    unsigned char recordDigit;
+    unsigned char dispIndex;
+
+    for (record = 0; record < BENCH_NUM_RECS; record++)
+    {
+        benchRecord(results, record, &value);
+        if ((record < BENCH_REC_KEY) || (record >= BENCH_REC_LATENCY) || value)
+            records[numRecords++] = record;
+    }
+
+    while (!benchPwrPressed)
+    {
+        for (dispIndex = 0; dispIndex < NUM_DISPS; dispIndex++)
+        {
+            reportPos = scrollPos + dispIndex;
+            if (reportPos >= (numRecords * BENCH_REC_DIGITS))
+                reportPos -= (numRecords * BENCH_REC_DIGITS);
+
+            tag = benchRecord(results, records[reportPos / BENCH_REC_DIGITS], &value);
+            recordDigit = reportPos % BENCH_REC_DIGITS;
+
+            if (recordDigit < 2)
+                displayArr->digits[dispIndex] = SEVSEG_PACK((recordDigit) ? (tag & 0x0F) : (tag >> 4), 0);
+            else if (recordDigit == 2)
+                displayArr->digits[dispIndex] = SEVSEG_PACK(DASH_CODE, 0);
+            else if (recordDigit < 7)
+                displayArr->digits[dispIndex] = SEVSEG_PACK((value >> ((6 - recordDigit) << 2)) & 0x0F, 0);
+            else
+                displayArr->digits[dispIndex] = SEVSEG_PACK(OFF_CODE, 0);
+        }
+        writeDisps(displayArr, 0x00);
+
+        if (++scrollPos >= (numRecords * BENCH_REC_DIGITS))
+            scrollPos = 0;
+
+        benchWait(MS_TO_ACLK(BENCH_SCROLL_MS), LPM3_bits);
+    }
+}
+
+// finds the tag and value of a report record (see the file header); returns the 2-digit tag, and stores the value in *value
+static unsigned char benchRecord(const BENCH_RESULTS *const results, const unsigned char record, unsigned int *const value)
+{
+    unsigned char tag;
+
+    if (record < BENCH_REC_KEY)
+    {
+        tag = 0xF0 | (record - BENCH_REC_FRAME);
+        *value = results->frameRates[record - BENCH_REC_FRAME];
+    }
+    else if (record < BENCH_REC_LATENCY)
+    {
+        tag = BENCH_KEY_COORD(record - BENCH_REC_KEY);
+        *value = results->scanTicks[record - BENCH_REC_KEY];
+    }
+    else if (record < BENCH_REC_VLO)
+    {
+        tag = 0xA0 | (record - BENCH_REC_LATENCY);
+        *value = (&(results->latencyMin))[record - BENCH_REC_LATENCY];
+    }
+    else
+    {
+        tag = 0xB0;
+        *value = results->vloHz;
+    }
+
+    return tag;
+}
+
+/************************************************************************************
+* Function: benchNow
+*
+* Description:
+*   Reads the benchmark timer as a 32-bit count of MCLK cycles, from Timer1_A and
+*   the overflows counted by timer1A1ISR. An overflow that has happened but not yet
+*   been counted (such as while called from an ISR) is accounted for. This can be
+*   called from both ISRs and the main loop.
+*
+* Arguments:
+*   (none)
+*
+* Returns:
+*   unsigned long timestamp; the benchmark timer count, which wraps every 536s at 8MHz
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static unsigned long benchNow(void)
+{
+    const unsigned short intState = __get_interrupt_state();
+    unsigned int low;
+    unsigned int high;
+
+    __disable_interrupt();
+    low = TA1R;
+    high = benchTimerHigh;
+    if ((TA1CTL & TAIFG) && !(low & 0x8000))   // the timer wrapped before low was read, but the overflow hasn't been counted yet
+        high++;
+    __set_interrupt_state(intState);
+
+    return ((unsigned long)high << 16) | low;
+}
+
+/************************************************************************************
+* Function: benchWait
+*
+* Description:
+*   Waits for the given number of ACLK ticks, timed by Timer0_A CCR1, in the given
+*   low power mode (or with the CPU spinning if lpmBits is 0). The wait ends early
+*   if the power button is pressed.
+*
+* Arguments:
+*   aclkTicks   -   ticks to wait for (see MS_TO_ACLK)
+*   lpmBits     -   LPM0_bits or LPM3_bits to sleep in, or 0 to keep the CPU active
+*
+* Returns:
+*   unsigned char interrupted; 0 if the whole delay passed, 1 if it was ended
+*   early by the power button
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static unsigned char benchWait(const unsigned int aclkTicks, const unsigned short lpmBits)
+{
+    benchWaitDone = 0;
+    TA0CCR1 = TA0R + aclkTicks;
+    TA0CCTL1 = CCIE;        // this also clears any stale CCIFG
+
+    while (!benchWaitDone && !benchPwrPressed)
+    {
+        if (lpmBits)
+        {
+            __disable_interrupt();
+            if (!benchWaitDone && !benchPwrPressed)
+                __bis_SR_register(lpmBits | GIE);
+            else
+                __enable_interrupt();
+        }
+        else
+            HAL_SYNC();
+    }
+
+    TA0CCTL1 = 0;
+    return (benchWaitDone) ? 0 : 1;
+}
+
+// debounces a power button press flagged by pwrbtnPressISR, then listens for the next one
+static void benchPwrRearm(void)
+{
+    __delay_cycles(PWR_BTN_PRESS_DELAY);
+    while (!(KEYPAD_PWR_IN & KEYPAD_PWR_BTN)) HAL_SYNC();
+    __delay_cycles(PWR_BTN_RELEASE_DELAY);
+
+    benchPwrPressed = 0;
+    KEYPAD_PWR_IFG &= ~KEYPAD_PWR_BTN;
+    KEYPAD_PWR_IE |= KEYPAD_PWR_BTN;
+}
+
+// renders the packed digits into the back frame, writes every display in dispMask plus every display that changed, then swaps the frames
+static void writeDisps(SEVEN_SEG_ARR *const displayArr, unsigned char dispMask)
+{
+    const unsigned char *backFrame;
+    unsigned char dispIndex;
+    unsigned char dispBit;
+
+    sevSegArrRender(displayArr, NUM_DISPS);
+    backFrame = SEVSEG_BACK(displayArr);
+    dispMask |= sevSegArrDirtyMask(displayArr, NUM_DISPS);
+
+    for (dispIndex = 0, dispBit = DISP0; dispIndex < NUM_DISPS; dispIndex++, dispBit <<= 1)
+    {
+        if (dispMask & dispBit)
+        {
+            HAL_PIN_SET(DISPS_CSOUT, dispBit);
+            spiA0PutChar(backFrame[dispIndex]);
+            HAL_PIN_CLR(DISPS_CSOUT, dispBit);
+        }
+    }
+
+    SEVSEG_SWAP(displayArr);
+}
+
+// stores the lowest numDigits hex digits of hexWord as packed digits, most significant first, starting at display firstDisp (without writing them)
+static void writeHexDigits(SEVEN_SEG_ARR *const displayArr, const unsigned char firstDisp, const unsigned int hexWord, const unsigned char numDigits)
+{
+    unsigned char digitIndex;
+
+    for (digitIndex = 0; digitIndex < numDigits; digitIndex++)
+        displayArr->digits[firstDisp + digitIndex] = SEVSEG_PACK((hexWord >> ((numDigits - 1 - digitIndex) << 2)) & 0xF, 0);
+}
+
+
+//########## INTERRUPT SERVICE ROUTINES ##########//
+#pragma vector = KEYPAD_ISR_VECTOR
+__interrupt void keypadPressISR(void)
+{
+    // ensure one of the row pins triggered the interrupt
+    if (*(geminiKeypad.ROW_IFG) & (geminiKeypad.ROW_PINS))
+    {
+        /* The press latency is timed from the first edge of each press, until the main loop collects its event. An H->L
+         * edge select means this edge is a release (see "mtrxKeypad.h"), which must not restart the timing of the next press. */
+        if (!benchEdgeValid && !(*(geminiKeypad.ROW_IES) & (geminiKeypad.ROW_PINS)))
+        {
+            benchEdgeTime = benchNow();
+            benchEdgeValid = 1;
+        }
+
+        // turn keypad interrupts off until the press has been debounced, exactly as the main client does
+        *(geminiKeypad.ROW_IE) &= ~(geminiKeypad.ROW_PINS);
+        *(geminiKeypad.ROW_IFG) &= ~(geminiKeypad.ROW_PINS);
+#if (MTRX_INTEGRATE_DBNC)
+        TA0CCR0 = TA0R + MTRX_PRESS_DELAY;
+#else
+        TA0CCR0 = TA0R + ((*(geminiKeypad.ROW_IES) & (geminiKeypad.ROW_PINS)) ? RELEASE_DBNC_DELAY : PRESS_DBNC_DELAY);
+#endif
+        TA0CCTL0 = CCIE;    // this also clears any stale CCIFG
+    }
+    else
+    {
+        // if it wasn't a row pin that triggered the interrupt, shut off non-row interrupts and clear flags
+        *(geminiKeypad.ROW_IE) &= (geminiKeypad.ROW_PINS);
+        *(geminiKeypad.ROW_IFG) &= (geminiKeypad.ROW_PINS);
+    }
+}
+
+#pragma vector = PWRBTN_ISR_VECTOR
+__interrupt void pwrbtnPressISR(void)
+{
+    // ensure the power button triggered the interrupt
+    if (KEYPAD_PWR_IFG & KEYPAD_PWR_BTN)
+    {
+        benchPwrPressed = 1;
+        KEYPAD_PWR_IE &= ~KEYPAD_PWR_BTN;       // turn off power button interrupts until debounced by benchPwrRearm
+        KEYPAD_PWR_IFG &= ~KEYPAD_PWR_BTN;
+        __bic_SR_register_on_exit(LPM3_bits);
+    }
+    else
+    {
+        // if it wasn't the power button that triggered the interrupt, shut off non-power button interrupts and clear flags
+        KEYPAD_PWR_IE &= KEYPAD_PWR_BTN;
+        KEYPAD_PWR_IFG &= KEYPAD_PWR_BTN;
+    }
+}
+
+#if (SPI_ASYNC_QUEUE)
+#pragma vector = USCIAB0RX_VECTOR
+__interrupt void usciAB0RxISR(void)
+{
+    // a queued frame byte has finished shifting out; release its chip select and start the next one
+    if (IFG2 & UCA0RXIFG)
+        usciXNSpiQueueISR(&USCIA0SPI, &benchTxQueue);
+}
+#endif
+
+#pragma vector = TIMER0_A0_VECTOR
+__interrupt void timer0A0ISR(void)
+{
+    unsigned int scanStart = BENCH_NOW();
+
+    TA0CCTL0 &= ~CCIE;
+
+    // scan or save the key, timing the scan when it queues an event for the main loop
+#if (MTRX_BITMAP_SCAN)
+    if (!mtrxGeminiDebounce(&geminiKeypad, TA0R))
+#else
+    if (!mtrxKeypadDebounce(&geminiKeypad, TA0R))
+#endif
+    {
+        benchScanTicks = BENCH_NOW() - scanStart;
+        __bic_SR_register_on_exit(LPM3_bits);
+    }
+
+#if (MTRX_BITMAP_SCAN)
+    // while any key is held (or settling), row interrupts stay off, so keep rescanning the matrix to catch further presses and releases
+    if (MTRX_KEYS_HELD(&geminiKeypad))
+    {
+        TA0CCR0 += MTRX_RESCAN_DELAY;
+        TA0CCTL0 = CCIE;
+    }
+#endif
+}
+
+#pragma vector = TIMER0_A1_VECTOR
+__interrupt void timer0A1ISR(void)
+{
+    switch (__even_in_range(TA0IV, TA0IV_TAIFG))
+    {
+    case TA0IV_TACCR1:                          // benchWait's delay is over
+        TA0CCTL1 = 0;
+        benchWaitDone = 1;
+        __bic_SR_register_on_exit(LPM3_bits);
+        break;
+    default:
+        break;
+    }
+}
+
+#pragma vector = TIMER1_A1_VECTOR
+__interrupt void timer1A1ISR(void)
+{
+    switch (__even_in_range(TA1IV, TA1IV_TAIFG))
+    {
+    case TA1IV_TAIFG:                           // the benchmark timer has wrapped around
+        benchTimerHigh++;
+        break;
+    default:
+        break;
+    }
+}
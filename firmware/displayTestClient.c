@@ -29,7 +29,7 @@
 
 
 //########## DEPENDENCIES ##########//
-#include <msp430.h>
+#include "hal.h"
 #include "spi.h"
 #include "sevenSeg.h"
 
@@ -110,7 +110,7 @@ unsigned char writeHexToSevSeg(const USCIXNSPI* usciXN, SEVEN_SEG_DISP* display,
 int main(void)
 {
     // define registers for USCI_A0 on PORT1, with only SOMI and SCLK; this peripheral will run with loopback, as no SOMI is needed
-    const USCIXNSPI USCIA0SPI = {&P1SEL, &P1SEL2, 0x0, BIT2, 0x0, BIT4, &UCA0CTL0, &UCA0CTL1, &UCA0BR0, &UCA0BR1, &UCA0STAT, &UCA0TXBUF, &UCA0RXBUF, &IFG2, UCA0TXIFG, UCA0RXIFG};
+    const USCIXNSPI USCIA0SPI = {&P1SEL, &P1SEL2, 0x0, BIT2, 0x0, BIT4, &UCA0CTL0, &UCA0CTL1, &UCA0BR0, &UCA0BR1, &UCA0STAT, &UCA0TXBUF, &UCA0RXBUF, &IFG2, UCA0TXIFG, UCA0RXIFG, &IE2, UCA0RXIE};
 
     SEVEN_SEG_DISP sevSegDispArr[NUM_DISPS];    // an array of seven segment displays, representing the 8 on the gemini interface
     unsigned char dispIndex;                    // used to index displays within the array
@@ -14,16 +14,18 @@
 *       The "P/C MODE" button can be pressed to cycle through the "CONTROLLER" and
 *       "PUMP" LEDs being lit. The "SEC PIGGY BACK" button can be pressed to toggle
 *       the LED under that button on or off. The "VOLUME INFUSED" button can be pressed
-*       to cycle through the battery indicator and power plug indicator LEDs. The
-*       "CLEAR/SILENCE" button can be pressed to turn off all LEDs and reset the
-*       displays to their initial "-" values.
+*       to cycle through the battery indicator and power plug indicator LEDs (with
+*       SUPPLY_MONITOR, these show the measured supply instead). The "CLEAR/SILENCE"
+*       button can be pressed to turn off all LEDs and reset the displays to their
+*       initial "-" values.
 *
 *       While in the ON state, the RATE button enters the "RATE EDIT" state, the
 *       VTBI button enters the "VTBI EDIT" state, the START button enters the
 *       "PUMP ACTIVE" state, and the "POWER ON" button enters the OFF state.
 *
 *   OFF:
-*       All displays and LEDs are turned off, except for the plug power LED;
+*       All displays and LEDs are turned off, except for the plug power LED (or
+*       the measured power LED, with SUPPLY_MONITOR);
 *       however, their previous values are usually retained so they can be restored
 *       when powering back ON.
 *
@@ -75,17 +77,131 @@
 *       Upon exit from this state by pressing the "PAUSE/STOP" button, both rows will
 *       flash once.
 *
+*   LAMP TEST:
+*       With MTRX_BITMAP_SCAN enabled in "mtrxKeypad.h" (N-key rollover), holding the
+*       "CLEAR/SILENCE" and START buttons together in any ON state lights every display
+*       segment and LED until both are released; nothing else happens for either key.
+*       The previous state resumes afterwards.
+*
+* With MTRX_TYPEMATIC enabled in "mtrxKeypad.h", holding the "100", "10", "1", or "0.1"
+* button in either edit state repeats its increment, faster the longer it is held;
+* releasing it after it has repeated does not increment again.
+*
+* Key releases are dispatched through uiTable, indexed by the UI state (ON, RATE EDIT,
+* VTBI EDIT, or PUMP ACTIVE) and key; each entry gives the next state, an action for
+* runUiTransition to perform, and the display rows to flash afterwards. Changing what
+* a key does in a state means changing its table entry.
+*
+* Timed behaviour outside of keypad debouncing shares the tick scheduler in
+* "scheduler.h", ticking on Timer0_A CCR1 from VLOCLK: display flashing is done in
+* the background (see flashDispRow), so keypad events continue to be handled while
+* rows are flashing, and the power button is debounced without blocking the main
+* loop (see the TASK_ constants below). The tick only runs while a task is armed.
+*
+* With SUPPLY_MONITOR enabled in "supply.h", the fixed startup delay is replaced by
+* supplyWaitSettled, which continues as soon as the supply rail reads steady (or
+* after a timeout). The rail is then read in the background every SUPPLY_SAMPLE_MS,
+* from Timer0_A CCR2, and the battery and plug power LEDs show whichever supply the
+* reading points to; "VOLUME INFUSED" no longer cycles them.
+*
+* With DISP_DIMMING enabled in "dimmer.h", the displays and LEDs are dimmed by
+* blanking them for part of every period, timed by Timer1_A from VLOCLK: whenever
+* the dimmer changes part, the main loop turns everything off with a broadcast
+* write, or relights it from the front frame (see writeDimPhase). Every key event
+* (and turning ON) sets DIM_ACTIVE_LEVEL; after DIM_IDLE_MS without one,
+* DIM_IDLE_LEVEL is set. The period is timed from VLOCLK as measured at boot by
+* dimCalibrate, as it varies too much between parts to be assumed. Timer1_A is the
+* profiler's timer, so LATENCY_PROFILE needs DISP_DIMMING disabled.
+*
+* After the startup delay, MCLK and SMCLK are raised from the power-up DCO to the
+* calibrated frequency selected by CLK_PROFILE (8MHz by default, the fastest the
+* G2x53 is rated for on a battery supply), and every MCLK cycle delay is derived
+* from F_CPU. SCLK is kept at or below SPI_SCLK_MAX_HZ. If the calibration constants
+* for that frequency have been erased, the clocks are left on the power-up DCO and
+* criticalFaultHandler is run with FAULT_CLK_CAL once the displays, LEDs, and power
+* button are set up, as nothing timed from F_CPU could be trusted.
+*
+* With WARM_RESTART enabled, the RATE/VTBI values, LED state, UI state, and power
+* state are kept in a checksummed snapshot in .TI.noinit RAM, saved at the end of
+* every main loop pass (see saveWarmSnapshot). After a watchdog reset (such as the
+* one criticalFaultHandler does) with a valid snapshot, the startup delay is skipped,
+* as the supply never went away, and the interface resumes where it was, writing
+* every display and the LEDs once. Any other reset is a cold boot into the OFF state.
+*
+* Between events, the main loop sleeps in LPM3 (or LPM0 while queued SPI writes are
+* still being shifted out); the power button, debounce timer, and scheduler tick
+* ISRs (and the control link's receive ISR, once a whole command is in, and the
+* dimmer's ISRs, whenever the outputs are to be blanked or relit) wake it up.
+* Debounced key presses and releases are queued in the keypad's event FIFO by the
+* debounce timer ISR, and the main loop handles every queued event each time it wakes.
+*
+* When LATENCY_PROFILE is enabled in "profiler.h" (along with MTRX_EVENT_TIMESTAMPS in
+* "mtrxKeypad.h"), the stages of each keypress are timed in MCLK cycles (see the
+* PROF_STAGE_ constants below), and the main loop only
+* sleeps in LPM0 so the profiler timer keeps running. While in the "PUMP ACTIVE"
+* state, where they normally do nothing, "VOLUME INFUSED" steps through a view of
+* the profile and "CLEAR/SILENCE" clears it:
+*       For each stage in order, the first page shows the min (top row) and max
+*       (bottom row) in hex, and the second page shows the average (top row) and
+*       sample count (bottom row). The stage number is marked by the decimal point
+*       on that display of the top row (first page) or bottom row (second page).
+*       The last two pages show the end-to-end histogram, 2 hex digits per bin
+*       from bin 0 (top left) onward, with every decimal point lit.
+*   Pressing "VOLUME INFUSED" after the last page, or any other key, leaves the view.
+*
+* The displays are double buffered (see SEVEN_SEG_ARR in "sevenSeg.h"). Handling an
+* event only edits the packed digits and the display layers (flashing, lamp test,
+* and COMPUTER CONTROL) and marks the displays for a commit; once per pass of the
+* main loop, flushDisps composes every layer into the back frame, writes only the
+* displays that differ from the front frame, and swaps the frames. Every edit made
+* on one pass goes out together, so the displays never show a half-edited frame,
+* and the LED shift register is written at the same point.
+*
+* The LEDs are composed in layers by the compositor in "ledComp.h": the UI's LED
+* state is the base, with the OFF state, the measured supply, COMPUTER CONTROL, the
+* lamp test, and a critical fault each requesting their LEDs in a layer over it
+* (see the LEDC_LAYER_ constants below). commitLeds writes the effective byte only
+* when it has changed, and blinks the battery LED while ON on battery power (with
+* BATT_LED_BLINK) by toggling the compositor's blink from TASK_LED_BLINK.
+*
+* All SPI writes to the displays and LED shift register go through writeSpiSlave;
+* when SPI_ASYNC_QUEUE is enabled in "spi.h", these writes are queued and shifted
+* out by the USCI_A0 RX interrupt, so the main loop does not block on each byte.
+* For the board revision with the LED shift register on USCI_B0's SIMO and SCLK,
+* LEDSR_USCIB0 gives its writes a queue of their own, drained by the USCI_B0 RX
+* interrupt, so they are shifted out alongside the display writes instead of after.
+* For the board revision with every register cascaded on a single chip select,
+* DISP_DAISY_CHAIN makes them update a 9-byte frame that is shifted out in one burst.
+*
+* When COMPUTER_CONTROL is enabled in "ctrlLink.h", a computer acting as SPI master
+* on USCI_B0 can take over the interface (COMPUTER CONTROL). Every key event is
+* reported to it (see CTRL_KEY_REPORT). The first display/LED frame it sends ends
+* any flash, lamp test, or profile view, and from then on its frames are composed
+* over the front panel's displays and written to the LEDs, while key events are only reported, not
+* handled. CTRL_CMD_RELEASE, or turning the interface OFF, hands the displays and
+* LEDs back to the front panel. USCI_B0 needs P1.5 to P1.7, so on that board
+* revision the LED shift register's chip select (or the frame chip select) is on P1.3.
+*
+* Register access goes through "hal.h", so this file can also be built on a PC
+* against a peripheral model; see "hostBenchClient.c".
+*
 * Author:       Mason Kury
 * Created:      November 30, 2022
-* Modified:     March 27, 2023
+* Modified:     October 14, 2026
 ************************************************************************************/
 
 
 //########## DEPENDENCIES ##########//
-#include <msp430.h>
+#include "hal.h"
 #include "spi.h"
 #include "sevenSeg.h"
 #include "mtrxKeypad.h"
+#include "profiler.h"
+#include "scheduler.h"
+#include "ctrlLink.h"
+#include "supply.h"
+#include "dimmer.h"
+#include "ledComp.h"
 
 
 //########## SYMBOLIC CONSTANTS ##########//
@@ -105,10 +221,34 @@
 #define BOT_DISPS               0xF0
 #define ALL_DISPS               0xFF
 
+/* Board revision with the 8 display registers and the LED shift register cascaded (SIMO -> DISP0 -> ... -> DISP7 -> LED shift register),
+ * sharing one chip select whose falling edge latches every register at once. Every write then shifts out the whole frame in one
+ * burst, and DISPS_CSOUT/DISPn are only used to tell writeSpiSlave which registers a byte is for, leaving PORT3 free. */
+#define DISP_DAISY_CHAIN        0               // set to 1 for the cascaded board revision; 0 for a chip select per register
+#define FRAME_CSDIR             P1DIR
+#define FRAME_CSOUT             P1OUT
+#if (COMPUTER_CONTROL)
+#define FRAME_CS                BIT3            // kept off P1.6, which is USCI_B0's SOMI for the computer control link
+#else
+#define FRAME_CS                BIT6            // the LED shift register's chip select pin on the other revision
+#endif
+#define FRAME_LEN               (NUM_DISPS + 1) // bytes in a frame, in the order they are shifted out (the far end of the chain first)
+#define FRAME_LED               0               // frame index of the LED shift register byte
+#define FRAME_DISP(dispIndex)   (NUM_DISPS - (dispIndex))   // frame index of displayArr[dispIndex]'s byte
+
 // LED registers and chip select pins
 #define LEDSR_CSDIR             P1DIR
 #define LEDSR_CSOUT             P1OUT
+#if (COMPUTER_CONTROL)
+#define LEDSR                   BIT3            // kept off P1.6, which is USCI_B0's SOMI for the computer control link
+#else
 #define LEDSR                   BIT6
+#endif
+
+/* Board revision with the LED shift register's SIMO and SCLK on P1.7 and P1.5 (USCI_B0), instead of sharing USCI_A0 with the
+ * displays; its chip select stays on P1.6, as a plain output (USCI_B0's SOMI is not used). Its writes are then queued separately,
+ * and shifted out at the same time as the display writes. */
+#define LEDSR_USCIB0            0               // set to 1 for the board revision with the LED shift register on USCI_B0; 0 for USCI_A0
 #define LED_CONTROLLER          BIT0
 #define LED_PUMP                BIT1
 #define LED_CC                  BIT2
@@ -133,18 +273,137 @@
 #define KEYPAD_ISR_VECTOR       PORT2_VECTOR    // keypad port vector for interrupts (should be interrupt vector for row port)
 
 // sysState bit definitions
-#define FLAG_KEYPAD_PRESS       BIT0            // indicates a keypress event
+#define FLAG_LAMP_TEST          BIT0            // represents the lamp test being shown while its chord is held (see LAMP_TEST_CHORD)
 #define FLAG_PWR_OFF            BIT1            // represents a power-off state
-#define FLAG_RATE_EDIT          BIT2            // represents a RATE value editing state on the interface
-#define FLAG_VTBI_EDIT          BIT3            // represents a VTBI value editing state on the interface
-#define FLAG_PUMP_ACTIVE        BIT4            // represents an active "pump"
+#define UI_STATE_MASK           (BIT2 | BIT3)   // field holding the UI state (one of the UI_ states below)
+#define FLAG_COMPUTER_CTRL      BIT4            // represents a computer driving the displays and LEDs over the control link (see "ctrlLink.h")
 #define FLAG_RATE_VALUE         BIT5            // represents a user-defined RATE value, rather than the default "----"
 #define FLAG_VTBI_VALUE         BIT6            // represents a user-defined VTBI value, rather than the default "----"
-
-#define PWR_BTN_PRESS_DELAY     100000          // number of MCLK cycles to delay when the power button is pressed
-#define PWR_BTN_RELEASE_DELAY   300000          // number of MCLK cycles to delay when the power button is released
-#define DISP_FLASH_DELAY        262000          // number of MCLK cycles to delay when flashing displays as an indication
-#define STARTUP_DELAY           1048000         // number of MCLK cycles to delay on boot before initializing the main subsystems
+                                                // BIT7 is unused
+
+// scheduler tasks (see "scheduler.h"), run by the main loop once schedPopDue reports them as due; SCHED_NUM_TASKS must match
+#define TASK_DISP_FLASH         0               // runs the next phase of a display flash, every DISP_FLASH_TICKS (see flashDispRow)
+#define TASK_PWR_BTN_RELEASE    1               // polls for the power button's release every tick, once its press has been debounced
+#define TASK_PWR_BTN_REARM      2               // re-enables the power button interrupt, once its release has been debounced
+#define TASK_LED_BLINK          3               // moves the LED blink on to its other phase every LED_BLINK_TICKS, while an LED is blinking (see commitLeds)
+
+// MCLK/SMCLK clock profiles; both clocks are sourced from the DCO, set by initClocks
+#define CLK_PROFILE_DEFAULT     0               // uncalibrated power-up DCO (about 1.1MHz)
+#define CLK_PROFILE_8MHZ        1               // calibrated 8MHz DCO (CALBC1_8MHZ/CALDCO_8MHZ); requires VCC >= 2.7V, so it can run from the battery
+#define CLK_PROFILE_16MHZ       2               // calibrated 16MHz DCO (CALBC1_16MHZ/CALDCO_16MHZ); requires VCC >= 3.3V, so only for boards that never run from the battery
+#define CLK_PROFILE             CLK_PROFILE_8MHZ    // selected clock profile
+
+#define DCO_DEFAULT_HZ          1100000UL       // typical power-up DCO frequency (RSELx = 7, DCOx = 3)
+#define VLOCLK_HZ               12000UL         // typical VLOCLK frequency (ACLK)
+
+#if (CLK_PROFILE == CLK_PROFILE_16MHZ)
+#define F_CPU                   16000000UL      // MCLK/SMCLK frequency; every MCLK cycle delay below is derived from this
+#define CLK_CALBC1              CALBC1_16MHZ
+#define CLK_CALDCO              CALDCO_16MHZ
+#elif (CLK_PROFILE == CLK_PROFILE_8MHZ)
+#define F_CPU                   8000000UL
+#define CLK_CALBC1              CALBC1_8MHZ
+#define CLK_CALDCO              CALDCO_8MHZ
+#else
+#define F_CPU                   DCO_DEFAULT_HZ
+#endif
+
+#define SPI_SCLK_MAX_HZ         8000000UL       // fastest SCLK to run the display/LED shift registers (and their chip select AND gates) at on a 3.3V supply
+#define SPI_SCLK_DIV            ((F_CPU + SPI_SCLK_MAX_HZ - 1) / SPI_SCLK_MAX_HZ)   // smallest SMCLK divisor keeping SCLK within SPI_SCLK_MAX_HZ
+
+#define DISP_FLASH_MS           240             // length of each display flash phase, in milliseconds
+#define LED_BLINK_MS            500             // length of each phase of an LED blink, in milliseconds
+
+#define PWR_BTN_PRESS_MS        90              // time to ignore the power button for once it is pressed, in milliseconds
+#define PWR_BTN_RELEASE_MS      270             // time to ignore the power button for once it is released, in milliseconds
+
+#define FAULT_POLL_MS           10              // longest time between polls of the power button while criticalFaultHandler flashes its message, in milliseconds
+
+#define PWR_BTN_PRESS_DELAY     MS_TO_CYCLES(PWR_BTN_PRESS_MS)          // number of MCLK cycles to delay when the power button is pressed (only used by criticalFaultHandler)
+#define PWR_BTN_RELEASE_DELAY   MS_TO_CYCLES(PWR_BTN_RELEASE_MS)        // number of MCLK cycles to delay when the power button is released (only used by criticalFaultHandler)
+#define PWR_BTN_PRESS_TICKS     SCHED_MS_TO_TICKS(PWR_BTN_PRESS_MS)     // number of scheduler ticks before polling for the power button's release
+#define PWR_BTN_RELEASE_TICKS   SCHED_MS_TO_TICKS(PWR_BTN_RELEASE_MS)   // number of scheduler ticks before re-enabling the power button once released
+#define FAULT_POLL_DELAY        ((FAULT_POLL_MS * DCO_DEFAULT_HZ) / 1000UL)             // number of MCLK cycles between power button polls, sized for the power-up DCO so it is no longer at F_CPU (only used by criticalFaultHandler)
+#define FAULT_FLASH_POLLS       (MS_TO_CYCLES(DISP_FLASH_MS) / FAULT_POLL_DELAY)        // number of power button polls per display flash phase at F_CPU (only used by criticalFaultHandler)
+#define DISP_FLASH_TICKS        SCHED_MS_TO_TICKS(DISP_FLASH_MS)        // number of scheduler ticks between each display flash phase
+#define LED_BLINK_TICKS         SCHED_MS_TO_TICKS(LED_BLINK_MS)         // number of scheduler ticks between each LED blink phase
+#define STARTUP_DELAY           ((950 * DCO_DEFAULT_HZ) / 1000UL)     // number of MCLK cycles to delay on boot, which is done on the power-up DCO before initClocks
+
+// warm restart; see saveWarmSnapshot and loadWarmSnapshot
+#define WARM_RESTART            0               // set to 1 to resume from warmSnapshot after a watchdog reset, skipping the startup delay; 0 to always cold boot
+#define WARM_VALID_KEY          0x3C5A          // stored in warmSnapshot.validKey while it holds a snapshot
+#define WARM_STATE_FLAGS        (FLAG_PWR_OFF | UI_STATE_MASK | FLAG_RATE_VALUE | FLAG_VTBI_VALUE)  // sysState bits kept through a warm restart
+
+// background supply readings (see "supply.h"), started by Timer0_A CCR2
+#define SUPPLY_SAMPLE_MS        1000            // time between background supply readings, in milliseconds (at most about 5400ms at the typical VLOCLK)
+#define SUPPLY_SAMPLE_TICKS     ((unsigned int)((SUPPLY_SAMPLE_MS * VLOCLK_HZ) / 1000UL))  // number of ACLK cycles between background supply readings
+#define SUPPLY_LEDS             (LED_BATTPWR | LED_PLUGPWR)     // LEDs driven by the supply readings instead of the keypad
+#define BATT_LED_BLINK          0               // set to 1 to blink the battery power LED while ON on battery power, as a warning; 0 to keep it lit
+
+// LED compositor layers (see "ledComp.h"), from the lowest precedence up; LEDC_NUM_LAYERS must match
+#define LEDC_LAYER_PWR          0               // the OFF state: only OFF_LEDS are lit
+#define LEDC_LAYER_SUPPLY       1               // the power LEDs show the measured supply (with SUPPLY_MONITOR)
+#define LEDC_LAYER_CTRL         2               // the LEDs the computer last sent under COMPUTER CONTROL
+#define LEDC_LAYER_LAMP         3               // every LED lit for the lamp test
+#define LEDC_LAYER_FAULT        4               // every LED off for a critical fault
+
+// critical fault codes, shown as "E.C.xx" by criticalFaultHandler
+#define FAULT_CLK_CAL           0x01            // the DCO calibration constants for CLK_PROFILE have been erased
+
+// brightness levels (see "dimmer.h"), from 1 to DIM_LEVEL_FULL
+#define DIM_ACTIVE_LEVEL        DIM_LEVEL_FULL  // level set by every key event, and on turning ON
+#define DIM_IDLE_LEVEL          2               // level set after DIM_IDLE_MS without a key event
+
+#if (DISP_DIMMING) && (LATENCY_PROFILE)
+#error "DISP_DIMMING times the blanking with Timer1_A, which LATENCY_PROFILE uses for its timestamps"
+#endif
+#if (LATENCY_PROFILE) && !(MTRX_EVENT_TIMESTAMPS)
+#error "LATENCY_PROFILE times key events from their debounce, so MTRX_EVENT_TIMESTAMPS must be enabled in \"mtrxKeypad.h\""
+#endif
+#if (DISP_DIMMING) && (DIM_MCLK_HZ != F_CPU)
+#error "DIM_MCLK_HZ in \"dimmer.h\" must match F_CPU, which dimCalibrate measures VLOCLK against"
+#endif
+
+#if (LEDSR_USCIB0) && (COMPUTER_CONTROL)
+#error "LEDSR_USCIB0 and COMPUTER_CONTROL both need USCI_B0"
+#endif
+
+#if (LEDSR_USCIB0) && (DISP_DAISY_CHAIN)
+#error "LEDSR_USCIB0 is for a chip select per register; with DISP_DAISY_CHAIN, the LED shift register is at the end of the display chain"
+#endif
+
+#if (LEDSR_USCIB0) && !(SPI_ASYNC_QUEUE)
+#error "LEDSR_USCIB0 only shifts the LED writes out alongside the display writes with SPI_ASYNC_QUEUE enabled in \"spi.h\""
+#endif
+
+// UI states, as stored in the UI_STATE_MASK field of sysState; these also index the rows of uiTable
+#define UI_STATE_SHIFT          2               // number of bits to shift a UI state to be in UI_STATE_MASK
+#define UI_ON                   0               // ON, with no value being edited
+#define UI_RATE_EDIT            1               // RATE EDIT
+#define UI_VTBI_EDIT            2               // VTBI EDIT
+#define UI_PUMP_ACTIVE          3               // PUMP ACTIVE
+#define UI_NUM_STATES           4
+#define UI_NUM_KEYS             16              // one uiTable column for every (column 4-7, row 0-3) coordinate, whether or not a key is there
+
+// actions performed by runUiTransition, once the state has changed to the entry's next state
+#define UI_ACT_NONE             0               // nothing besides the state change and flash
+#define UI_ACT_EDIT_ROW         1               // start editing the new state's row, setting it to "[][]0[]" if it has no user-defined value yet
+#define UI_ACT_INC_DIGIT        2               // increment the place given by the entry's arg on the edited row (see incDispRow)
+#define UI_ACT_CLEAR_ROW        3               // reset the edited row to "[][]0[]"
+#define UI_ACT_CLEAR_ALL        4               // reset both rows to "----", and the LEDs to their power on state
+#define UI_ACT_LED_CYCLE        5               // step the LED group given by the entry's arg (a ledCycles index) on to its next LED
+#define UI_ACT_LED_TOGGLE       6               // toggle the LEDs given by the entry's arg
+
+// LED groups stepped through by UI_ACT_LED_CYCLE; see ledCycles
+#define LEDS_CC_MONITOR         0               // COMPUTER CONTROL -> blank button -> MONITOR -> off
+#define LEDS_PC_MODE            1               // CONTROLLER -> PUMP -> off
+#define LEDS_POWER              2               // battery -> plug power -> off
+#define LED_CYCLE_LEN           3
+
+// keys of the CLEAR/SILENCE + START chord, as tracked by the main loop's chordKeys (bitmap keypad scanning only)
+#define CHORD_CLEAR             BIT0
+#define CHORD_START             BIT1
+#define LAMP_TEST_CHORD         (CHORD_CLEAR | CHORD_START)
 
 #define TOP_ROW                 0               // represents a write to the top row of displays; used to make calls to writeToDispRow easier to read
 #define BOT_ROW                 1               // represents a write to the bottom row of displays
@@ -155,8 +414,15 @@
 #define ONES_PLACE              2               // used to increment the ones place within a display row
 #define TENTHS_PLACE            3               // used to increment the tenths place within a display rowt
 
+// profiled stages of each keypress (see "profiler.h"); the last stage is the end-to-end latency, which also gets a histogram
+#define PROF_STAGE_SCAN         0               // debounce ISR: scanning or saving the key and queuing its event
+#define PROF_STAGE_DISPATCH     1               // main loop: handling one key release event, up to (not including) the commit of its display and LED writes
+#define PROF_STAGE_REFRESH      2               // flushDisps or refreshAllDisps: composing, diffing, and sending or queuing the displays
+#define PROF_STAGE_OUTPUT       3               // key debounced -> the last display/LED byte committed for it has left UCA0TXBUF
+#define PROF_NUM_PAGES          ((2 * PROF_NUM_STAGES) + (PROF_HIST_BINS / 4))  // pages in the diagnostic profile view
+
 #define NUM_DISPS               8               /* Do not set to be greater than 8, as byte-size shifting is done for display index manipulation.
-                                                 * If a port wider than 1 byte is used and properly defined for use with the writeHexToSevSeg function,
+                                                 * If a port wider than 1 byte is used and properly defined for use with the flushDisps function,
                                                  * you can set NUM_DISPS up to the width of port.  */
 
 // SEE "mtrxKeypad.h" FOR COORDINATE FORMAT EXPLANATION
@@ -181,36 +447,94 @@ enum GEMINI_KEYS
 
 //########## PREPROCESSOR MACROS ##########//
 
+// converts a number of milliseconds to MCLK cycles at F_CPU, for __delay_cycles (which needs a compile-time constant)
+#define MS_TO_CYCLES(ms)    ((ms) * (F_CPU / 1000UL))
+
+// evaluates as the current UI state, and sets it; the field is changed with separate clear and set operations, so ISRs setting other sysState flags are never undone
+#define UI_STATE            ((currSysState & UI_STATE_MASK) >> UI_STATE_SHIFT)
+#define SET_UI_STATE(state) currSysState &= ~UI_STATE_MASK; currSysState |= ((state) << UI_STATE_SHIFT)
+
+// evaluates as the display row edited in a UI state (only meaningful in UI_RATE_EDIT and UI_VTBI_EDIT)
+#define UI_EDIT_ROW(state)  (((state) == UI_VTBI_EDIT) ? BOT_ROW : TOP_ROW)
+
+// evaluates as nonzero for a key coordinate with a uiTable column (columns 4 to 7, rows 0 to 3), and as that column's index
+#define UI_KEY_VALID(keyCoord)  (((keyCoord) & 0xCC) == 0x40)
+#define UI_KEY_INDEX(keyCoord)  ((((keyCoord) >> 2) & 0x0C) | ((keyCoord) & 0x03))
+
+// encodes a keypad event as a control link report: the key coordinate, with the event type + 1 in bits 3:2 (always 0 in a Gemini key coordinate), so a report is never CTRL_REPORT_IDLE
+#define CTRL_KEY_REPORT(event)  ((event).keyCoord | (((event).eventType + 1) << 2))
+
+// packs the flash parameters of a uiTable entry (passed to flashDispRow), and unpacks them; a flash of 0 means no flash
+#define UI_FLASH(rowSel, numFlashes)    (((numFlashes) << 2) | (rowSel))
+#define UI_FLASH_ROWS(flash)            ((flash) & 0x03)
+#define UI_FLASH_COUNT(flash)           ((flash) >> 2)
+#define UI_NO_FLASH                     0
+
 // macros to activate chip select pins
-#define SEL_DISP0       DISPS_CSOUT |= DISP0
-#define SEL_DISP1       DISPS_CSOUT |= DISP1
-#define SEL_DISP2       DISPS_CSOUT |= DISP2
-#define SEL_DISP3       DISPS_CSOUT |= DISP3
-#define SEL_DISP4       DISPS_CSOUT |= DISP4
-#define SEL_DISP5       DISPS_CSOUT |= DISP5
-#define SEL_DISP6       DISPS_CSOUT |= DISP6
-#define SEL_DISP7       DISPS_CSOUT |= DISP7
-#define SEL_TOP_DISPS   DISPS_CSOUT |= TOP_DISPS
-#define SEL_BOT_DISPS   DISPS_CSOUT |= BOT_DISPS
-#define SEL_ALL_DISPS   DISPS_CSOUT |= ALL_DISPS
-#define SEL_LEDSR       LEDSR_CSOUT |= LEDSR
-#define SEL_EVERYTHING  DISPS_CSOUT |= ALL_DISPS; LEDSR_CSOUT |= LEDSR
+#define SEL_DISP0       HAL_PIN_SET(DISPS_CSOUT, DISP0)
+#define SEL_DISP1       HAL_PIN_SET(DISPS_CSOUT, DISP1)
+#define SEL_DISP2       HAL_PIN_SET(DISPS_CSOUT, DISP2)
+#define SEL_DISP3       HAL_PIN_SET(DISPS_CSOUT, DISP3)
+#define SEL_DISP4       HAL_PIN_SET(DISPS_CSOUT, DISP4)
+#define SEL_DISP5       HAL_PIN_SET(DISPS_CSOUT, DISP5)
+#define SEL_DISP6       HAL_PIN_SET(DISPS_CSOUT, DISP6)
+#define SEL_DISP7       HAL_PIN_SET(DISPS_CSOUT, DISP7)
+#define SEL_TOP_DISPS   HAL_PIN_SET(DISPS_CSOUT, TOP_DISPS)
+#define SEL_BOT_DISPS   HAL_PIN_SET(DISPS_CSOUT, BOT_DISPS)
+#define SEL_ALL_DISPS   HAL_PIN_SET(DISPS_CSOUT, ALL_DISPS)
+#define SEL_LEDSR       HAL_PIN_SET(LEDSR_CSOUT, LEDSR)
+#define SEL_EVERYTHING  HAL_PIN_SET(DISPS_CSOUT, ALL_DISPS); HAL_PIN_SET(LEDSR_CSOUT, LEDSR)
 
 // macros to deactivate chip select pins
-#define DSEL_DISP0      DISPS_CSOUT &= ~DISP0
-#define DSEL_DISP1      DISPS_CSOUT &= ~DISP1
-#define DSEL_DISP2      DISPS_CSOUT &= ~DISP2
-#define DSEL_DISP3      DISPS_CSOUT &= ~DISP3
-#define DSEL_DISP4      DISPS_CSOUT &= ~DISP4
-#define DSEL_DISP5      DISPS_CSOUT &= ~DISP5
-#define DSEL_DISP6      DISPS_CSOUT &= ~DISP6
-#define DSEL_DISP7      DISPS_CSOUT &= ~DISP7
-#define DSEL_TOP_DISPS  DISPS_CSOUT &= ~TOP_DISPS
-#define DSEL_BOT_DISPS  DISPS_CSOUT &= ~BOT_DISPS
-#define DSEL_ALL_DISPS  DISPS_CSOUT &= ~ALL_DISPS
-#define DSEL_LEDSR      LEDSR_CSOUT &= ~LEDSR
-#define DSEL_EVERYTHING DISPS_CSOUT &= ~ALL_DISPS; LEDSR_CSOUT &= ~LEDSR
+#define DSEL_DISP0      HAL_PIN_CLR(DISPS_CSOUT, DISP0)
+#define DSEL_DISP1      HAL_PIN_CLR(DISPS_CSOUT, DISP1)
+#define DSEL_DISP2      HAL_PIN_CLR(DISPS_CSOUT, DISP2)
+#define DSEL_DISP3      HAL_PIN_CLR(DISPS_CSOUT, DISP3)
+#define DSEL_DISP4      HAL_PIN_CLR(DISPS_CSOUT, DISP4)
+#define DSEL_DISP5      HAL_PIN_CLR(DISPS_CSOUT, DISP5)
+#define DSEL_DISP6      HAL_PIN_CLR(DISPS_CSOUT, DISP6)
+#define DSEL_DISP7      HAL_PIN_CLR(DISPS_CSOUT, DISP7)
+#define DSEL_TOP_DISPS  HAL_PIN_CLR(DISPS_CSOUT, TOP_DISPS)
+#define DSEL_BOT_DISPS  HAL_PIN_CLR(DISPS_CSOUT, BOT_DISPS)
+#define DSEL_ALL_DISPS  HAL_PIN_CLR(DISPS_CSOUT, ALL_DISPS)
+#define DSEL_LEDSR      HAL_PIN_CLR(LEDSR_CSOUT, LEDSR)
+#define DSEL_EVERYTHING HAL_PIN_CLR(DISPS_CSOUT, ALL_DISPS); HAL_PIN_CLR(LEDSR_CSOUT, LEDSR)
+
+
+//########## STRUCTURES ##########//
+
+/* Numeric value shown on a RATE/VTBI display row; this is the source of truth for the row, and is rendered to the displays with renderDispRow.
+ * The tenths place is only ever blank or 1 to 9 on a real Gemini unit, so a tenth of 0 represents a blank tenths place.
+ * The whole and tenth parts are kept separate, as values in the thousands (up to 9999) would not fit in 16 bits as tenths. */
+typedef struct DISP_ROW_VALUE
+{
+    unsigned int whole;         // integer part of the value, from 0 to 999 (or up to 9999 on the bottom row)
+    unsigned char tenth;        // tenths digit from 1 to 9, or 0 if the tenths place is blank (always 0 when whole >= 1000)
+}
+DISP_ROW_VALUE;
+
+// what a key release does in a UI state; see uiTable
+typedef struct UI_TRANSITION
+{
+    unsigned char nextState;    // UI state to change to before the action (UI_ON, UI_RATE_EDIT, etc.)
+    unsigned char action;       // UI_ACT_ action for runUiTransition to perform
+    unsigned char arg;          // action argument: the place for UI_ACT_INC_DIGIT, LED group for UI_ACT_LED_CYCLE, or LEDs for UI_ACT_LED_TOGGLE
+    unsigned char flash;        // display rows to flash afterwards, packed with UI_FLASH, or UI_NO_FLASH
+}
+UI_TRANSITION;
 
+/* UI state kept through a warm restart; see saveWarmSnapshot. Every member is a whole number of words with no padding,
+ * as check is the complement of the 16-bit sum of every word before it. */
+typedef struct WARM_SNAPSHOT
+{
+    unsigned int validKey;          // WARM_VALID_KEY while the snapshot is in use
+    unsigned int rowWholes[2];      // DISP_ROW_VALUE whole parts of the RATE (TOP_ROW) and VTBI (BOT_ROW) rows
+    unsigned char rowTenths[2];     // DISP_ROW_VALUE tenth parts of the same rows
+    unsigned char ledState;         // LED shift register state
+    unsigned char sysState;         // WARM_STATE_FLAGS bits of currSysState
+    unsigned int check;             // complement of the sum of every word above
+}
+WARM_SNAPSHOT;
 
 
 //########## GLOBALS ##########//
@@ -221,369 +545,708 @@ enum GEMINI_KEYS
 volatile unsigned char currSysState = 0x00;
 volatile unsigned char prevSysState = 0x00;
 
+static SCHEDULER scheduler;     // tick scheduler for the TASK_ tasks, ticked by timer0A1ISR
+
+// display flash animation state, driven by TASK_DISP_FLASH; see flashDispRow
+static unsigned char flashRowMask = 0x00;       // displays being flashed by the current animation
+static unsigned char flashPhasesLeft = 0;       // remaining blank/restore phases in the current animation
+static unsigned char dispBlankMask = 0x00;      // displays currently blanked by the animation; composeDisps turns these off until restored
+
+static unsigned char dispCommitPending = 0;     // set when the displays have been edited since the last commit; see flushDisps
+
+#if (DISP_DAISY_CHAIN)
+static unsigned char frameBuf[FRAME_LEN];       // the bytes every register of the chain was last latched with (or is relit with, while dimmed), in shift order
+#if (DISP_DIMMING)
+static const unsigned char blankFrame[FRAME_LEN] = {0};     // shifted out in place of frameBuf while the dimmer is blanking the outputs
+#endif
+#endif
+
+/* Key release transitions, indexed by [UI state][UI_KEY_INDEX(key coordinate)]; this is kept in flash. Keys do nothing (besides the lamp test
+ * chord and the profile view) while the pump is active, except for PAUSE/STOP, START, and the power button (which is handled separately). */
+#define UI_STAY(state)  {(state), UI_ACT_NONE, 0, UI_NO_FLASH}
+#if (SUPPLY_MONITOR)
+#define UI_POWER_LEDS(state)    UI_STAY(state)  // the power LEDs follow the supply readings instead
+#else
+#define UI_POWER_LEDS(state)    {(state), UI_ACT_LED_CYCLE, LEDS_POWER, UI_NO_FLASH}
+#endif
+static const UI_TRANSITION uiTable[UI_NUM_STATES][UI_NUM_KEYS] =
+{
+    // UI_ON
+    {
+        {UI_ON, UI_ACT_LED_CYCLE, LEDS_CC_MONITOR, UI_NO_FLASH},                // CC_MONITOR
+        {UI_ON, UI_ACT_NONE, 0, UI_FLASH(ALL_ROWS, 1)},                         // PAUSE_STOP_ALT
+        UI_STAY(UI_ON),                                                         // HUNDRED
+        {UI_ON, UI_ACT_CLEAR_ALL, 0, UI_NO_FLASH},                              // CLEAR_SILENCE
+        UI_STAY(UI_ON),                                                         // (no key)
+        {UI_RATE_EDIT, UI_ACT_EDIT_ROW, 0, UI_FLASH(TOP_ROW, 2)},               // RATE
+        UI_STAY(UI_ON),                                                         // TEN
+        {UI_ON, UI_ACT_LED_CYCLE, LEDS_PC_MODE, UI_NO_FLASH},                   // PC_MODE
+        {UI_ON, UI_ACT_NONE, 0, UI_FLASH(ALL_ROWS, 1)},                         // PAUSE_STOP_DOWN
+        {UI_VTBI_EDIT, UI_ACT_EDIT_ROW, 0, UI_FLASH(BOT_ROW, 2)},               // VTBI
+        UI_STAY(UI_ON),                                                         // ONE
+        {UI_ON, UI_ACT_LED_TOGGLE, LED_SECPIGGYBACK, UI_NO_FLASH},              // SEC_PIGGY_BACK
+        UI_STAY(UI_ON),                                                         // (no key)
+        {UI_PUMP_ACTIVE, UI_ACT_NONE, 0, UI_FLASH(ALL_ROWS, 2)},                // START
+        UI_STAY(UI_ON),                                                         // TENTH
+        UI_POWER_LEDS(UI_ON)                                                    // VOLUME_INFUSED
+    },
+    // UI_RATE_EDIT (keys in the same order as above)
+    {
+        {UI_RATE_EDIT, UI_ACT_LED_CYCLE, LEDS_CC_MONITOR, UI_NO_FLASH},
+        {UI_ON, UI_ACT_NONE, 0, UI_FLASH(ALL_ROWS, 1)},
+        {UI_RATE_EDIT, UI_ACT_INC_DIGIT, HUNDREDS_PLACE, UI_NO_FLASH},
+        {UI_RATE_EDIT, UI_ACT_CLEAR_ROW, 0, UI_NO_FLASH},
+        UI_STAY(UI_RATE_EDIT),
+        {UI_ON, UI_ACT_NONE, 0, UI_FLASH(TOP_ROW, 1)},
+        {UI_RATE_EDIT, UI_ACT_INC_DIGIT, TENS_PLACE, UI_NO_FLASH},
+        {UI_RATE_EDIT, UI_ACT_LED_CYCLE, LEDS_PC_MODE, UI_NO_FLASH},
+        {UI_ON, UI_ACT_NONE, 0, UI_FLASH(ALL_ROWS, 1)},
+        {UI_VTBI_EDIT, UI_ACT_EDIT_ROW, 0, UI_FLASH(BOT_ROW, 2)},
+        {UI_RATE_EDIT, UI_ACT_INC_DIGIT, ONES_PLACE, UI_NO_FLASH},
+        {UI_RATE_EDIT, UI_ACT_LED_TOGGLE, LED_SECPIGGYBACK, UI_NO_FLASH},
+        UI_STAY(UI_RATE_EDIT),
+        {UI_PUMP_ACTIVE, UI_ACT_NONE, 0, UI_FLASH(ALL_ROWS, 2)},
+        {UI_RATE_EDIT, UI_ACT_INC_DIGIT, TENTHS_PLACE, UI_NO_FLASH},
+        UI_POWER_LEDS(UI_RATE_EDIT)
+    },
+    // UI_VTBI_EDIT (keys in the same order as above)
+    {
+        {UI_VTBI_EDIT, UI_ACT_LED_CYCLE, LEDS_CC_MONITOR, UI_NO_FLASH},
+        {UI_ON, UI_ACT_NONE, 0, UI_FLASH(ALL_ROWS, 1)},
+        {UI_VTBI_EDIT, UI_ACT_INC_DIGIT, HUNDREDS_PLACE, UI_NO_FLASH},
+        {UI_VTBI_EDIT, UI_ACT_CLEAR_ROW, 0, UI_NO_FLASH},
+        UI_STAY(UI_VTBI_EDIT),
+        {UI_RATE_EDIT, UI_ACT_EDIT_ROW, 0, UI_FLASH(TOP_ROW, 2)},
+        {UI_VTBI_EDIT, UI_ACT_INC_DIGIT, TENS_PLACE, UI_NO_FLASH},
+        {UI_VTBI_EDIT, UI_ACT_LED_CYCLE, LEDS_PC_MODE, UI_NO_FLASH},
+        {UI_ON, UI_ACT_NONE, 0, UI_FLASH(ALL_ROWS, 1)},
+        {UI_ON, UI_ACT_NONE, 0, UI_FLASH(BOT_ROW, 1)},
+        {UI_VTBI_EDIT, UI_ACT_INC_DIGIT, ONES_PLACE, UI_NO_FLASH},
+        {UI_VTBI_EDIT, UI_ACT_LED_TOGGLE, LED_SECPIGGYBACK, UI_NO_FLASH},
+        UI_STAY(UI_VTBI_EDIT),
+        {UI_PUMP_ACTIVE, UI_ACT_NONE, 0, UI_FLASH(ALL_ROWS, 2)},
+        {UI_VTBI_EDIT, UI_ACT_INC_DIGIT, TENTHS_PLACE, UI_NO_FLASH},
+        UI_POWER_LEDS(UI_VTBI_EDIT)
+    },
+    // UI_PUMP_ACTIVE (keys in the same order as above)
+    {
+        UI_STAY(UI_PUMP_ACTIVE),
+        {UI_ON, UI_ACT_NONE, 0, UI_FLASH(ALL_ROWS, 1)},
+        UI_STAY(UI_PUMP_ACTIVE),
+        UI_STAY(UI_PUMP_ACTIVE),
+        UI_STAY(UI_PUMP_ACTIVE),
+        UI_STAY(UI_PUMP_ACTIVE),
+        UI_STAY(UI_PUMP_ACTIVE),
+        UI_STAY(UI_PUMP_ACTIVE),
+        {UI_ON, UI_ACT_NONE, 0, UI_FLASH(ALL_ROWS, 1)},
+        UI_STAY(UI_PUMP_ACTIVE),
+        UI_STAY(UI_PUMP_ACTIVE),
+        UI_STAY(UI_PUMP_ACTIVE),
+        UI_STAY(UI_PUMP_ACTIVE),
+        {UI_PUMP_ACTIVE, UI_ACT_NONE, 0, UI_FLASH(ALL_ROWS, 2)},
+        UI_STAY(UI_PUMP_ACTIVE),
+        UI_STAY(UI_PUMP_ACTIVE)
+    }
+};
+
+// LEDs of each UI_ACT_LED_CYCLE group, in the order they are lit; if none or several of a group's LEDs are lit, the first one is lit alone next
+static const unsigned char ledCycles[][LED_CYCLE_LEN] =
+{
+    {LED_CC, LED_BLANKBUTTON, LED_MONITOR},     // LEDS_CC_MONITOR
+    {LED_CONTROLLER, LED_PUMP, 0},              // LEDS_PC_MODE
+    {LED_BATTPWR, LED_PLUGPWR, 0}               // LEDS_POWER
+};
+
 // define registers and pin masks for a matrix keypad with row pins PORT2<3:0> and column pins PORT2<7:4>
 static MATRIX_KEYPAD geminiKeypad = {&P2IN, &P2OUT, &P2DIR, &P2SEL, &P2REN, &P2IE, &P2IES, &P2IFG, &P2OUT, &P2DIR, &P2SEL, 0x0F, 0xF0};
 
+// define registers for USCI_A0 on PORT1, with only SOMI and SCLK; this peripheral will run with loopback, as no SOMI is needed
+static const USCIXNSPI USCIA0SPI = {&P1SEL, &P1SEL2, 0x0, BIT2, 0x0, BIT4, &UCA0CTL0, &UCA0CTL1, &UCA0BR0, &UCA0BR1, &UCA0STAT, &UCA0TXBUF, &UCA0RXBUF, &IFG2, UCA0TXIFG, UCA0RXIFG, &IE2, UCA0RXIE};
+
+#if (COMPUTER_CONTROL)
+// define registers for USCI_B0 on PORT1 as the computer control link's SPI slave, with SOMI, SIMO, and SCLK (the computer has no chip select on the link)
+static const USCIXNSPI USCIB0SPI = {&P1SEL, &P1SEL2, 0x0, BIT7, BIT6, BIT5, &UCB0CTL0, &UCB0CTL1, &UCB0BR0, &UCB0BR1, &UCB0STAT, &UCB0TXBUF, &UCB0RXBUF, &IFG2, UCB0TXIFG, UCB0RXIFG, &IE2, UCB0RXIE};
+#elif (LEDSR_USCIB0)
+// define registers for USCI_B0 on PORT1, with only SIMO and SCLK, for the LED shift register; like USCI_A0, this runs with loopback
+static const USCIXNSPI USCIB0SPI = {&P1SEL, &P1SEL2, 0x0, BIT7, 0x0, BIT5, &UCB0CTL0, &UCB0CTL1, &UCB0BR0, &UCB0BR1, &UCB0STAT, &UCB0TXBUF, &UCB0RXBUF, &IFG2, UCB0TXIFG, UCB0RXIFG, &IE2, UCB0RXIE};
+#endif
+
+// the same USCI_A0 registers and keypad pins as constants, for the blocking transmits and the matrix scan (spiA0PutChar(), mtrxGeminiDebounce(), etc.)
+SPI_DEFINE_INSTANCE(A0, IFG2, UCA0TXIFG, UCA0RXIFG, UCA0STAT, UCA0TXBUF, UCA0RXBUF)
+#if (MTRX_BITMAP_SCAN)
+MTRX_DEFINE_INSTANCE(Gemini, P2IN, P2OUT, 0x0F, 0xF0)
+#endif
+
+#if (SPI_ASYNC_QUEUE)
+#if (LEDSR_USCIB0)
+static USCIXNSPI_QUEUE spiTxQueue;  // queue of display writes, drained by the USCI_A0 RX interrupt
+static USCIXNSPI_QUEUE ledTxQueue;  // queue of LED shift register writes, drained by the USCI_B0 RX interrupt
+#define SPI_TX_IDLE     (spiTxQueue.drained && ledTxQueue.drained)
+#else
+static USCIXNSPI_QUEUE spiTxQueue;  // queue of display and LED shift register writes, drained by the USCI_A0 RX interrupt
+#define SPI_TX_IDLE     (spiTxQueue.drained)
+#endif
+#else
+#define SPI_TX_IDLE     1           // synchronous writes always finish before returning
+#endif
+
+#if (COMPUTER_CONTROL)
+static CTRL_LINK ctrlLink;          // computer control link, fed by the USCI_B0 RX interrupt
+static CTRL_FRAME ctrlFrame;        // the control link command being handled; its segCodes keep what the computer last sent each display
+static unsigned char ctrlDispMask = 0x00;   // displays the computer has sent under COMPUTER CONTROL, which composeDisps shows instead of the front panel's
+#define CTRL_IDLE       (!CTRL_CMD_PENDING(&ctrlLink))
+#else
+#define CTRL_IDLE       1
+#endif
+
+#if (SUPPLY_MONITOR)
+static SUPPLY_SENSE supply;         // supply monitor, read in the background by the Timer0_A CCR2 and ADC10 interrupts
+#define SUPPLY_IDLE     (!SUPPLY_READING_READY(&supply))
+#define OFF_LEDS        ((supply.onPlug) ? LED_PLUGPWR : LED_BATTPWR)   // LEDs lit while in the OFF state: the power LED for the measured supply
+#else
+#define SUPPLY_IDLE     1
+#define OFF_LEDS        LED_PLUGPWR
+#endif
+
+static LED_COMPOSITOR ledComp;      // LED shift register state; its base is the UI's LED state, with the LEDC_LAYER_ layers over it (see commitLeds)
+
+#if (DISP_DIMMING)
+static DIMMER dimmer;               // display and LED brightness, timed by the Timer1_A CCR0 (blanking) and CCR1 (inactivity) interrupts
+#if !(DISP_DAISY_CHAIN)
+static unsigned char ledSRShown;    // LED shift register state last written by writeSpiSlave, which writeDimPhase relights it with (in a chain, frameBuf keeps it)
+#endif
+#define DIMMER_IDLE     (!DIM_PHASE_PENDING(&dimmer))
+#else
+#define DIMMER_IDLE     1
+#endif
+
+#if (WARM_RESTART)
+// the snapshot is kept through resets (such as the one done by criticalFaultHandler); it is only trusted after a watchdog reset, and only if its check is good
+#pragma NOINIT(warmSnapshot)
+static WARM_SNAPSHOT warmSnapshot;
+#endif
+
+#if (LATENCY_PROFILE)
+// the profile is kept through resets (such as the one done by criticalFaultHandler); profInit only clears it if it isn't valid
+#pragma NOINIT(latencyProfile)
+static PROF_DATA latencyProfile;
+static volatile unsigned int profOutputStart;       // debounce timestamp of the key release whose SPI writes are still being shifted out
+static volatile unsigned char profOutputPending = 0; // set while profOutputStart is waiting for the SPI queue to drain
+#define KEY_EVENT_TIMESTAMP     (PROF_NOW())        // key events are timestamped with the profiler timer, so stages can be measured from them
+#define LPM_IDLE_BITS           LPM0_bits           // SMCLK must keep running for the profiler timer
+#else
+#define KEY_EVENT_TIMESTAMP     (TA0R)
+#define LPM_IDLE_BITS           LPM3_bits
+#endif
+
 
 //########## FUNCTION PROTOTYPES ##########//
-static unsigned char writeHexToSevSeg(const USCIXNSPI* usciXN, SEVEN_SEG_DISP *const display, const unsigned char hexCode, const unsigned char csPortIndex);
-static unsigned char writeToDispRow(const USCIXNSPI* usciXN, SEVEN_SEG_DISP *const displayArr, const unsigned char (*rowDataArr)[2], unsigned char botRow);
-static unsigned char incDispRow(const USCIXNSPI* usciXN, SEVEN_SEG_DISP *const displayArr, const unsigned char digitPos, const unsigned char botRow);
-static void refreshAllDisps(const USCIXNSPI* usciXN, SEVEN_SEG_DISP *const displayArr);
-static void writeToRowBuff(unsigned char (*const rowBuff)[2], const unsigned char dat0, const unsigned char dp0, const unsigned char dat1, const unsigned char dp1, const unsigned char dat2, const unsigned char dp2, const unsigned char dat3, const unsigned char dp3);
-static void flashDispRow(const USCIXNSPI* usciXN, SEVEN_SEG_DISP *const displayArr, const unsigned char rowSel, const unsigned char numFlashes);
-static void criticalFaultHandler(const USCIXNSPI* usciXN, SEVEN_SEG_DISP *const displayArr, unsigned char (*const rowBuff)[2]);
+static void runUiTransition(SEVEN_SEG_ARR *const displayArr, DISP_ROW_VALUE *const rowValues, unsigned char *const ledState, const UI_TRANSITION *const transition);
+static void writeSpiSlave(const USCIXNSPI *const usciXN, volatile unsigned char *const csOut, const unsigned char csMask, const unsigned char txByte);
+#if (DISP_DAISY_CHAIN)
+static void writeFrame(void);
+#endif
+static void composeDisps(SEVEN_SEG_ARR *const displayArr);
+static void writeDispMask(const USCIXNSPI* usciXN, const SEVEN_SEG_ARR *const displayArr, unsigned char dispMask);
+static void flushDisps(const USCIXNSPI* usciXN, SEVEN_SEG_ARR *const displayArr);
+static unsigned char writeToDispRow(SEVEN_SEG_ARR *const displayArr, const unsigned char *const packedRow, unsigned char botRow);
+static unsigned char incDispRow(SEVEN_SEG_ARR *const displayArr, DISP_ROW_VALUE *const rowValue, const unsigned char digitPos, const unsigned char botRow);
+static void renderDispRow(SEVEN_SEG_ARR *const displayArr, const DISP_ROW_VALUE *const rowValue, unsigned char botRow);
+static void getRowDigits(unsigned int whole, unsigned char *const digits);
+static void refreshAllDisps(const USCIXNSPI* usciXN, SEVEN_SEG_ARR *const displayArr);
+static void writeToRowBuff(unsigned char *const rowBuff, const unsigned char dat0, const unsigned char dp0, const unsigned char dat1, const unsigned char dp1, const unsigned char dat2, const unsigned char dp2, const unsigned char dat3, const unsigned char dp3);
+static void flashDispRow(const unsigned char rowSel, const unsigned char numFlashes);
+static void serviceDispFlash(void);
+static void cancelDispFlash();
+#if (MTRX_BITMAP_SCAN)
+static void setLampTest(const unsigned char lampOn);
+#endif
+static void commitLeds(const USCIXNSPI* usciXN);
+#if (SUPPLY_MONITOR)
+static void setSupplyLeds(void);
+#endif
+#if (DISP_DIMMING)
+static void writeDimPhase(const USCIXNSPI* usciXN, SEVEN_SEG_ARR *const displayArr);
+#endif
+static void criticalFaultHandler(const USCIXNSPI* usciXN, SEVEN_SEG_ARR *const displayArr, const unsigned char faultCode);
+#if (LATENCY_PROFILE)
+static unsigned char showProfPage(const USCIXNSPI* usciXN, SEVEN_SEG_ARR *const displayArr, const PROF_DATA *const prof, unsigned char page);
+static void writeHexRow(SEVEN_SEG_ARR *const displayArr, const unsigned int hexWord, const unsigned char dpMask, unsigned char botRow);
+#endif
+#if (LATENCY_PROFILE || WARM_RESTART)
+static void restoreDispRows(SEVEN_SEG_ARR *const displayArr, const DISP_ROW_VALUE *const rowValues);
+#endif
+#if (WARM_RESTART)
+static void saveWarmSnapshot(const DISP_ROW_VALUE *const rowValues, const unsigned char ledState);
+static unsigned char loadWarmSnapshot(DISP_ROW_VALUE *const rowValues, unsigned char *const ledState);
+static unsigned int warmChecksum(const WARM_SNAPSHOT *const snapshot);
+#endif
 static void disableKeypad();
 __inline static void enableKeypad();
 __inline static void initKeypadDelayTimer();
+__inline static unsigned char initClocks();
 __inline static void initPwrBtn();
 
 
 //########## MAIN FUNCTION ##########//
 void main(void)
 {
-    // define registers for USCI_A0 on PORT1, with only SOMI and SCLK; this peripheral will run with loopback, as no SOMI is needed
-    const USCIXNSPI USCIA0SPI = {&P1SEL, &P1SEL2, 0x0, BIT2, 0x0, BIT4, &UCA0CTL0, &UCA0CTL1, &UCA0BR0, &UCA0BR1, &UCA0STAT, &UCA0TXBUF, &UCA0RXBUF, &IFG2, UCA0TXIFG, UCA0RXIFG};
+    SEVEN_SEG_ARR sevSegDispArr;                // packed array of seven segment displays, representing the 8 on the gemini interface
 
-    SEVEN_SEG_DISP sevSegDispArr[NUM_DISPS];    // an array of seven segment displays, representing the 8 on the gemini interface
-    unsigned char nextLedSRState;               // next state of the LED shift register; compared with currnextLedSRState to only do SPI writes when a change occurs
-    unsigned char currLedSRState;               // current state of the LED shift register
-
-    unsigned char rowDataBuff[4][2];            // 4x2 array used to store row data before passing by reference to writeToDispRow; see function header for format definition
+    DISP_ROW_VALUE rowValues[2];                // RATE (TOP_ROW) and VTBI (BOT_ROW) values; only meaningful while FLAG_RATE_VALUE/FLAG_VTBI_VALUE is set
 
     unsigned char dispIndex;                    // used to index displays within the array (usually within a loop)
-    unsigned char hexCode;                      // used to store various hex digits when counting on displays
-    unsigned char invalidKeyPress;              // used to store the validity of a keypress scan
+    MTRX_KEY_EVENT keyEvent;                    // the keypad event currently being handled, popped from the keypad's event FIFO
+    unsigned char dueTasks;                     // SCHED_TASK_BIT bits of the scheduler tasks to run, collected once per wake
+#if (MTRX_BITMAP_SCAN)
+    unsigned char chordKeys = 0;                // CHORD_ bits of the chord keys currently held, tracked from their press/release events
+#endif
+#if (MTRX_TYPEMATIC)
+    unsigned int repeatedKeys = 0;              // keyMap bits of held keys that have auto-repeated, whose release should do nothing
+    const UI_TRANSITION *uiEntry;               // uiTable entry of the key repeat being handled
+#endif
+#if (LATENCY_PROFILE)
+    unsigned int profStart;                     // profiler timestamp taken when the current key event started being handled
+    unsigned char profViewPage = 0;             // page of the diagnostic profile view being shown, or 0 if the view isn't shown
+    unsigned int profKeyStart;                  // debounce timestamp of the first key release handled on this pass, timed until its commit is out
+    unsigned char profKeyPending = 0;           // set while profKeyStart is waiting for this pass's commit
+#endif
+    unsigned char warmRestart = 0;              // set when resuming from warmSnapshot, rather than cold booting
+    unsigned char clockFault;                   // set when initClocks couldn't raise the clocks to F_CPU
 
     WDTCTL = WDTPW | WDTHOLD;   // stop watchdog timer
 
     // set display and LED SR chip select ports to output, initializing chip selects as inactive
+#if (DISP_DAISY_CHAIN)
+    FRAME_CSDIR |= FRAME_CS;
+    HAL_PIN_CLR(FRAME_CSOUT, FRAME_CS);
+#else
     DISPS_CSDIR |= ALL_DISPS;
     LEDSR_CSDIR |= LEDSR;
     DSEL_ALL_DISPS;
     DSEL_LEDSR;
+#endif
+
+    // initialize the LEDs to have the pump, computer control, and plug power LEDs lit upon power on (unless the snapshot below has them)
+    ledCompInit(&ledComp, LED_PUMP | LED_CC | LED_PLUGPWR);
+
+#if (WARM_RESTART)
+    // WDTIFG is only set by a watchdog reset (including an invalid WDTCTL password), which leaves the supply and RAM intact; it is cleared for the next reset
+    if ((IFG1 & (WDTIFG | PORIFG)) == WDTIFG)
+        warmRestart = !loadWarmSnapshot(rowValues, &ledComp.base);
+    IFG1 &= ~(WDTIFG | PORIFG);
+#endif
+
+#if (SUPPLY_MONITOR)
+    // wait for the supply to settle before initializing keypad and other subsystems, to avoid interference from AC power transients
+    if (!warmRestart)
+        supplyWaitSettled(&supply);     // if it doesn't settle in time, there's nothing better to do than to carry on
+    else
+        supplyInit(&supply);
+#else
+    if (!warmRestart)
+        __delay_cycles(STARTUP_DELAY);  // delay before initializing keypad and other subsystems to avoid interference from AC power transients
+#endif
 
-    __delay_cycles(STARTUP_DELAY);  // delay before initializing keypad and other subsystems to avoid interference from AC power transients
+    // only raise MCLK/SMCLK to F_CPU once the supply has had time to settle; without valid DCO calibration constants, this is a fault (see below)
+    clockFault = initClocks();
 
-    // initialize all displays as active high, representing "----" being displayed on each row
+    // initialize all displays as active high, with a front frame representing "----" being displayed on each row
     // this allows the interface to boot up in an OFF state, able to resume to these values upon turning ON
+    sevSegDispArr.activeLow = 0;
+    sevSegDispArr.frontFrame = 0;
     for (dispIndex = 0; dispIndex < NUM_DISPS; dispIndex++)
+        sevSegDispArr.digits[dispIndex] = SEVSEG_PACK(DASH_CODE, 0);
+
+#if (WARM_RESTART)
+    // resume with the snapshot's rows and states instead
+    if (warmRestart)
     {
-        sevSegDispArr[dispIndex] = (SEVEN_SEG_DISP){0, DASH_CODE, 0, 0x0, 0x0};
-        hexToSevSeg(&sevSegDispArr[dispIndex]);
-        sevSegDispArr[dispIndex].currBinSegCode = sevSegDispArr[dispIndex].nextBinSegCode;
+        currSysState = warmSnapshot.sysState;
+        restoreDispRows(&sevSegDispArr, rowValues);
     }
-
-    // initialize the LED shift register to have the pump, computer control, and plug power LEDs lit upon power on
-    currLedSRState = LED_PUMP | LED_CC | LED_PLUGPWR;
-    nextLedSRState = currLedSRState;
-
-    // init USCI_A0 in master mode, sclkdiv of 1, sclk active high with capture on first edge, 8-bit mode, MSB first, with loopback
-    usciXNSpiInit(&USCIA0SPI, SPI_MST, 1, (~UCCKPH & ~UCCKPL), SPI_DAT8BIT, SPI_MSB, SPI_LOOPBACK);
+#endif
+    sevSegArrRender(&sevSegDispArr, NUM_DISPS);
+    SEVSEG_SWAP(&sevSegDispArr);
+    dispCommitPending = 0;
+
+    // init USCI_A0 in master mode, sclkdiv of SPI_SCLK_DIV, sclk active high with capture on first edge, 8-bit mode, MSB first, with loopback
+    usciXNSpiInit(&USCIA0SPI, SPI_MST, SPI_SCLK_DIV, (~UCCKPH & ~UCCKPL), SPI_DAT8BIT, SPI_MSB, SPI_LOOPBACK);
+#if (SPI_ASYNC_QUEUE)
+    usciXNSpiQueueInit(&USCIA0SPI, &spiTxQueue);
+#endif
+#if (LEDSR_USCIB0)
+    // init USCI_B0 for the LED shift register the same way
+    usciXNSpiInit(&USCIB0SPI, SPI_MST, SPI_SCLK_DIV, (~UCCKPH & ~UCCKPL), SPI_DAT8BIT, SPI_MSB, SPI_LOOPBACK);
+    usciXNSpiQueueInit(&USCIB0SPI, &ledTxQueue);
+#endif
+#if (COMPUTER_CONTROL)
+    ctrlLinkInit(&USCIB0SPI, &ctrlLink);
+#endif
     mtrxKeypadInit(&geminiKeypad);
+#if (MTRX_INTEGRATE_DBNC)
+    geminiKeypad.slowKeys = mtrxKeypadKeyBit(&geminiKeypad, START);    // starting the pump takes a deliberate press
+#endif
+#if (MTRX_TYPEMATIC)
+    geminiKeypad.repeatKeys = mtrxKeypadKeyBit(&geminiKeypad, HUNDRED) | mtrxKeypadKeyBit(&geminiKeypad, TEN)
+                            | mtrxKeypadKeyBit(&geminiKeypad, ONE) | mtrxKeypadKeyBit(&geminiKeypad, TENTH);
+#endif
     initPwrBtn();
-    initKeypadDelayTimer();
 
-    // turn off all displays
-    SEL_ALL_DISPS;
-    usciXNSpiPutChar(&USCIA0SPI, 0x0);
-    DSEL_ALL_DISPS;
+    // none of the timing can be trusted on the power-up DCO, but the displays, LEDs, and power button are all the fault handler needs
+    if (clockFault)
+        criticalFaultHandler(&USCIA0SPI, &sevSegDispArr, FAULT_CLK_CAL);
 
-    // set the plug power LED on and all others off
-    SEL_LEDSR;
-    usciXNSpiPutChar(&USCIA0SPI, LED_PLUGPWR);
-    DSEL_LEDSR;
+    initKeypadDelayTimer();
+    schedInit(&scheduler);
+#if (SUPPLY_MONITOR)
+    TA0CCR2 = TA0R + SUPPLY_SAMPLE_TICKS;
+    TA0CCTL2 = CCIE;
+#endif
+#if (DISP_DIMMING)
+    TA1CTL = TASSEL_1 | MC_2 | TACLR;           // set source as ACLK, no clock division, continuous mode, for the dimmer's compares
+    dimInit(&dimmer, DIM_ACTIVE_LEVEL, DIM_IDLE_LEVEL);
+    dimCalibrate(&dimmer);                      // time the blanking period from this part's VLOCLK; if it can't be measured, the typical period is the best there is
+#endif
+#if (LATENCY_PROFILE)
+    profInit(&latencyProfile);
+#endif
+
+#if (WARM_RESTART)
+    // resuming in the ON state writes every display and the LEDs once, straight to their restored state; the power state is already handled
+    if (warmRestart && !(currSysState & FLAG_PWR_OFF))
+    {
+#if (SUPPLY_MONITOR)
+        setSupplyLeds();
+#endif
+        refreshAllDisps(&USCIA0SPI, &sevSegDispArr);
+        commitLeds(&USCIA0SPI);
+        prevSysState = currSysState;
+        enableKeypad();
+#if (DISP_DIMMING)
+        dimWake(&dimmer);
+#endif
+    }
+    else
+#endif
+    {
+        // turn off all displays
+        writeSpiSlave(&USCIA0SPI, &DISPS_CSOUT, ALL_DISPS, 0x0);
 
-    // ensure the system starts up in an OFF state
-    disableKeypad();
-    currSysState |= FLAG_PWR_OFF;
+        // ensure the system starts up in an OFF state, with the plug power LED (or the measured one) on and all others off
+        disableKeypad();
+        currSysState |= FLAG_PWR_OFF;
+        ledCompSetLayer(&ledComp, LEDC_LAYER_PWR, ALL_LEDS, OFF_LEDS, 0x00);
+#if (SUPPLY_MONITOR)
+        setSupplyLeds();
+#endif
+        commitLeds(&USCIA0SPI);
+    }
 
     // MAIN LOOP
     while(1)
     {
-        // keypad event occurred; button was either pressed or released
-        if ((currSysState ^ prevSysState) & FLAG_KEYPAD_PRESS)
+        /* Drain every debounced keypad event in the order it occurred, so keystrokes made while a previous one was being
+         * handled are not lost. Key actions are performed on release, matching the original single-key handshake. */
+        while (!mtrxKeypadPopEvent(&geminiKeypad, &keyEvent))
         {
-            // key is being pressed, so scan to determine the coordinates
-            if (currSysState & FLAG_KEYPAD_PRESS)
+#if (DISP_DIMMING)
+            // any key activity sets the active brightness, and restarts the inactivity timeout
+            dimWake(&dimmer);
+#endif
+
+#if (COMPUTER_CONTROL)
+            // every key event is reported to the computer (unless its reports are full, having not been collected); under COMPUTER CONTROL, that is all keys do
+            ctrlLinkReport(&ctrlLink, CTRL_KEY_REPORT(keyEvent));
+            if (currSysState & FLAG_COMPUTER_CTRL)
+                continue;
+#endif
+
+#if (MTRX_BITMAP_SCAN)
+            /* With N-key rollover, holding CLEAR/SILENCE and START together runs the lamp test, lighting every segment and LED until both keys
+             * are released. Every key event is ignored while it runs, so releasing the chord never clears a value or starts the pump. */
+            if (keyEvent.keyCoord == CLEAR_SILENCE)
+                chordKeys = (keyEvent.eventType == KEY_EVENT_PRESS) ? (chordKeys | CHORD_CLEAR) : (chordKeys & ~CHORD_CLEAR);
+            else if (keyEvent.keyCoord == START)
+                chordKeys = (keyEvent.eventType == KEY_EVENT_PRESS) ? (chordKeys | CHORD_START) : (chordKeys & ~CHORD_START);
+
+            if (currSysState & FLAG_LAMP_TEST)
             {
-                invalidKeyPress = scanForKeyPress(&geminiKeypad);
-
-                /* if the key press was invalid, immediately clear the keypad event flag and ensure previous and current states match;
-                   this should ensure an invalid key press is never saved, and no unexpected actions occur because of it */
-                if (invalidKeyPress)
+                if (!chordKeys)
                 {
-                    currSysState &= ~FLAG_KEYPAD_PRESS;
-                    prevSysState &= ~FLAG_KEYPAD_PRESS;
+                    currSysState &= ~FLAG_LAMP_TEST;
+                    setLampTest(0);
                 }
-                /* as far as the next loop is concerned, the keypad was previously pressed -- there is no need to match previous and current states;
-                 * this should ensure that a release event can occur smoothly even during this press check branch,
-                 * and still trigger a release handling in the next loop*/
-                else
-                    prevSysState |= FLAG_KEYPAD_PRESS;
+                continue;
             }
+            else if (chordKeys == LAMP_TEST_CHORD)
+            {
+                currSysState |= FLAG_LAMP_TEST;
+                setLampTest(1);
+                continue;
+            }
+#endif
 
-            // key was released and a valid key was scanned, so save the key data and perform the appropriate action
-            else
+#if (MTRX_TYPEMATIC)
+            /* Holding 100, 10, 1, or 0.1 repeats its increment, faster the longer it is held (see "mtrxKeypad.h"). The repeats stand in for
+             * the key's usual action on release, and are committed with every other event handled on this pass. Only
+             * uiTable entries that increment a digit are repeated, so repeats do nothing outside of the edit states. */
+            if (keyEvent.eventType == KEY_EVENT_REPEAT)
             {
-                saveKeyPress(&geminiKeypad);
+                repeatedKeys |= mtrxKeypadKeyBit(&geminiKeypad, keyEvent.keyCoord);
 
-                switch (geminiKeypad.currKeyCoord)
-                {
-                case CC_MONITOR:
-                    if (!(currSysState & FLAG_PUMP_ACTIVE))         // disable functionality while pump is active
-                    {
-                        if (!(((currLedSRState & LED_CC) ^ (currLedSRState & LED_BLANKBUTTON)) \
-                                || ((currLedSRState & LED_BLANKBUTTON) ^ (currLedSRState & LED_MONITOR)) \
-                                || ((currLedSRState & LED_CC) ^ (currLedSRState & LED_MONITOR))))
-                        {
-                            // if none or multiple of the CC, BLANKBUTTON, or MONITOR LEDs are active, set only the CC LED active
-                            nextLedSRState &= ~(LED_BLANKBUTTON | LED_MONITOR);
-                            nextLedSRState |= LED_CC;
-                        }
-                        else if (currLedSRState & LED_CC)           // cycle from CC LED to BLANKBUTTON LED
-                        {
-                            nextLedSRState &= ~LED_CC;
-                            nextLedSRState |= LED_BLANKBUTTON;
-                        }
-                        else if (currLedSRState & LED_BLANKBUTTON)  // cycle from BLANKBUTTON LED to MONITOR LED
-                        {
-                            nextLedSRState &= ~LED_BLANKBUTTON;
-                            nextLedSRState |= LED_MONITOR;
-                        }
-                        else if (currLedSRState & LED_MONITOR)      // cycle from MONITOR LED back to all 3 LEDs OFF
-                        {
-                            nextLedSRState &= ~LED_MONITOR;
-                        }
-                    }
-                    break;
+                uiEntry = &uiTable[UI_STATE][UI_KEY_INDEX(keyEvent.keyCoord)];
+                if (uiEntry->action == UI_ACT_INC_DIGIT)
+                    incDispRow(&sevSegDispArr, &rowValues[UI_EDIT_ROW(UI_STATE)], uiEntry->arg, UI_EDIT_ROW(UI_STATE));
+                continue;
+            }
+            else if ((keyEvent.eventType == KEY_EVENT_RELEASE) && (repeatedKeys & mtrxKeypadKeyBit(&geminiKeypad, keyEvent.keyCoord)))
+            {
+                repeatedKeys &= ~mtrxKeypadKeyBit(&geminiKeypad, keyEvent.keyCoord);
+                continue;
+            }
+#endif
 
-                case PAUSE_STOP_DOWN:   // scanning either coordinate on either variant should have the same result
-                case PAUSE_STOP_ALT:
-                    currSysState &= ~(FLAG_RATE_EDIT | FLAG_VTBI_EDIT);     // exit any ongoing value edits
-                    currSysState &= ~FLAG_PUMP_ACTIVE;                      // the "pump" is no longer active
-                    flashDispRow(&USCIA0SPI, sevSegDispArr, ALL_ROWS, 1);   // flash RATE and VTBI rows once at the same time
-                    break;
+            if (keyEvent.eventType == KEY_EVENT_RELEASE)
+            {
+#if (LATENCY_PROFILE)
+                profStart = PROF_NOW();
 
-                case RATE:
-                    if (!(currSysState & FLAG_PUMP_ACTIVE))                         // do not allow user to edit RATE value while pump is active
-                    {
-                        *(geminiKeypad.ROW_IE) &= ~(geminiKeypad.ROW_PINS);         // shut off keypad interrupts
-
-                        currSysState &= ~FLAG_VTBI_EDIT;                            // exit any ongoing edit of the VTBI value
-                        currSysState ^= FLAG_RATE_EDIT;                             // either enter or exit a RATE value edit state
-
-                        if (currSysState & FLAG_RATE_EDIT)                          // entering the RATE edit state
-                        {
-                            if (!(currSysState & FLAG_RATE_VALUE))                  // if there is no user-defined RATE value, set it to "[][]0[]"
-                            {
-                                writeToRowBuff(rowDataBuff, OFF_CODE, 0, OFF_CODE, 0, 0x0, 0, OFF_CODE, 0);
-                                writeToDispRow(&USCIA0SPI, sevSegDispArr, rowDataBuff, TOP_ROW);
-                                currSysState |= FLAG_RATE_VALUE;
-                            }
-                            flashDispRow(&USCIA0SPI, sevSegDispArr, TOP_ROW, 2);    // blink the RATE display row twice
-                        }
-
-                        else                                                        // exiting the RATE edit state
-                            flashDispRow(&USCIA0SPI, sevSegDispArr, TOP_ROW, 1);    // flash the RATE display row once
-
-                        *(geminiKeypad.ROW_IFG) &= ~(geminiKeypad.ROW_PINS);        // clear any keypad flags
-                        *(geminiKeypad.ROW_IE) |= (geminiKeypad.ROW_PINS);          // re-enable keypad interrupts
-                    }
-                    break;
+                // these keys do nothing while the pump is active (see uiTable), so the diagnostic profile view uses them
+                if ((UI_STATE == UI_PUMP_ACTIVE) && (keyEvent.keyCoord == VOLUME_INFUSED))
+                {
+                    profViewPage = showProfPage(&USCIA0SPI, &sevSegDispArr, &latencyProfile, profViewPage + 1);
+                    if (!profViewPage)
+                        restoreDispRows(&sevSegDispArr, rowValues);
+                }
+                else if ((UI_STATE == UI_PUMP_ACTIVE) && (keyEvent.keyCoord == CLEAR_SILENCE))
+                {
+                    profClear(&latencyProfile);
+                    if (profViewPage)
+                        showProfPage(&USCIA0SPI, &sevSegDispArr, &latencyProfile, profViewPage);
+                }
+                // any other key leaves the view before being handled as normal
+                else if (profViewPage)
+                {
+                    profViewPage = 0;
+                    restoreDispRows(&sevSegDispArr, rowValues);
+                }
+#endif
+                // every other key does what its uiTable entry for the current state says
+                if (UI_KEY_VALID(keyEvent.keyCoord))
+                    runUiTransition(&sevSegDispArr, rowValues, &ledComp.base, &uiTable[UI_STATE][UI_KEY_INDEX(keyEvent.keyCoord)]);
+            }
 
-                case VTBI:
-                    if (!(currSysState & FLAG_PUMP_ACTIVE))                         // do not allow user to edit VTBI value while pump is active
-                    {
-                        *(geminiKeypad.ROW_IE) &= ~(geminiKeypad.ROW_PINS);         // shut off keypad interrupts
-
-                        currSysState &= ~FLAG_RATE_EDIT;                            // exit any ongoing edit of the RATE value
-                        currSysState ^= FLAG_VTBI_EDIT;                             // either enter or exit a VTBI value edit state
-
-                        if (currSysState & FLAG_VTBI_EDIT)                          // entering the VTBI edit state
-                        {
-                            if (!(currSysState & FLAG_VTBI_VALUE))                  // if there is no user-defined VTBI value, set it to "[][]0[]"
-                            {
-                                writeToRowBuff(rowDataBuff, OFF_CODE, 0, OFF_CODE, 0, 0x0, 0, OFF_CODE, 0);
-                                writeToDispRow(&USCIA0SPI, sevSegDispArr, rowDataBuff, BOT_ROW);
-                                currSysState |= FLAG_VTBI_VALUE;
-                            }
-                            flashDispRow(&USCIA0SPI, sevSegDispArr, BOT_ROW, 2);    // blink the VTBI display row twice
-                        }
-
-                        else                                                        // exiting the VTBI edit state
-                            flashDispRow(&USCIA0SPI, sevSegDispArr, BOT_ROW, 1);    // flash the VTBI display row once
-
-                        *(geminiKeypad.ROW_IFG) &= ~(geminiKeypad.ROW_PINS);        // clear any keypad flags
-                        *(geminiKeypad.ROW_IE) |= (geminiKeypad.ROW_PINS);          // re-enable keypad interrupts
-                    }
-                    break;
-
-                case START:
-                    currSysState &= ~(FLAG_RATE_EDIT | FLAG_VTBI_EDIT);     // exit any ongoing value edits
-                    currSysState |= FLAG_PUMP_ACTIVE;                       // the "pump" is now activated
-                    flashDispRow(&USCIA0SPI, sevSegDispArr, ALL_ROWS, 2);   // blink RATE and VTBI rows twice at the same time
-                    break;
-
-                case HUNDRED:
-                    if (currSysState & FLAG_RATE_EDIT)
-                        incDispRow(&USCIA0SPI, sevSegDispArr, HUNDREDS_PLACE, TOP_ROW);
-                    else if (currSysState & FLAG_VTBI_EDIT)
-                        incDispRow(&USCIA0SPI, sevSegDispArr, HUNDREDS_PLACE, BOT_ROW);
-                    break;
-
-                case TEN:
-                    if (currSysState & FLAG_RATE_EDIT)
-                        incDispRow(&USCIA0SPI, sevSegDispArr, TENS_PLACE, TOP_ROW);
-                    else if (currSysState & FLAG_VTBI_EDIT)
-                        incDispRow(&USCIA0SPI, sevSegDispArr, TENS_PLACE, BOT_ROW);
-                    break;
-
-                case ONE:
-                    if (currSysState & FLAG_RATE_EDIT)
-                        incDispRow(&USCIA0SPI, sevSegDispArr, ONES_PLACE, TOP_ROW);
-                    else if (currSysState & FLAG_VTBI_EDIT)
-                        incDispRow(&USCIA0SPI, sevSegDispArr, ONES_PLACE, BOT_ROW);
-                    break;
-
-                case TENTH:
-                    if (currSysState & FLAG_RATE_EDIT)
-                        incDispRow(&USCIA0SPI, sevSegDispArr, TENTHS_PLACE, TOP_ROW);
-                    else if (currSysState & FLAG_VTBI_EDIT)
-                        incDispRow(&USCIA0SPI, sevSegDispArr, TENTHS_PLACE, BOT_ROW);
-                    break;
-
-                case CLEAR_SILENCE:
-                    if (!(currSysState & FLAG_PUMP_ACTIVE)) // only allow a clear then the pump is not active
-                    {
-                        // reset only the top row to its default value "[][]0[]" if editing the RATE value
-                        if (currSysState & FLAG_RATE_EDIT)
-                        {
-                            writeToRowBuff(rowDataBuff, OFF_CODE, 0, OFF_CODE, 0, 0x0, 0, OFF_CODE, 0);
-                            writeToDispRow(&USCIA0SPI, sevSegDispArr, rowDataBuff, TOP_ROW);
-                        }
-
-                        // reset only the bottom row to its default value "[][]0[]" if editing the VTBI value
-                        else if (currSysState & FLAG_VTBI_EDIT)
-                        {
-                            writeToRowBuff(rowDataBuff, OFF_CODE, 0, OFF_CODE, 0, 0x0, 0, OFF_CODE, 0);
-                            writeToDispRow(&USCIA0SPI, sevSegDispArr, rowDataBuff, BOT_ROW);
-                        }
-
-                        // if user isn't editing anything specific, reset all displays (both rows) to "----" and mark LEDs to reset to pump, cc, and plug power
-                        else
-                        {
-                            writeToRowBuff(rowDataBuff, DASH_CODE, 0, DASH_CODE, 0, DASH_CODE, 0, DASH_CODE, 0);
-                            writeToDispRow(&USCIA0SPI, sevSegDispArr, rowDataBuff, TOP_ROW);
-                            writeToDispRow(&USCIA0SPI, sevSegDispArr, rowDataBuff, BOT_ROW);
-                            currSysState &= ~(FLAG_RATE_VALUE | FLAG_VTBI_VALUE);
-                            nextLedSRState = LED_PUMP | LED_CC | LED_PLUGPWR;
-                        }
-                    }
-                    break;
+#if (LATENCY_PROFILE)
+            if (keyEvent.eventType == KEY_EVENT_RELEASE)
+            {
+                profRecord(&latencyProfile, PROF_STAGE_DISPATCH, PROF_NOW() - profStart);
 
-                case PC_MODE:
-                    if (!(currSysState & FLAG_PUMP_ACTIVE))                 // disable functionality while pump is active
-                    {
-                        if (!((currLedSRState & LED_CONTROLLER) ^ (currLedSRState & LED_PUMP)))
-                        {                                                   // if neither the PUMP or CONTROLLER LED is ON, or both are ON
-                            nextLedSRState &= ~LED_PUMP;                    // ensure the PUMP LED is cleared OFF
-                            nextLedSRState |= LED_CONTROLLER;               // and only the CONTROLLER LED is set ON
-                        }
-                        else if (currLedSRState & LED_CONTROLLER)           // cycle from PUMP LED to CONTROLLER LED
-                        {
-                            nextLedSRState &= ~LED_CONTROLLER;
-                            nextLedSRState |= LED_PUMP;
-                        }
-                        else if (currLedSRState & LED_PUMP)                 // cycle from CONTROLLER LED to both LEDs OFF
-                        {
-                            nextLedSRState &= ~LED_PUMP;
-                        }
-                    }
-                    break;
+                // every release handled on this pass is committed at once, so the end-to-end stage is timed from the first of them
+                if (!profKeyPending)
+                {
+                    profKeyStart = keyEvent.timestamp;
+                    profKeyPending = 1;
+                }
+            }
+#endif
+        }
 
-                case SEC_PIGGY_BACK:
-                    if (!(currSysState & FLAG_PUMP_ACTIVE)) // disable functionality while pump is active
-                    {
-                        nextLedSRState ^= LED_SECPIGGYBACK; // simply toggle the LED on the SEC_PIGGY_BACK button whenever it is pressed
-                    }
-                    break;
+#if (COMPUTER_CONTROL)
+        // apply every command the computer has sent since the last wake; they are dropped while the interface is OFF
+        while (!ctrlLinkPopCmd(&ctrlLink, &ctrlFrame))
+        {
+            if (currSysState & FLAG_PWR_OFF)
+                continue;
 
-                case VOLUME_INFUSED:
-                    if (!(currSysState & FLAG_PUMP_ACTIVE))                 // disable functionality while pump is active
+            if (CTRL_CMD_TYPE(ctrlFrame.cmd) == CTRL_CMD_FRAME)
+            {
+                // the first frame takes over from the front panel, ending whatever it was showing; displays the computer hasn't sent keep the front panel's values
+                if (!(currSysState & FLAG_COMPUTER_CTRL))
+                {
+                    cancelDispFlash();
+#if (LATENCY_PROFILE)
+                    if (profViewPage)
                     {
-                        if (!((currLedSRState & LED_BATTPWR) ^ (currLedSRState & LED_PLUGPWR)))
-                        {                                                   // if neither the BATTPWR or PLUGPWR LED is ON, or both are ON
-                            nextLedSRState &= ~LED_PLUGPWR;                 // ensure the PLUGPWR LED is cleared OFF
-                            nextLedSRState |= LED_BATTPWR;                  // and only the BATTPWR LED is set ON
-                        }
-                        else if (currLedSRState & LED_BATTPWR)              // cycle from BATTPWR LED to PLUGPWR LED
-                        {
-                            nextLedSRState &= ~LED_BATTPWR;
-                            nextLedSRState |= LED_PLUGPWR;
-                        }
-                        else if (currLedSRState & LED_PLUGPWR)              // cycle from PLUGPWR LED to both LEDs OFF
-                        {
-                            nextLedSRState &= ~LED_PLUGPWR;
-                        }
+                        profViewPage = 0;
+                        restoreDispRows(&sevSegDispArr, rowValues);
                     }
-                    break;
+#endif
+#if (MTRX_BITMAP_SCAN)
+                    if (currSysState & FLAG_LAMP_TEST)
+                        setLampTest(0);
+#endif
+                    currSysState &= ~FLAG_LAMP_TEST;
+                    currSysState |= FLAG_COMPUTER_CTRL;
                 }
 
-                // clear the keypress button flag, so a press event can potentially register in the next loop, even if it happened during a screen flash delay
-                prevSysState &= ~FLAG_KEYPAD_PRESS;
+                // ctrlLinkPopCmd only updated the segCodes the frame carried, so earlier frames' displays are kept
+                ctrlDispMask |= ctrlFrame.dispMask;
+                dispCommitPending = 1;
+                if (ctrlFrame.cmd & CTRL_FRAME_LED)
+                    ledCompSetLayer(&ledComp, LEDC_LAYER_CTRL, ALL_LEDS, ctrlFrame.ledState, 0x00);
             }
-
-            // if the next LED state differs from the current state, write the new state -- only do this once per button press to avoid SR flicker from constant refreshing
-            if (nextLedSRState ^ currLedSRState)
+            else if ((CTRL_CMD_TYPE(ctrlFrame.cmd) == CTRL_CMD_RELEASE) && (currSysState & FLAG_COMPUTER_CTRL))
             {
-                SEL_LEDSR;
-                usciXNSpiPutChar(&USCIA0SPI, nextLedSRState);
-                DSEL_LEDSR;
+                // hand the displays and LEDs back to the front panel; only the displays the computer changed are rewritten
+                currSysState &= ~FLAG_COMPUTER_CTRL;
+                ctrlDispMask = 0x00;
+                dispCommitPending = 1;
+                LEDC_CLEAR_LAYER(&ledComp, LEDC_LAYER_CTRL);
+
+                // keys held through the hand-over had their presses reported rather than handled
+#if (MTRX_BITMAP_SCAN)
+                chordKeys = 0;
+#endif
+#if (MTRX_TYPEMATIC)
+                repeatedKeys = 0;
+#endif
+            }
+        }
+#endif
+
+        // run every scheduler task that has come due since the last wake
+        dueTasks = schedPopDue(&scheduler);
+
+        // the next phase of a display flash is due
+        if (dueTasks & SCHED_TASK_BIT(TASK_DISP_FLASH))
+            serviceDispFlash();
+
+        // once the power button has been released, its release is debounced before its interrupt is enabled again
+        if ((dueTasks & SCHED_TASK_BIT(TASK_PWR_BTN_RELEASE)) && (KEYPAD_PWR_IN & KEYPAD_PWR_BTN))
+        {
+            schedStop(&scheduler, TASK_PWR_BTN_RELEASE);
+            schedStart(&scheduler, TASK_PWR_BTN_REARM, PWR_BTN_RELEASE_TICKS, 0);
+        }
 
-                currLedSRState = nextLedSRState;
+        if (dueTasks & SCHED_TASK_BIT(TASK_PWR_BTN_REARM))
+        {
+            KEYPAD_PWR_IFG &= ~KEYPAD_PWR_BTN;  // clear any unwanted power button flags
+            KEYPAD_PWR_IE |= KEYPAD_PWR_BTN;    // power button interrupts can now be enabled again
+        }
+
+        // the next phase of an LED blink is due; it is written with the commit below
+        if (dueTasks & SCHED_TASK_BIT(TASK_LED_BLINK))
+            ledCompToggleBlink(&ledComp);
+
+#if (SUPPLY_MONITOR)
+        // a background supply reading is in; if the board has moved to or from plug power, the power LEDs are changed with the commit below
+        if (SUPPLY_READING_READY(&supply) && !supplyUpdate(&supply))
+            setSupplyLeds();
+#endif
+
+#if (DISP_DIMMING)
+        // the dimmer has moved on to the lit or blank part of its period; nothing is lit while OFF (as last handled), so it is ignored then
+        if (!dimPopPhase(&dimmer) && !(prevSysState & FLAG_PWR_OFF))
+            writeDimPhase(&USCIA0SPI, &sevSegDispArr);
+#endif
+
+        /* Commit every display edit made on this pass at once, so the displays go straight from one complete frame to the next, then
+         * write the LED shift register if the composed state has changed -- only once per pass to avoid SR flicker from constant refreshing.
+         * No display edits are committed while OFF (going by prevSysState, the power state as last handled below); turning ON rewrites
+         * everything. The LEDs are still committed while OFF, where LEDC_LAYER_PWR leaves only OFF_LEDS to change. */
+        if (!(prevSysState & FLAG_PWR_OFF) && dispCommitPending)
+            flushDisps(&USCIA0SPI, &sevSegDispArr);
+        commitLeds(&USCIA0SPI);
+
+#if (LATENCY_PROFILE)
+        // the end-to-end stage is over once every write committed for this pass's releases has been shifted out; usciAB0RxISR records it if some still are
+        if (profKeyPending)
+        {
+            profKeyPending = 0;
+            __disable_interrupt();
+            if (SPI_TX_IDLE)
+                profRecord(&latencyProfile, PROF_STAGE_OUTPUT, PROF_NOW() - profKeyStart);
+            else
+            {
+                profOutputStart = profKeyStart;
+                profOutputPending = 1;
             }
+            __enable_interrupt();
         }
+#endif
 
         // power button was pressed
         if ((currSysState ^ prevSysState) & FLAG_PWR_OFF)
         {
-            // debounce press, wait for power button release, then debounce the release
-            __delay_cycles(PWR_BTN_PRESS_DELAY);
-            while(!(KEYPAD_PWR_IN & KEYPAD_PWR_BTN));
-            __delay_cycles(PWR_BTN_RELEASE_DELAY);
+            // the press is debounced in the background: the button is left disabled until it has been released and settled
+            schedStart(&scheduler, TASK_PWR_BTN_RELEASE, PWR_BTN_PRESS_TICKS, 1);
+
+            // keypad events queued before the power state changed are stale either way
+            mtrxKeypadClearEvents(&geminiKeypad);
+#if (MTRX_BITMAP_SCAN)
+            chordKeys = 0;
+#endif
+#if (MTRX_TYPEMATIC)
+            repeatedKeys = 0;
+#endif
+
+#if (LATENCY_PROFILE)
+            // the profile view is not kept through a power state change
+            if (profViewPage)
+            {
+                profViewPage = 0;
+                restoreDispRows(&sevSegDispArr, rowValues);
+            }
+#endif
 
             // enter power OFF state, without resetting any stored display/LED states
             if (currSysState & FLAG_PWR_OFF)
             {
-                currSysState &= ~(FLAG_RATE_EDIT | FLAG_VTBI_EDIT | FLAG_PUMP_ACTIVE);
-
-                SEL_ALL_DISPS;
-                usciXNSpiPutChar(&USCIA0SPI, 0x00);
-                DSEL_ALL_DISPS;
-
-                SEL_LEDSR;
-                usciXNSpiPutChar(&USCIA0SPI, LED_PLUGPWR);
-                DSEL_LEDSR;
+                currSysState &= ~(UI_STATE_MASK | FLAG_LAMP_TEST | FLAG_COMPUTER_CTRL);  // back to UI_ON, under front panel control, for the next power on
+                cancelDispFlash();
+#if (COMPUTER_CONTROL)
+                ctrlDispMask = 0x00;
+#endif
+#if (DISP_DIMMING)
+                dimStop(&dimmer);   // the OFF state is never dimmed, so the power LED below must not be sent blank
+                ledCompInvalidate(&ledComp);    // and the LEDs may have been left blanked
+#endif
+                ledCompSetLayer(&ledComp, LEDC_LAYER_PWR, ALL_LEDS, OFF_LEDS, 0x00);
+                LEDC_CLEAR_LAYER(&ledComp, LEDC_LAYER_CTRL);
+                LEDC_CLEAR_LAYER(&ledComp, LEDC_LAYER_LAMP);
+#if (SUPPLY_MONITOR)
+                setSupplyLeds();
+#endif
+
+                writeSpiSlave(&USCIA0SPI, &DISPS_CSOUT, ALL_DISPS, 0x00);
+                commitLeds(&USCIA0SPI);
             }
             // enter power ON state, restoring previous display/LED states
             else
             {
-                refreshAllDisps(&USCIA0SPI, sevSegDispArr);
-
-                SEL_LEDSR;
-                usciXNSpiPutChar(&USCIA0SPI, currLedSRState);
-                DSEL_LEDSR;
+                currSysState &= ~FLAG_LAMP_TEST;    // the chord's release events were discarded with the rest
+                LEDC_CLEAR_LAYER(&ledComp, LEDC_LAYER_PWR);
+#if (SUPPLY_MONITOR)
+                setSupplyLeds();
+#endif
+                refreshAllDisps(&USCIA0SPI, &sevSegDispArr);
+                commitLeds(&USCIA0SPI);
 
                 enableKeypad();
+#if (DISP_DIMMING)
+                dimWake(&dimmer);
+#endif
             }
 
             // the power button flag should match in previous and current system states now that it has been handled
             prevSysState ^= ((prevSysState ^ currSysState) & FLAG_PWR_OFF);
-
-            KEYPAD_PWR_IFG &= ~KEYPAD_PWR_BTN;  // clear any unwanted power button flags
-            KEYPAD_PWR_IE |= KEYPAD_PWR_BTN;    // power button interrupts can now be enabled again
         }
+
+#if (WARM_RESTART)
+        // everything this pass changed has been committed, so this is a state the interface can resume from
+        saveWarmSnapshot(rowValues, ledComp.base);
+#endif
+
+        /* Sleep until an ISR signals a new event. Interrupts are disabled while checking for pending events, so an event
+         * can't be flagged between the check and entering a low power mode; setting GIE along with the LPM bits re-enables them.
+         * LPM3 keeps ACLK (VLOCLK) running for the debounce timer and scheduler tick, but stops SMCLK, so LPM0 is used while SPI writes are still queued
+         * (and always while LATENCY_PROFILE is enabled, as the profiler timer runs from SMCLK). */
+        __disable_interrupt();
+        if (!((currSysState ^ prevSysState) & FLAG_PWR_OFF) && !SCHED_TASKS_DUE(&scheduler) && !MTRX_KEY_EVENT_PENDING(&geminiKeypad) && CTRL_IDLE && SUPPLY_IDLE && DIMMER_IDLE)
+            __bis_SR_register(((SPI_TX_IDLE) ? LPM_IDLE_BITS : LPM0_bits) | GIE);
+        else
+            __enable_interrupt();
     }
 }
 
@@ -591,70 +1254,379 @@ void main(void)
 //########## CLIENT FUNCTIONS ##########//
 
 /************************************************************************************
-* Function: writeHexToSevSeg
+* Function: runUiTransition
 *
 * Description:
-*   Converts and writes the given hexCode to the specified display object over the
-*   desired SPI peripheral interface. The user must also provide the pin index of
-*   the chip select line to the display shift register within its output port; this
-*   allows for the most convenient way to address the display.
-*
-*   If the code is detected as invalid, a 1 is returned from this function
-*
-*   This function also checks that the display object is in an expected state to
-*   ensure nothing has gone wrong; nextBinSegCode and currBinSegCode should always
-*   be matching to represent a successful hexCode write to the display, and a steady
-*   state of displaying information. These two members could therefore be used to
-*   detect when a hexCode conversion has taken place, but the code has not yet been
-*   written to the display. Since this is all handled in this function, the two
-*   members should always match upon entry to this function; if this is not the case,
-*   the inconsistency is detected and the hexCode is not written to the display.
-*   A 2 is then returned from this function.
+*   Performs a key release's uiTable entry: the UI state is changed to the entry's
+*   next state, the entry's action is performed, and then the rows given by its
+*   flash parameters (if any) are flashed with flashDispRow. The edited row of the
+*   row actions is the one belonging to the new state.
+*
+*   LED actions only change *ledState; the main loop writes the LED shift register
+*   once the whole event has been handled.
 *
 * Arguments:
-*   *usciXN     -   pointer to the the USCI peripheral object
-*   *display    -   pointer to the 7seg display object
-*   hexCode     -   8-bit hexadecimal code to convert and write to the display
-*   csPortIndex -   the display SR's chip select pin within the chip select port
-*                   defined as a symbolic constant above (DISPS_CSOUT)
-*                   (example: P3.2 would have csPortIndex == 2)
+*   *displayArr -   pointer to the array of display objects
+*   *rowValues  -   pointer to the RATE (TOP_ROW) and VTBI (BOT_ROW) row values
+*   *ledState   -   pointer to the next state of the LED shift register
+*   *transition -   pointer to the uiTable entry to perform
 *
 * Returns:
-*   char errorCode; 0 if the write was successful and display state was normal,'
-*   1 if the given hexCode was invalid, 2 if the current and next binary segment
-*   codes were out of sync.
+*   (none)
 *
-* Author:       Mason Kury
-* Created:      November 10, 2022
-* Modified:     December 5, 2022
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
 ************************************************************************************/
-static unsigned char writeHexToSevSeg(const USCIXNSPI *const usciXN, SEVEN_SEG_DISP *const display, const unsigned char hexCode, const unsigned char csPortIndex)
+static void runUiTransition(SEVEN_SEG_ARR *const displayArr, DISP_ROW_VALUE *const rowValues, unsigned char *const ledState, const UI_TRANSITION *const transition)
 {
-    unsigned char errorCode = 0;
+    unsigned char rowDataBuff[4];       // packed row; see writeToDispRow for the format
+    unsigned char editRow = UI_EDIT_ROW(transition->nextState);
+    unsigned char valueFlag;            // FLAG_RATE_VALUE or FLAG_VTBI_VALUE, for the edited row
+    const unsigned char *cycle;         // LEDs of the group being cycled, in order
+    unsigned char cycleMask;
+    unsigned char cycleIndex;
 
-    // check that the display is in an expected state
-    if (display->currBinSegCode == display->nextBinSegCode)
+    SET_UI_STATE(transition->nextState);
+
+    switch (transition->action)
     {
-        // write the hex code to the display, and convert to binary segment code
-        display->hexDigit = hexCode;
-        if (!hexToSevSeg(display))
+    case UI_ACT_EDIT_ROW:
+        // if there is no user-defined value for the row, set it to "[][]0[]"
+        valueFlag = (editRow == BOT_ROW) ? FLAG_VTBI_VALUE : FLAG_RATE_VALUE;
+        if (!(currSysState & valueFlag))
         {
-            // activate display's chip select, write the binary segment code over SPI, then deactivate chip select
-            DISPS_CSOUT |= (DISP0 << csPortIndex);
-            usciXNSpiPutChar(usciXN, (display->nextBinSegCode));
-            DISPS_CSOUT &= ~(DISP0 << csPortIndex);
+            rowValues[editRow] = (DISP_ROW_VALUE){0, 0};
+            renderDispRow(displayArr, &rowValues[editRow], editRow);
+            currSysState |= valueFlag;
+        }
+        break;
+
+    case UI_ACT_INC_DIGIT:
+        incDispRow(displayArr, &rowValues[editRow], transition->arg, editRow);
+        break;
+
+    case UI_ACT_CLEAR_ROW:
+        rowValues[editRow] = (DISP_ROW_VALUE){0, 0};
+        renderDispRow(displayArr, &rowValues[editRow], editRow);
+        break;
+
+    case UI_ACT_CLEAR_ALL:
+        // reset both rows to "----", and mark the LEDs to reset to pump, cc, and plug power
+        writeToRowBuff(rowDataBuff, DASH_CODE, 0, DASH_CODE, 0, DASH_CODE, 0, DASH_CODE, 0);
+        writeToDispRow(displayArr, rowDataBuff, TOP_ROW);
+        writeToDispRow(displayArr, rowDataBuff, BOT_ROW);
+        currSysState &= ~(FLAG_RATE_VALUE | FLAG_VTBI_VALUE);
+        *ledState = LED_PUMP | LED_CC | LED_PLUGPWR;
+        break;
+
+    case UI_ACT_LED_CYCLE:
+        cycle = ledCycles[transition->arg];
+        cycleMask = cycle[0] | cycle[1] | cycle[2];
+
+        // with exactly one of the group's LEDs lit, move on to the one after it (none after the last); otherwise, light only the first
+        for (cycleIndex = 0; (cycleIndex < LED_CYCLE_LEN) && (!(*ledState & cycleMask) || (cycle[cycleIndex] != (*ledState & cycleMask))); cycleIndex++);
+        *ledState &= ~cycleMask;
+        if (cycleIndex >= LED_CYCLE_LEN)
+            *ledState |= cycle[0];
+        else if (cycleIndex < (LED_CYCLE_LEN - 1))
+            *ledState |= cycle[cycleIndex + 1];
+        break;
+
+    case UI_ACT_LED_TOGGLE:
+        *ledState ^= transition->arg;
+        break;
+    }
+
+    if (UI_FLASH_COUNT(transition->flash))
+        flashDispRow(UI_FLASH_ROWS(transition->flash), UI_FLASH_COUNT(transition->flash));
+}
+
+/************************************************************************************
+* Function: writeSpiSlave
+*
+* Description:
+*   Writes a single byte to the shift register(s) selected by csMask within the
+*   given chip select output register. Multiple bits may be set in csMask to write
+*   the same byte to several shift registers at once.
+*
+*   If SPI_ASYNC_QUEUE is enabled in "spi.h", the byte is added to spiTxQueue and
+*   this function returns as soon as it has been queued; the USCI RX interrupt then
+*   asserts and releases the chip select on its own. If the queue is full, it is
+*   polled until an entry frees up. If global interrupts are disabled when this
+*   function is called, the queue is flushed before returning, as the ISR would
+*   otherwise never get a chance to send the byte. With LEDSR_USCIB0 enabled, a
+*   byte for the LED shift register goes to ledTxQueue and USCI_B0 instead, whatever
+*   usciXN is, so it is shifted out alongside any display bytes still queued.
+*
+*   If SPI_ASYNC_QUEUE is disabled, the chip select is managed here around a
+*   blocking spiA0PutChar call, so usciXN is not used.
+*
+*   With DISP_DAISY_CHAIN enabled, the byte is stored in frameBuf for each display
+*   in csMask (when csOut is &DISPS_CSOUT) or for the LED shift register (any other
+*   csOut), and the whole frame is shifted out with writeFrame instead; neither the
+*   async queue nor usciXN is used in this mode.
+*
+*   With DISP_DIMMING enabled, every write is sent as 0x00 while DIM_BLANKED, and
+*   the byte written to the LED shift register is kept in ledSRShown (or frameBuf),
+*   so writeDimPhase can relight it.
+*
+* Arguments:
+*   *usciXN     -   pointer to the the USCI peripheral object the byte is queued for (SPI_ASYNC_QUEUE only)
+*   *csOut      -   address of the chip select output register (DISPS_CSOUT or LEDSR_CSOUT)
+*   csMask      -   chip select bit(s) of the shift register(s) to write to
+*   txByte      -   the byte to write
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void writeSpiSlave(const USCIXNSPI *const usciXN, volatile unsigned char *const csOut, const unsigned char csMask, const unsigned char txByte)
+{
+#if (DISP_DAISY_CHAIN)
+    unsigned char dispIndex;
 
-            // what was previously nextBinSegCode is now currBinSegCode
-            display->currBinSegCode = display->nextBinSegCode;
+    (void)usciXN;   // the frame always goes out on USCI_A0, through spiA0TxBurst
+
+    if (csOut == &DISPS_CSOUT)
+    {
+        for (dispIndex = 0; dispIndex < NUM_DISPS; dispIndex++)
+        {
+            if (csMask & (DISP0 << dispIndex))
+                frameBuf[FRAME_DISP(dispIndex)] = txByte;
         }
-        else
-            errorCode = 1;
     }
-    // if the current and next codes didn't match before updating the hex code, there is something wrong
-    else if (display->nextBinSegCode != display->currBinSegCode)
-        errorCode = 2;
+    else
+        frameBuf[FRAME_LED] = txByte;
+
+    writeFrame();
+#else
+#if (SPI_ASYNC_QUEUE) && (LEDSR_USCIB0)
+    const USCIXNSPI *const bus = (csOut == &LEDSR_CSOUT) ? &USCIB0SPI : usciXN;
+    USCIXNSPI_QUEUE *const queue = (csOut == &LEDSR_CSOUT) ? &ledTxQueue : &spiTxQueue;
+#elif (SPI_ASYNC_QUEUE)
+    const USCIXNSPI *const bus = usciXN;
+    USCIXNSPI_QUEUE *const queue = &spiTxQueue;
+#endif
+#if (DISP_DIMMING)
+    const unsigned char outByte = (DIM_BLANKED(&dimmer)) ? 0x00 : txByte;
+
+    if (csOut == &LEDSR_CSOUT)
+        ledSRShown = txByte;
+#else
+    const unsigned char outByte = txByte;
+#endif
+
+#if (SPI_ASYNC_QUEUE)
+    while (usciXNSpiEnqueue(bus, queue, csOut, csMask, outByte))
+        usciXNSpiQueuePoll(bus, queue);
+
+    if (!(__get_interrupt_state() & GIE))
+        usciXNSpiQueueFlush(bus, queue);
+#else
+    (void)usciXN;   // blocking writes always go out on USCI_A0, through spiA0PutChar
+
+    HAL_PIN_SET(*csOut, csMask);
+    spiA0PutChar(outByte);
+    HAL_PIN_CLR(*csOut, csMask);
+#endif
+#endif
+}
 
-    return errorCode;
+#if (DISP_DAISY_CHAIN)
+/************************************************************************************
+* Function: writeFrame
+*
+* Description:
+*   Shifts the whole of frameBuf out to the cascaded registers in one
+*   spiA0TxBurst, with the frame chip select held for the entire burst;
+*   releasing it after the last bit has left latches every register at the same
+*   time, so the displays and LEDs never show a partially shifted frame. Bytes are
+*   reloaded into TXBUF as soon as it empties, so the frame goes out back to back.
+*
+*   With DISP_DIMMING enabled, a frame of zeroes (blankFrame) is shifted out
+*   instead while DIM_BLANKED; frameBuf is left holding the frame to relight.
+*
+* Arguments:
+*   (none)
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void writeFrame(void)
+{
+#if (DISP_DIMMING)
+    spiA0TxBurst((DIM_BLANKED(&dimmer)) ? blankFrame : frameBuf, FRAME_LEN, &FRAME_CSOUT, FRAME_CS);
+#else
+    spiA0TxBurst(frameBuf, FRAME_LEN, &FRAME_CSOUT, FRAME_CS);
+#endif
+}
+#endif
+
+/************************************************************************************
+* Function: composeDisps
+*
+* Description:
+*   Builds the next frame of the displays in displayArr's back frame (see
+*   SEVEN_SEG_ARR in "sevenSeg.h"), one layer over the next:
+*       1. the packed digit of every display, converted with sevSegArrRender
+*       2. displays blanked by a flash animation (dispBlankMask) are turned off
+*       3. under COMPUTER CONTROL, displays the computer has sent (ctrlDispMask)
+*          show its segment codes instead
+*       4. during the lamp test, every segment of every display is lit
+*   The front frame, which the displays are showing, is left alone.
+*
+* Arguments:
+*   *displayArr     -   pointer to the packed 7seg display array
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void composeDisps(SEVEN_SEG_ARR *const displayArr)
+{
+    unsigned char *const backFrame = SEVSEG_BACK(displayArr);
+    unsigned char dispIndex;
+    unsigned char dispBit;      // bit representing display dispIndex within the layer masks
+
+    sevSegArrRender(displayArr, NUM_DISPS);
+
+    for (dispIndex = 0, dispBit = DISP0; dispIndex < NUM_DISPS; dispIndex++, dispBit <<= 1)
+    {
+        if (dispBlankMask & dispBit)
+            backFrame[dispIndex] = 0x00;
+#if (COMPUTER_CONTROL)
+        if (ctrlDispMask & dispBit)
+            backFrame[dispIndex] = ctrlFrame.segCodes[dispIndex];
+#endif
+#if (MTRX_BITMAP_SCAN)
+        if (currSysState & FLAG_LAMP_TEST)
+            backFrame[dispIndex] = 0xFF;
+#endif
+    }
+}
+
+/************************************************************************************
+* Function: writeDispMask
+*
+* Description:
+*   Writes the back frame segment code of every display selected by dispMask, where
+*   bit n of dispMask represents display n (this matches the DISPn chip select bits).
+*   Displays that share an identical segment code are written together: their chip
+*   select bits are ORed into one DISPS_CSOUT mask, and the code is sent only once.
+*   This way, a full refresh of a "----" or blank frame costs a single SPI transfer,
+*   and most other frames only need a few.
+*
+*   This only writes out the frame; it is up to flushDisps and refreshAllDisps to
+*   compose the back frame beforehand, and swap the frames afterwards.
+*
+*   With DISP_DAISY_CHAIN enabled, every display in dispMask is stored in frameBuf
+*   instead, and the frame is shifted out once, whatever the segment codes are.
+*
+* Arguments:
+*   *usciXN         -   pointer to the the USCI peripheral object
+*   *displayArr     -   pointer to the packed 7seg display array
+*   dispMask        -   bit n set to write display n
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void writeDispMask(const USCIXNSPI *const usciXN, const SEVEN_SEG_ARR *const displayArr, unsigned char dispMask)
+{
+    const unsigned char *const backFrame = SEVSEG_BACK(displayArr);
+#if !(DISP_DAISY_CHAIN)
+    unsigned char groupMask;    // all pending displays sharing the segment code currently being sent
+    unsigned char segCode;
+#endif
+    unsigned char dispIndex;
+    unsigned char dispBit;      // bit representing display dispIndex within dispMask
+
+#if (DISP_DAISY_CHAIN)
+    (void)usciXN;   // the frame always goes out on USCI_A0 (see writeFrame)
+
+    // every display is in the same frame, so any number of them costs a single burst
+    for (dispIndex = 0, dispBit = DISP0; dispIndex < NUM_DISPS; dispIndex++, dispBit <<= 1)
+    {
+        if (dispMask & dispBit)
+            frameBuf[FRAME_DISP(dispIndex)] = backFrame[dispIndex];
+    }
+
+    if (dispMask)
+        writeFrame();
+#else
+    while (dispMask)
+    {
+        // the lowest pending display determines the next segment code to send
+        for (dispIndex = 0, dispBit = DISP0; !(dispMask & dispBit); dispIndex++, dispBit <<= 1);
+        segCode = backFrame[dispIndex];
+
+        // gather every other pending display with the same code (none of them can be below the current index)
+        for (groupMask = 0x00; dispIndex < NUM_DISPS; dispIndex++, dispBit <<= 1)
+        {
+            if ((dispMask & dispBit) && (backFrame[dispIndex] == segCode))
+                groupMask |= dispBit;
+        }
+
+        writeSpiSlave(usciXN, &DISPS_CSOUT, groupMask, segCode);
+        dispMask &= ~groupMask;
+    }
+#endif
+}
+
+/************************************************************************************
+* Function: flushDisps
+*
+* Description:
+*   Commits every edit made to the displays since the last commit. The next frame
+*   is composed into displayArr's back frame by composeDisps, only the displays
+*   whose segment code differs from the front frame are written (see
+*   sevSegArrDirtyMask in "sevenSeg.h"), and the frames are swapped, so the front
+*   frame always holds what the displays are showing. Changed displays sharing the
+*   same code are written together by writeDispMask.
+*
+*   Functions that edit the displays only set dispCommitPending; the main loop
+*   calls this once per pass, so edits made while handling several events are
+*   written together, and a row is never shown half-edited. Editing a single
+*   digit still costs a single SPI transfer, rather than the full refresh done by
+*   refreshAllDisps.
+*
+*   Please note that the comparison is made against the front frame, which may not
+*   match what is physically shown if displays were turned off with a manual SPI
+*   bus write; refreshAllDisps should still be used to restore displays in that case.
+*
+* Arguments:
+*   *usciXN         -   pointer to the the USCI peripheral object
+*   *displayArr     -   pointer to the packed 7seg display array
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void flushDisps(const USCIXNSPI *const usciXN, SEVEN_SEG_ARR *const displayArr)
+{
+#if (LATENCY_PROFILE)
+    unsigned int profStart = PROF_NOW();
+#endif
+
+    composeDisps(displayArr);
+    writeDispMask(usciXN, displayArr, sevSegArrDirtyMask(displayArr, NUM_DISPS));
+    SEVSEG_SWAP(displayArr);
+    dispCommitPending = 0;
+
+#if (LATENCY_PROFILE)
+    profRecord(&latencyProfile, PROF_STAGE_REFRESH, PROF_NOW() - profStart);
+#endif
 }
 
 /************************************************************************************
@@ -662,42 +1634,32 @@ static unsigned char writeHexToSevSeg(const USCIXNSPI *const usciXN, SEVEN_SEG_D
 *
 * Description:
 *   Writes given 4-digit hex data to the 4-display top/bottom row of the gemini
-*   interface, using calls to the writeHexToSevSeg function defined above.
-*   A true/false value representing the decimal ON/OFF state for each display in
-*   the row is present rowDataArr[n][1], while the hex data itself is located in
-*   rowDataArr[n][0]. This is important, as the decimal state must be set within
-*   the display object before calling writeHexToSevSeg -- the actual decoding function
-*   hexToSevSeg looks for this value within the object, which is passed by reference.
-*
-*   PLEASE NOTE: Though 'displayArr' is defined in the same way as 'display' in
-*   the writeHexToSevSeg function, it represents an ARRAY OF STRUCTURES, rather
-*   than just a pointer referencing a single structure (likely from the array.)
-*   This is more a requirement of conceptual understanding, as the function will
-*   effectively still be called the same way (by passing the address of the first
-*   element in the array, compared to the address of an individual struct object.)
+*   interface. packedRow[n] holds the hex digit and decimal ON/OFF state of display
+*   n in the row, packed as described for SEVSEG_PACK in "sevenSeg.h" (writeToRowBuff
+*   can be used to fill it). The packed bytes are stored in the display array, and
+*   the row is marked to be committed by the next flushDisps, so only the displays
+*   that have actually changed are written over SPI.
+*
+*   If any hex code in packedRow is invalid, none of the row is modified.
 *
 *   EXAMPLE: If you wanted to write "102.7" to the top row, you would pass the array
-*   {{1, 0}, {0, 0}, {2, 1}, {7, 0}} with parameter 'botRow' == 0
+*   {SEVSEG_PACK(1, 0), SEVSEG_PACK(0, 0), SEVSEG_PACK(2, 1), SEVSEG_PACK(7, 0)}
+*   with parameter 'botRow' == 0
 *
 * Arguments:
-*   *usciXN         -   pointer to the the USCI peripheral object
-*   *displayArr     -   pointer to the array of 7seg display objects
-*   *rowDataArr     -   pointer to the 2D array of hex codes and decimal states
+*   *displayArr     -   pointer to the packed 7seg display array
+*   *packedRow      -   pointer to the 4 packed hex codes and decimal states of the row
 *   botRow          -   0 to write to top disp row, nonzero to write to bottom disp row
 *
 * Returns:
 *   char errorCode; 0 if the write was successful and display state was normal,'
-*   1 if a given hexCode was invalid, 2 if the current and next binary segment
-*   codes were out of sync.
-*
-*   (NOTE: errorCode is based off of the return from writeHexToSevSeg; see function
-*   header above for further detail)
+*   1 if a given hexCode was invalid.
 *
 * Author:       Mason Kury
 * Created:      November 30, 2022
-* Modified:     November 30, 2022
+* Modified:     October 14, 2026
 ************************************************************************************/
-static unsigned char writeToDispRow(const USCIXNSPI *const usciXN, SEVEN_SEG_DISP *const displayArr, const unsigned char (*rowDataArr)[2], unsigned char botRow)
+static unsigned char writeToDispRow(SEVEN_SEG_ARR *const displayArr, const unsigned char *const packedRow, unsigned char botRow)
 {
     unsigned char errorCode = 0;
     unsigned char dispRowIndex;
@@ -705,19 +1667,20 @@ static unsigned char writeToDispRow(const USCIXNSPI *const usciXN, SEVEN_SEG_DIS
     // ensure botRow can only be 4 or 0
     if (botRow) botRow = 4;
 
-    for (dispRowIndex = 0; dispRowIndex < 4; dispRowIndex ++)
+    // make sure every hex code can be converted before touching the row (OFF_CODE and DASH_CODE are the highest valid codes)
+    for (dispRowIndex = 0; dispRowIndex < 4; dispRowIndex++)
     {
-        // the decimal state of each display is on each odd number of dispRowArr
-        if (rowDataArr[dispRowIndex][1])
-            (displayArr[dispRowIndex + botRow]).dp = 1;
-        else
-            (displayArr[dispRowIndex + botRow]).dp = 0;
+        if (SEVSEG_DIGIT(packedRow[dispRowIndex]) > DASH_CODE)
+            errorCode = 1;
+    }
 
-        // write data at the current index in rowDataArr to the corresponding display within the specified top or bottom row
-        errorCode = writeHexToSevSeg(usciXN, &displayArr[dispRowIndex + botRow], rowDataArr[dispRowIndex][0], (dispRowIndex + botRow));
+    if (!errorCode)
+    {
+        for (dispRowIndex = 0; dispRowIndex < 4; dispRowIndex++)
+            displayArr->digits[dispRowIndex + botRow] = packedRow[dispRowIndex];
 
-        if (errorCode)
-            break;
+        // only the displays that changed are written, once the main loop commits them
+        dispCommitPending = 1;
     }
 
     return errorCode;
@@ -779,217 +1742,234 @@ static unsigned char writeToDispRow(const USCIXNSPI *const usciXN, SEVEN_SEG_DIS
 *       "9 0 2. 3   --> 100 --> "1 0 0 2" on bottom row
 *       "9 9 2 3"   --> 100 --> "[]2 3 []" (only possible on bottom row)
 *
+*   The increment is done arithmetically on the row's DISP_ROW_VALUE, which is
+*   the source of truth for the row; the new value is then drawn with a single
+*   renderDispRow call, so only the displays that changed are written over SPI.
+*
 * Arguments:
-*   *usciXN         -   pointer to the the USCI peripheral object
-*   *displayArr     -   pointer to the array of 7seg display objects
+*   *displayArr     -   pointer to the packed 7seg display array
+*   *rowValue       -   pointer to the numeric value of the row being incremented
 *   digitPos        -   a value from 0 to 3 representing the hundreds to tenths place respectively
 *   botRow          -   0 to write to top disp row, nonzero to write to bottom disp row
 *
 * Returns:
-*   char errorCode; 0 if the increment was successful and display state was normal,'
-*   1 if a given hexCode was invalid, 2 if the current and next binary segment
-*   codes were out of sync, 3 if the given digitPos was invalid.
-*
-*   (NOTE: errorCode is based off of the return from writeHexToSevSeg; see function
-*   header above for further detail)
+*   char errorCode; 0 if the increment was successful, 3 if the given digitPos
+*   was invalid.
 *
 * Author:       Mason Kury
 * Created:      December 2, 2022
-* Modified:     December 5, 2022
+* Modified:     October 14, 2026
 ************************************************************************************/
-static unsigned char incDispRow(const USCIXNSPI *const usciXN, SEVEN_SEG_DISP *const displayArr, const unsigned char digitPos, const unsigned char botRow)
+static unsigned char incDispRow(SEVEN_SEG_ARR *const displayArr, DISP_ROW_VALUE *const rowValue, const unsigned char digitPos, const unsigned char botRow)
 {
-    unsigned char errorCode;
-    unsigned char dispRowIndex;     // holds the index of the target digit with displayArr, offset to address the appropriate row based on the value of botRow
-    unsigned char nextHexCode;      // stores the target digit's hexDigit + 1, or the resulting code after rolling over from 0x9
+    unsigned char errorCode = 0;
+    unsigned char digits[4];        // thousands, hundreds, tens, and ones digits of the row's whole value
     unsigned char thousandState;    // used to change the behaviour of an increment when a display row value is >= 1000
 
-    // ensure digitPos is valid, else throw errorCode 3
-    if (digitPos <= TENTHS_PLACE)
+    getRowDigits(rowValue->whole, digits);
+    thousandState = (digits[0] != 0) ? 1 : 0;
+
+    switch (digitPos)
     {
-        dispRowIndex = (botRow) ? (digitPos + 4) : digitPos;    // offset by an index of 4 when addressing the bottom row
+    case HUNDREDS_PLACE:
+        if (thousandState)
+        {
+            if (rowValue->whole >= 9900)
+                rowValue->whole -= 9900;                // rolling out of thousands state (from >= 9900 to >= 0), keeping the tens and ones
+            else
+                rowValue->whole += 100;                 // the hundreds place carries into the thousands place
+        }
+        else if (digits[1] < 9)
+            rowValue->whole += 100;
+        else if (!botRow)
+            rowValue->whole -= 900;                     // rolling back out of hundreds on the top row (from >= 900 to >= 0)
+        else
+        {
+            rowValue->whole += 100;                     // rolling over into thousands (from >= 900 to >= 1000); the tenths place is dropped
+            rowValue->tenth = 0;
+        }
+        break;
 
-        // a display value >= 1000 can be detected if there is no decimal place present, and there is a digit being displayed in the normal tenth place
-        // in the case of a thousand state, shift the display index to the right by 1 place
-        if (botRow)
-            thousandState = (((displayArr[6]).dp) == 0 && ((displayArr[7]).hexDigit) != OFF_CODE) ? 1 : 0;
+    case TENS_PLACE:
+        if (digits[2] < 9)
+            rowValue->whole += 10;
         else
-            thousandState = (((displayArr[2]).dp) == 0 && ((displayArr[3]).hexDigit) != OFF_CODE) ? 1 : 0;
+            rowValue->whole -= 90;
+        break;
 
-        dispRowIndex += thousandState;
-        nextHexCode = (displayArr[dispRowIndex]).hexDigit + 1;  // store and increment the target digit's hex code
+    case ONES_PLACE:
+        if (digits[3] < 9)
+            rowValue->whole += 1;
+        else
+            rowValue->whole -= 9;
+        break;
 
-        switch (digitPos)
+    case TENTHS_PLACE:
+        if (thousandState)
         {
-        case HUNDREDS_PLACE:
-            if (nextHexCode > 0x9 && (nextHexCode - 1) != OFF_CODE)
-            {
-                // rolling back out of hundreds on the top row (from >= 900 to >= 0)
-                if (!botRow)
-                {
-                    // ensure the tens place is turned off as well as the hundreds place if the tens value was 0
-                    if ((displayArr[(unsigned int)(dispRowIndex + 1)]).hexDigit == 0x0)
-                        (displayArr[(unsigned int)(dispRowIndex + 1)]).hexDigit = OFF_CODE;
-                    nextHexCode = OFF_CODE;
-                }
-                // rolling over into thousands (from >= 900 to >= 1000)
-                else if (!thousandState)
-                {
-                    (displayArr[(unsigned int)(dispRowIndex + 3)]).hexDigit = (displayArr[(unsigned int)(dispRowIndex + 2)]).hexDigit;      // copy the previous ones value to the new ones place
-                    (displayArr[(unsigned int)(dispRowIndex + 2)]).hexDigit = (displayArr[(unsigned int)(dispRowIndex + 1)]).hexDigit;      // copy the previous tens value to the new tens place
-                    (displayArr[(unsigned int)(dispRowIndex + 2)]).dp = 0;                                                                  // clear any previous decimal point in the new tens place
-                    (displayArr[(unsigned int)(dispRowIndex + 1)]).hexDigit = 0x0;                                                          // set the new hundreds place to 0
-                    nextHexCode = 0x1;                                                                                                      // set the new thousands place to 1
-                }
-                // rolling out of thousands state (from >= 9900 to >= 0)
-                else if (thousandState && (displayArr[(unsigned int)(dispRowIndex - 1)]).hexDigit == 0x9)
-                {
-                    if ((displayArr[(unsigned int)(dispRowIndex + 1)]).hexDigit == 0x0)
-                        (displayArr[(unsigned int)(dispRowIndex)]).hexDigit = OFF_CODE;                                                     // turn off the tens place if it was 0
-                    else
-                        (displayArr[(unsigned int)(dispRowIndex)]).hexDigit = (displayArr[(unsigned int)(dispRowIndex + 1)]).hexDigit;      // otherwise copy the previous tens value to the new tens place
-                    (displayArr[(unsigned int)(dispRowIndex + 1)]).hexDigit = (displayArr[(unsigned int)(dispRowIndex + 2)]).hexDigit;      // copy the previous ones value to the new ones place
-                    (displayArr[(unsigned int)(dispRowIndex + 2)]).hexDigit = OFF_CODE;                                                     // clear the current ones place so it can be the tenths place again
-                    dispRowIndex -= 1;                                                                                                      // officially exit the thousand state
-                    nextHexCode = OFF_CODE;                                                                                                 // ensure the new hundreds place is cleared
-                }
-                // rolling over into the next thousand
-                else
-                {
-                    (displayArr[(unsigned int)(dispRowIndex - 1)]).hexDigit++;  // increment the thousands place
-                    nextHexCode = 0x0;                                          // reset the hundreds place to 0
-                }
-            }
-            else
-            {
-                if ((nextHexCode - 1) == OFF_CODE)
-                    nextHexCode = 0x1;
-
-                // the tens and ones place must always be at least 0 when the hundreds or thousands place has a value
-                if ((displayArr[(unsigned int)(dispRowIndex + 1)]).hexDigit == OFF_CODE)
-                    (displayArr[(unsigned int)(dispRowIndex + 1)]).hexDigit = 0x0;
-                if ((displayArr[(unsigned int)(dispRowIndex + 2)]).hexDigit == OFF_CODE)
-                    (displayArr[(unsigned int)(dispRowIndex + 2)]).hexDigit = 0x0;
-            }
-            break;
-
-        case TENS_PLACE:
-            if ((nextHexCode - 1) == OFF_CODE)                                              // if previously OFF, increment straight to 0x1
-                nextHexCode = 0x1;
-            else if (nextHexCode > 0x9)
-                if ((displayArr[(unsigned int)(dispRowIndex - 1)]).hexDigit == OFF_CODE)    // if rolling over from 9 and the hundreds place is OFF, turn OFF as well
-                    nextHexCode = OFF_CODE;
-                else                                                                        // if rolling over from 9 and the hundreds place has a value, roll back to 0
-                    nextHexCode = 0x0;
-            break;
-
-        case ONES_PLACE:
-            if (nextHexCode > 0x9)
-                nextHexCode = 0x0;
-            break;
-
-        case TENTHS_PLACE:
-            if (thousandState)
-            {
-                dispRowIndex -= 1;                                                                                                      // leave the thousands state upon a tenth button press
-
-                if ((displayArr[(unsigned int)(dispRowIndex - 2)]).hexDigit == 0x0)
-                    (displayArr[(unsigned int)(dispRowIndex - 3)]).hexDigit = OFF_CODE;                                                 // turn off the hundreds place if it was 0
-                else
-                    (displayArr[(unsigned int)(dispRowIndex - 3)]).hexDigit = (displayArr[(unsigned int)(dispRowIndex - 2)]).hexDigit;  // otherwise copy the previous hundreds value to the new hundreds place
-
-                if ((displayArr[(unsigned int)(dispRowIndex - 1)]).hexDigit == 0x0)
-                    if ((displayArr[(unsigned int)(dispRowIndex - 3)]).hexDigit == OFF_CODE)
-                        (displayArr[(unsigned int)(dispRowIndex - 2)]).hexDigit = OFF_CODE;                                             // turn off the tens place if both it and the hundreds place are 0
-                    else
-                        (displayArr[(unsigned int)(dispRowIndex - 2)]).hexDigit = 0x0;                                                  // otherwise display 0 if the hundreds place has a value
-                else
-                    (displayArr[(unsigned int)(dispRowIndex - 2)]).hexDigit = (displayArr[(unsigned int)(dispRowIndex - 1)]).hexDigit;  // otherwise copy the previous tens value to the new tens place
-
-                (displayArr[(unsigned int)(dispRowIndex - 1)]).hexDigit = (displayArr[(unsigned int)(dispRowIndex)]).hexDigit;          // copy the previous ones value to the new ones place
-            }
+            rowValue->whole -= (unsigned int)digits[0] * 1000;  // leave the thousands state upon a tenth button press, dropping the thousands place
+            rowValue->tenth = 1;
+        }
+        else if (rowValue->tenth < 9)
+            rowValue->tenth++;
+        else
+            rowValue->tenth = 0;
+        break;
 
-            if ((nextHexCode - 1) == OFF_CODE || thousandState)
-            {
-                nextHexCode = 0x1;
-                (displayArr[(unsigned int)(dispRowIndex - 1)]).dp = 1;
-            }
+    default:
+        errorCode = 3;  // invalid digitPos
+        break;
+    }
 
-            else if (nextHexCode > 0x9)
-            {
-                nextHexCode = OFF_CODE;
-                (displayArr[(unsigned int)(dispRowIndex - 1)]).dp = 0;
-            }
-            break;
-        }
+    if (!errorCode)
+        renderDispRow(displayArr, rowValue, botRow);
 
-        // write the incremented hex value to the indexed display, and ensure any other modified hexDigits are refreshed
-        errorCode = writeHexToSevSeg(usciXN, &displayArr[dispRowIndex], nextHexCode, dispRowIndex);
-        refreshAllDisps(usciXN, displayArr);
+    return errorCode;
+}
+
+/************************************************************************************
+* Function: renderDispRow
+*
+* Description:
+*   Formats a numeric row value into the 4 displays of the top/bottom row, then
+*   marks the row to be committed by the next flushDisps, so only the displays that
+*   have actually changed are written over SPI.
+*
+*   Values below 1000 are drawn as hundreds, tens, and ones in the first three
+*   displays, with leading zeros blanked (the ones place is always shown), and the
+*   tenths digit in the fourth display; the decimal point on the ones place is lit
+*   only when a tenths digit is present. Values of 1000 or more fill all four
+*   displays with no decimal point.
+*
+*   EXAMPLE: {102, 7} is drawn as "1 0 2. 7", {5, 0} as "[][]5 []", and {1023, 0}
+*   as "1 0 2 3"
+*
+* Arguments:
+*   *displayArr     -   pointer to the packed 7seg display array
+*   *rowValue       -   pointer to the numeric value to draw
+*   botRow          -   0 to write to top disp row, nonzero to write to bottom disp row
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void renderDispRow(SEVEN_SEG_ARR *const displayArr, const DISP_ROW_VALUE *const rowValue, unsigned char botRow)
+{
+    unsigned char *rowDigits;       // packed digit of the first display of the row being drawn
+    unsigned char digits[4];        // thousands, hundreds, tens, and ones digits of the row's whole value
+    unsigned char digitIndex;
+    unsigned char leadingBlank;     // set while only zeros have been found in the digits above the ones place
+
+    // ensure botRow can only be 4 or 0
+    if (botRow) botRow = 4;
+    rowDigits = &(displayArr->digits[botRow]);
+
+    getRowDigits(rowValue->whole, digits);
+
+    // in the thousands state, every digit is shown and the row is shifted to the right by 1 place
+    if (digits[0])
+    {
+        for (digitIndex = 0; digitIndex < 4; digitIndex++)
+            rowDigits[digitIndex] = SEVSEG_PACK(digits[digitIndex], 0);
     }
     else
-        errorCode = 3;  // invalid digitPos
+    {
+        leadingBlank = 1;
+        for (digitIndex = 0; digitIndex < 3; digitIndex++)
+        {
+            leadingBlank &= (digits[digitIndex + 1] == 0 && digitIndex < 2) ? 1 : 0;
+            rowDigits[digitIndex] = SEVSEG_PACK((leadingBlank) ? OFF_CODE : digits[digitIndex + 1], 0);
+        }
 
-    return errorCode;
+        rowDigits[2] |= (rowValue->tenth) ? SEVSEG_DP_BIT : 0x00;
+        rowDigits[3] = SEVSEG_PACK((rowValue->tenth) ? rowValue->tenth : OFF_CODE, 0);
+    }
+
+    dispCommitPending = 1;
+}
+
+/* splits a whole row value (0 to 9999) into its thousands, hundreds, tens, and ones digits;
+ * this is done by repeated subtraction, as the MSP430G2353 has no hardware multiplier for the compiler's division routines to use */
+static void getRowDigits(unsigned int whole, unsigned char *const digits)
+{
+    static const unsigned int placeValues[4] = {1000, 100, 10, 1};
+    unsigned char digitIndex;
+
+    for (digitIndex = 0; digitIndex < 4; digitIndex++)
+    {
+        digits[digitIndex] = 0;
+        while (whole >= placeValues[digitIndex])
+        {
+            whole -= placeValues[digitIndex];
+            digits[digitIndex]++;
+        }
+    }
 }
 
 /************************************************************************************
 * Function: refreshAllDisps
 *
 * Description:
-*   Simply rewrites the contents of the currBinSegCode member of a SEVEN_SEG_DISP
-*   object within the displayArr to the appropriate seven segment display.
+*   Simply rewrites every display within the displayArr with its composed segment
+*   code, committing any pending edits along the way.
 *   This is intended to allow you to turn off various displays with a manual SPI
 *   bus write, but not clear the previously displayed contents of the interface;
 *   upon turning back on, calling this function easily restores the previous contents.
 *
-*   For each display, the hexDigit member is re-converted into binary segment code,
-*   and the currentBinSegCode is ensured to match the nextBinSegCode for consistency.
-*   In addition to the functionality described above, this makes it possible to write
-*   hex codes to multiple display objects and call this function once to update them.
+*   The back frame is re-composed by composeDisps, and swapped in as the front frame
+*   once written, for consistency. In addition to the
+*   functionality described above, this makes it possible to write hex codes to
+*   multiple displays and call this function once to update them.
+*   Displays showing the same segment code are written together with one SPI transfer
+*   through writeDispMask, so a frame of "----" only costs a single write.
 *
-*   Please note that this function does not check the hexDigit member value before
+*   Please note that this function does not check the packed digit values before
 *   attempting a segment code conversion, so it may be harder to debug than
-*   writeHexToSevSeg; additionally, because this function updates all displays
-*   even if they are already displaying their stored values, it may be less efficient
-*   than multiple calls to writeHexToSevSeg.
+*   writeToDispRow; additionally, because this function updates all displays
+*   even if they are already displaying their stored values, it is less efficient
+*   than flushDisps, and should only be used when the displays may not be showing
+*   their front frame (after being turned off with a manual write, for example).
 *
 * Arguments:
 *   *usciXN         -   pointer to the the USCI peripheral object
-*   *displayArr     -   pointer to the array of 7seg display objects
+*   *displayArr     -   pointer to the packed 7seg display array
 *
 * Returns:
 *   (none)
 *
 * Author:       Mason Kury
 * Created:      November 30, 2022
-* Modified:     December 1, 2022
+* Modified:     October 14, 2026
 ************************************************************************************/
-static void refreshAllDisps(const USCIXNSPI *const usciXN, SEVEN_SEG_DISP *const displayArr)
+static void refreshAllDisps(const USCIXNSPI *const usciXN, SEVEN_SEG_ARR *const displayArr)
 {
-    unsigned char dispIndex;
-
-    for (dispIndex = 0; dispIndex < NUM_DISPS; dispIndex++)
-    {
-        hexToSevSeg(&displayArr[dispIndex]);
-        (displayArr[dispIndex]).currBinSegCode = (displayArr[dispIndex]).nextBinSegCode;
-        DISPS_CSOUT |= (DISP0 << dispIndex);
-        usciXNSpiPutChar(usciXN, ((displayArr[dispIndex]).currBinSegCode));
-        DISPS_CSOUT &= ~(DISP0 << dispIndex);
-    }
+#if (LATENCY_PROFILE)
+    unsigned int profStart = PROF_NOW();
+#endif
+
+    // every display is rewritten regardless of what it should be showing
+    composeDisps(displayArr);
+    writeDispMask(usciXN, displayArr, ALL_DISPS);
+    SEVSEG_SWAP(displayArr);
+    dispCommitPending = 0;
+
+#if (LATENCY_PROFILE)
+    profRecord(&latencyProfile, PROF_STAGE_REFRESH, PROF_NOW() - profStart);
+#endif
 }
 
 /************************************************************************************
 * Function: writeToRowBuff
 *
 * Description:
-*   A simple, very specific function to completely reassign all values of a 4x2 array
-*   at once, intended to have the same format as described in the writeToDispRow
-*   function header. The main purpose of this function is to keep code organized
+*   A simple, very specific function to completely reassign all 4 packed bytes of a
+*   row buffer at once, in the format described in the writeToDispRow function header. The main purpose of this function is to keep code organized
 *   leading up to a writeToDispRow call, which also exists to make code more readable.
 *
 * Arguments:
-*   *rowBuff        -   pointer to the 2D array
+*   *rowBuff        -   pointer to the 4-byte packed row buffer
     dat0...dat3     -   hex codes to write to the respective displays
     dp0...dp3       -   0 for no decimal, nonzero for an active decimal point
 
@@ -1000,35 +1980,35 @@ static void refreshAllDisps(const USCIXNSPI *const usciXN, SEVEN_SEG_DISP *const
 *
 * Author:       Mason Kury
 * Created:      November 30, 2022
-* Modified:     December 1, 2022
+* Modified:     October 14, 2026
 ************************************************************************************/
-static void writeToRowBuff(unsigned char (*const rowBuff)[2], const unsigned char dat0, const unsigned char dp0, const unsigned char dat1, const unsigned char dp1,
+static void writeToRowBuff(unsigned char *const rowBuff, const unsigned char dat0, const unsigned char dp0, const unsigned char dat1, const unsigned char dp1,
                     const unsigned char dat2, const unsigned char dp2, const unsigned char dat3, const unsigned char dp3)
 {
-    rowBuff[0][0] = dat0;
-    rowBuff[0][1] = dp0;
-    rowBuff[1][0] = dat1;
-    rowBuff[1][1] = dp1;
-    rowBuff[2][0] = dat2;
-    rowBuff[2][1] = dp2;
-    rowBuff[3][0] = dat3;
-    rowBuff[3][1] = dp3;
+    rowBuff[0] = SEVSEG_PACK(dat0, dp0);
+    rowBuff[1] = SEVSEG_PACK(dat1, dp1);
+    rowBuff[2] = SEVSEG_PACK(dat2, dp2);
+    rowBuff[3] = SEVSEG_PACK(dat3, dp3);
 }
 
 /************************************************************************************
 * Function: flashDispRow
 *
 * Description:
-*   Flashes the top/bottom row(s) of displays a given number of times based on the
-*   DISP_FLASH_DELAY interval defined at the top of this client. Flashing is
-*   accomplished by clearing the specified row of displays with a manual SPI bus write,
-*   then later calling the refreshAllDisps function to restore their previous contents.
-*   No additional delay interval is added after restoring the row contents for the last
-*   time in the loop.
+*   Starts flashing the top/bottom row(s) of displays a given number of times, then
+*   returns immediately; the flash runs in the background, so keypad events keep
+*   being handled while it is in progress. Each phase lasts DISP_FLASH_TICKS, timed
+*   by the scheduler's TASK_DISP_FLASH, which has the main loop call serviceDispFlash.
+*
+*   The row is blanked (through dispBlankMask) by the next commit. Each following
+*   phase alternately restores the row and blanks it again, ending with the row
+*   restored; no additional delay is added after restoring the row for the last time.
+*   Any edits made to a blanked row while flashing are shown as soon as it is restored.
+*
+*   Starting a flash while another is still in progress cancels the previous one;
+*   any displays it left blanked are restored unless they are part of the new flash.
 *
 * Arguments:
-*   *usciXN         -   pointer to the the USCI peripheral object
-*   *displayArr     -   pointer to the array of 7seg display objects
     rowSel          -   0 for top row, 1 for bottom row, else for both rows
     numFlashes      -   number of times to flash the row (must be > 0)
 *
@@ -1037,12 +2017,11 @@ static void writeToRowBuff(unsigned char (*const rowBuff)[2], const unsigned cha
 *
 * Author:       Mason Kury
 * Created:      November 31, 2022
-* Modified:     December 1, 2022
+* Modified:     October 14, 2026
 ************************************************************************************/
-static void flashDispRow(const USCIXNSPI *const usciXN, SEVEN_SEG_DISP *const displayArr, const unsigned char rowSel, const unsigned char numFlashes)
+static void flashDispRow(const unsigned char rowSel, const unsigned char numFlashes)
 {
     unsigned char row;
-    unsigned char flashIndex;
 
     if (rowSel == TOP_ROW)
         row = TOP_DISPS;
@@ -1053,19 +2032,188 @@ static void flashDispRow(const USCIXNSPI *const usciXN, SEVEN_SEG_DISP *const di
     else
         row = ALL_DISPS;
 
-    for (flashIndex = 0; flashIndex < numFlashes; flashIndex++)
+    cancelDispFlash();
+
+    // blank the row on this pass's commit, which also restores anything the previous flash left blanked
+    flashRowMask = row;
+    dispBlankMask = row;
+    dispCommitPending = 1;
+
+    // the first blank phase has already started; each flash is a blank phase followed by a restore phase
+    flashPhasesLeft = (numFlashes << 1) - 1;
+
+    // schedule the following phases; serviceDispFlash stops the task after the last one
+    schedStart(&scheduler, TASK_DISP_FLASH, DISP_FLASH_TICKS, DISP_FLASH_TICKS);
+}
+
+/************************************************************************************
+* Function: serviceDispFlash
+*
+* Description:
+*   Runs the next phase of the flash started by flashDispRow; this should be called
+*   by the main loop whenever TASK_DISP_FLASH is due. If the flashing row is
+*   blanked, it is restored; otherwise, it is blanked again. Either way, the change
+*   is written by the main loop's next commit.
+*   The task is stopped once the final phase has been run.
+*
+* Arguments:
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void serviceDispFlash(void)
+{
+    // a due task left over from a cancelled flash has nothing to do
+    if (flashPhasesLeft)
+    {
+        dispBlankMask = (dispBlankMask) ? 0x00 : flashRowMask;
+        dispCommitPending = 1;
+
+        if (--flashPhasesLeft == 0)
+            schedStop(&scheduler, TASK_DISP_FLASH);
+    }
+}
+
+// stops any flash in progress; the displays it left blanked are restored by the next commit
+static void cancelDispFlash()
+{
+    schedStop(&scheduler, TASK_DISP_FLASH);
+    flashPhasesLeft = 0;
+    if (dispBlankMask)
+    {
+        dispBlankMask = 0x00;
+        dispCommitPending = 1;
+    }
+}
+
+#if (MTRX_BITMAP_SCAN)
+// lights every LED for the lamp test (ending any display flash), or hands them back to the layers beneath afterwards; composeDisps lights every display segment while FLAG_LAMP_TEST is set
+static void setLampTest(const unsigned char lampOn)
+{
+    if (lampOn)
+    {
+        cancelDispFlash();
+        ledCompSetLayer(&ledComp, LEDC_LAYER_LAMP, ALL_LEDS, ALL_LEDS, 0x00);
+    }
+    else
+        LEDC_CLEAR_LAYER(&ledComp, LEDC_LAYER_LAMP);
+
+    dispCommitPending = 1;
+}
+#endif
+
+/************************************************************************************
+* Function: commitLeds
+*
+* Description:
+*   Writes the LED shift register with the state composed by ledComp, if it has
+*   changed since it was last written. TASK_LED_BLINK is then started if an LED has
+*   just started blinking, or stopped once none are, so the blink is only timed
+*   while it can be seen. This is the only place the LED shift register is written
+*   from, apart from writeDimPhase's blanking and relighting.
+*
+* Arguments:
+*   *usciXN     -   pointer to the the USCI peripheral object
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void commitLeds(const USCIXNSPI *const usciXN)
+{
+    if (!ledCompUpdate(&ledComp))
+        writeSpiSlave(usciXN, &LEDSR_CSOUT, LEDSR, LEDC_SHOWN(&ledComp));
+
+    if (LEDC_BLINKING(&ledComp))
     {
-        DISPS_CSOUT |= row;
-        usciXNSpiPutChar(usciXN, 0x00);
-        DISPS_CSOUT &= ~row;
-        __delay_cycles(DISP_FLASH_DELAY);
+        if (!SCHED_TASK_ARMED(&scheduler, TASK_LED_BLINK))
+            schedStart(&scheduler, TASK_LED_BLINK, LED_BLINK_TICKS, LED_BLINK_TICKS);
+    }
+    else if (SCHED_TASK_ARMED(&scheduler, TASK_LED_BLINK))
+        schedStop(&scheduler, TASK_LED_BLINK);
+}
+
+#if (SUPPLY_MONITOR)
+// has the power LEDs show the measured supply, over the UI's LED state (and the OFF state); with BATT_LED_BLINK, the battery power LED blinks while ON
+static void setSupplyLeds(void)
+{
+    const unsigned char blink = ((BATT_LED_BLINK) && !(currSysState & FLAG_PWR_OFF)) ? LED_BATTPWR : 0x00;
+
+    ledCompSetLayer(&ledComp, LEDC_LAYER_SUPPLY, SUPPLY_LEDS, OFF_LEDS, blink);
+}
+#endif
+
+#if (DISP_DIMMING)
+/************************************************************************************
+* Function: writeDimPhase
+*
+* Description:
+*   Blanks or relights the displays and the LED shift register, once dimPopPhase
+*   reports that the dimmer has changed part of its period. Writes are sent blank
+*   (0x00) while DIM_BLANKED (see writeSpiSlave), so every register holds 0x00 from
+*   the blanking write until the relight, and only the registers that show anything
+*   are written either way. Blanking turns the lit displays of the front frame off
+*   with a single broadcast write. Relighting composes the next frame (committing
+*   any edits made on this pass), and writes only the displays whose segment code
+*   isn't 0x00. The LEDs are written as well, unless every LED is off.
+*
+*   With DISP_DAISY_CHAIN enabled, a single frame blanks or relights everything.
+*
+* Arguments:
+*   *usciXN         -   pointer to the the USCI peripheral object
+*   *displayArr     -   pointer to the packed 7seg display array
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void writeDimPhase(const USCIXNSPI *const usciXN, SEVEN_SEG_ARR *const displayArr)
+{
+#if (DISP_DAISY_CHAIN)
+    if (DIM_BLANKED(&dimmer))
+        writeFrame();
+    else
         refreshAllDisps(usciXN, displayArr);
+#else
+    const unsigned char *frame;
+    unsigned char litMask = 0x00;   // displays whose register doesn't hold 0x00 on one side of the phase
+    unsigned char dispIndex;
+
+    if (!DIM_BLANKED(&dimmer))
+        composeDisps(displayArr);
+    frame = (DIM_BLANKED(&dimmer)) ? SEVSEG_FRONT(displayArr) : SEVSEG_BACK(displayArr);
+
+    for (dispIndex = 0; dispIndex < NUM_DISPS; dispIndex++)
+    {
+        if (frame[dispIndex] != 0x00)
+            litMask |= DISP0 << dispIndex;
+    }
 
-        // no need to add a delay after refreshing the displays for the final time
-        if (flashIndex < (numFlashes - 1))
-            __delay_cycles(DISP_FLASH_DELAY);
+    if (DIM_BLANKED(&dimmer))
+    {
+        if (litMask)
+            writeSpiSlave(usciXN, &DISPS_CSOUT, litMask, 0x00);
     }
+    else
+    {
+        writeDispMask(usciXN, displayArr, litMask);
+        SEVSEG_SWAP(displayArr);
+        dispCommitPending = 0;
+    }
+
+    // sent blank while DIM_BLANKED, keeping ledSRShown as it is
+    if (ledSRShown)
+        writeSpiSlave(usciXN, &LEDSR_CSOUT, LEDSR, ledSRShown);
+#endif
 }
+#endif
 
 
 /************************************************************************************
@@ -1073,73 +2221,285 @@ static void flashDispRow(const USCIXNSPI *const usciXN, SEVEN_SEG_DISP *const di
 *
 * Description:
 *   An emergency panic function for the event of an impossibly unexpected situation.
-*   All maskable interrupts are disabled, LEDs are turned off, the (col,row)
-*   coordinates of the last known key press are displayed, and a message flashes
-*   letting the user know they should power off the device. A while loop polls
-*   for the press of the power button while the message flashes. Once the button is
-*   pressed, it is deboucned, and an invalid write to the WDTCTL register is done
-*   on purpose to initiate a PUC reset. An infinite loop is placed below the WDTCTL
-*   write as a final fail-safe to prevent further code from being run if the PUC
-*   doesn't occur for some reason.
+*   All maskable interrupts are disabled, LEDs are turned off, the given fault code
+*   is displayed, and a message flashes letting the user know they should power off
+*   the device. The power button is polled every FAULT_POLL_DELAY while the message
+*   flashes, which is FAULT_POLL_MS on the power-up DCO, so a press is caught even
+*   when this runs on it (where the flash and debounce delays here take about
+*   F_CPU/DCO_DEFAULT_HZ times as long). Once the button is pressed, it is
+*   deboucned, and an invalid write to the WDTCTL register is done on purpose to
+*   initiate a PUC reset. An infinite loop is placed below the WDTCTL write as a
+*   final fail-safe to prevent further code from being run if the PUC doesn't
+*   occur for some reason.
+*
+*   This may be called once the displays, LEDs, and power button have been set up
+*   in main, before the rest of the firmware is (as for FAULT_CLK_CAL).
+*
+*   With WARM_RESTART enabled, the interface then resumes from the snapshot saved
+*   at the end of the last main loop pass, without the startup delay.
 *
 * Arguments:
 *   *usciXN         -   pointer to the the USCI peripheral object
-*   *displayArr     -   pointer to the array of 7seg display objects
-*   *rowBuff        -   pointer to a 4x2 buffer array
+*   *displayArr     -   pointer to the packed 7seg display array
+*   faultCode       -   the FAULT_ code to display
 *
 * Returns:
 *   (none; DOES NOT RETURN)
 *
 * Author:       Mason Kury
 * Created:      November 31, 2022
-* Modified:     March 27, 2022
+* Modified:     October 14, 2026
 ************************************************************************************/
-static void criticalFaultHandler(const USCIXNSPI *const usciXN, SEVEN_SEG_DISP *const displayArr, unsigned char (*const rowBuff)[2])
+static void criticalFaultHandler(const USCIXNSPI *const usciXN, SEVEN_SEG_ARR *const displayArr, const unsigned char faultCode)
 {
-    // disable interrupts, as the power button is polled
-    __disable_interrupt();
+    unsigned char rowBuff[4];           // packed row; see writeToDispRow for the format
+    unsigned int pollsLeft;             // power button polls left in the current flash phase
+    unsigned char flashBlanked = 0;     // set while "0FF" is blanked
 
-    // clear all LEDs
-    SEL_LEDSR;
-    usciXNSpiPutChar(usciXN, 0x00);
-    DSEL_LEDSR;
+    // disable interrupts, as the power button is polled; nothing else is composed over the message, and nothing is dimmed
+    __disable_interrupt();
+#if (DISP_DIMMING)
+    dimStop(&dimmer);
+    ledCompInvalidate(&ledComp);    // the LEDs may have been left blanked
+#endif
+    cancelDispFlash();
+    currSysState &= ~(FLAG_LAMP_TEST | FLAG_COMPUTER_CTRL);
+#if (COMPUTER_CONTROL)
+    ctrlDispMask = 0x00;
+#endif
+
+    // clear all LEDs (with GIE cleared, queued SPI writes are flushed before writeSpiSlave returns); the blink is stopped along with them
+    ledCompSetLayer(&ledComp, LEDC_LAYER_FAULT, ALL_LEDS, 0x00, 0x00);
+    commitLeds(usciXN);
 
     // write to displays:
-    //  [E.]    [C.]    [(col)]  [(row)]
+    //  [E.]    [C.]    [(code)] [(code)]
     //  [(OFF)] [0]     [F]     [F]
-    // meaning "error corrdinate: (col,row); press power off
+    // meaning "error code: (code); press power off
     // 0FF flashes to suggest the power button is required to be pressed
-    writeToRowBuff(rowBuff, 0xE, 1, 0xC, 1, ((geminiKeypad.currKeyCoord & 0xF0) >> 4), 0, (geminiKeypad.currKeyCoord & 0x0F), 0);
-    writeToDispRow(usciXN, displayArr, rowBuff, TOP_ROW);
+    writeToRowBuff(rowBuff, 0xE, 1, 0xC, 1, (faultCode >> 4), 0, (faultCode & 0x0F), 0);
+    writeToDispRow(displayArr, rowBuff, TOP_ROW);
     writeToRowBuff(rowBuff, OFF_CODE, 0, 0x0, 0, 0xF, 0, 0xF, 0);
-    writeToDispRow(usciXN, displayArr, rowBuff, BOT_ROW);
+    writeToDispRow(displayArr, rowBuff, BOT_ROW);
+    flushDisps(usciXN, displayArr);     // the main loop won't be committing them
 
-    // flash "0FF" while waiting for power button press
+    // flash "0FF" while waiting for power button press, polling the button throughout each phase
     while(KEYPAD_PWR_IN & KEYPAD_PWR_BTN)
     {
-        __delay_cycles(DISP_FLASH_DELAY);
-        SEL_BOT_DISPS;
-        usciXNSpiPutChar(usciXN, 0x00);
-        DSEL_BOT_DISPS;
-        __delay_cycles(DISP_FLASH_DELAY);
-        refreshAllDisps(usciXN, displayArr);
+        for (pollsLeft = FAULT_FLASH_POLLS; pollsLeft && (KEYPAD_PWR_IN & KEYPAD_PWR_BTN); pollsLeft--)
+            __delay_cycles(FAULT_POLL_DELAY);
+        if (pollsLeft)
+            break;  // pressed; the message is left as it is
+
+        flashBlanked ^= 1;
+        if (flashBlanked)
+            writeSpiSlave(usciXN, &DISPS_CSOUT, BOT_DISPS, 0x00);
+        else
+            refreshAllDisps(usciXN, displayArr);
     }
     // debounce press, wait for power button release, then debounce the release
     __delay_cycles(PWR_BTN_PRESS_DELAY);
-    while(!(KEYPAD_PWR_IN & KEYPAD_PWR_BTN));
+    while(!(KEYPAD_PWR_IN & KEYPAD_PWR_BTN)) HAL_SYNC();
     __delay_cycles(PWR_BTN_RELEASE_DELAY);
 
     WDTCTL = 0xDEAD;    // write to the watchdog register with an invalid password, generating a PUC
-    while(1);           // if something goes wrong with the watchdog reset, ensure no other code is executed
+    while(1) HAL_SYNC();    // if something goes wrong with the watchdog reset, ensure no other code is executed
+}
+
+#if (LATENCY_PROFILE)
+/************************************************************************************
+* Function: showProfPage
+*
+* Description:
+*   Draws one page of the diagnostic profile view on both display rows, as
+*   described in the file header above. Page 1 is the first page; a page past the
+*   last page (or page 0) draws nothing, and tells the caller to leave the view.
+*
+* Arguments:
+*   *usciXN         -   pointer to the the USCI peripheral object
+*   *displayArr     -   pointer to the packed 7seg display array
+*   *prof           -   pointer to the profile object to show
+*   page            -   the page to draw, from 1 to PROF_NUM_PAGES
+*
+* Returns:
+*   unsigned char page; the page that was drawn, or 0 if the view should be left
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static unsigned char showProfPage(const USCIXNSPI *const usciXN, SEVEN_SEG_ARR *const displayArr, const PROF_DATA *const prof, unsigned char page)
+{
+    const PROF_STAGE_STATS *stats;
+    const unsigned char *bins;
+    unsigned char stage;
+
+    if (page && (page <= PROF_NUM_PAGES))
+    {
+        stage = (page - 1) >> 1;
+
+        // min/max page, then average/count page for each stage
+        if (stage < PROF_NUM_STAGES)
+        {
+            stats = &(prof->stages[stage]);
+            if (page & BIT0)
+            {
+                writeHexRow(displayArr, stats->minTicks, (BIT3 >> stage), TOP_ROW);
+                writeHexRow(displayArr, stats->maxTicks, 0x0, BOT_ROW);
+            }
+            else
+            {
+                writeHexRow(displayArr, (stats->count) ? (unsigned int)(stats->sumTicks / stats->count) : 0, 0x0, TOP_ROW);
+                writeHexRow(displayArr, stats->count, (BIT3 >> stage), BOT_ROW);
+            }
+        }
+        // histogram pages, 4 bins per page
+        else
+        {
+            bins = &(prof->histogram[(page - 1 - (2 * PROF_NUM_STAGES)) << 2]);
+            writeHexRow(displayArr, ((unsigned int)bins[0] << 8) | bins[1], 0xF, TOP_ROW);
+            writeHexRow(displayArr, ((unsigned int)bins[2] << 8) | bins[3], 0xF, BOT_ROW);
+        }
+
+        dispCommitPending = 1;
+    }
+    else
+        page = 0;
+
+    return page;
+}
+
+/* stores a 16-bit value as 4 packed hex digits in a display row (without writing them), most significant digit first;
+ * bit 3 of dpMask is the decimal point of the first display in the row, and bit 0 is the last */
+static void writeHexRow(SEVEN_SEG_ARR *const displayArr, const unsigned int hexWord, const unsigned char dpMask, unsigned char botRow)
+{
+    unsigned char digitIndex;
+
+    // ensure botRow can only be 4 or 0
+    if (botRow) botRow = 4;
+
+    for (digitIndex = 0; digitIndex < 4; digitIndex++)
+        displayArr->digits[digitIndex + botRow] = SEVSEG_PACK((hexWord >> (12 - (digitIndex << 2))) & 0xF, dpMask & (BIT3 >> digitIndex));
+}
+
+#endif
+
+#if (LATENCY_PROFILE || WARM_RESTART)
+// redraws both display rows from their RATE/VTBI values (or "----" if a row has no user-defined value), such as after leaving the profile view or a warm restart
+static void restoreDispRows(SEVEN_SEG_ARR *const displayArr, const DISP_ROW_VALUE *const rowValues)
+{
+    unsigned char dispIndex;
+
+    for (dispIndex = 0; dispIndex < NUM_DISPS; dispIndex++)
+        displayArr->digits[dispIndex] = SEVSEG_PACK(DASH_CODE, 0);
+
+    if (currSysState & FLAG_RATE_VALUE)
+        renderDispRow(displayArr, &rowValues[TOP_ROW], TOP_ROW);
+    if (currSysState & FLAG_VTBI_VALUE)
+        renderDispRow(displayArr, &rowValues[BOT_ROW], BOT_ROW);
+
+    dispCommitPending = 1;
+}
+#endif
+
+#if (WARM_RESTART)
+/************************************************************************************
+* Function: saveWarmSnapshot
+*
+* Description:
+*   Saves the RATE/VTBI row values, LED state, and WARM_STATE_FLAGS bits of the
+*   system state into warmSnapshot, with its check, for loadWarmSnapshot to resume
+*   from after a watchdog reset. The power state saved is the one last handled by
+*   the main loop (prevSysState), so it always matches what the displays show. The
+*   lamp test and COMPUTER CONTROL are not kept, as the keys and link behind them
+*   start out idle again after a reset.
+*
+* Arguments:
+*   *rowValues  -   pointer to the RATE (TOP_ROW) and VTBI (BOT_ROW) row values
+*   ledState    -   current state of the LED shift register
+*
+* Returns:
+*   (none)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void saveWarmSnapshot(const DISP_ROW_VALUE *const rowValues, const unsigned char ledState)
+{
+    unsigned char rowIndex;
+
+    warmSnapshot.validKey = WARM_VALID_KEY;
+    for (rowIndex = 0; rowIndex < 2; rowIndex++)
+    {
+        warmSnapshot.rowWholes[rowIndex] = rowValues[rowIndex].whole;
+        warmSnapshot.rowTenths[rowIndex] = rowValues[rowIndex].tenth;
+    }
+    warmSnapshot.ledState = ledState;
+    warmSnapshot.sysState = ((currSysState & ~FLAG_PWR_OFF) | (prevSysState & FLAG_PWR_OFF)) & WARM_STATE_FLAGS;
+    warmSnapshot.check = warmChecksum(&warmSnapshot);
 }
 
-// disables the keypad interrupts, debounce timer, and stops any pending keypresses
+/************************************************************************************
+* Function: loadWarmSnapshot
+*
+* Description:
+*   Checks that warmSnapshot holds a snapshot saved by saveWarmSnapshot, with a good
+*   check and row values that renderDispRow can draw, and if so, copies its row
+*   values and LED state out. The snapshot's system state is left in
+*   warmSnapshot.sysState for the caller. This is only meaningful after a reset
+*   that kept RAM, as .TI.noinit RAM holds garbage after a power-on.
+*
+* Arguments:
+*   *rowValues  -   pointer to the RATE (TOP_ROW) and VTBI (BOT_ROW) row values to fill
+*   *ledState   -   pointer to the LED shift register state to fill
+*
+* Returns:
+*   unsigned char noSnapshot; 0 if the snapshot was loaded, 1 if it was not valid
+*   (and nothing was written)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static unsigned char loadWarmSnapshot(DISP_ROW_VALUE *const rowValues, unsigned char *const ledState)
+{
+    unsigned char rowIndex;
+
+    if ((warmSnapshot.validKey != WARM_VALID_KEY) || (warmSnapshot.check != warmChecksum(&warmSnapshot)))
+        return 1;
+    for (rowIndex = 0; rowIndex < 2; rowIndex++)
+    {
+        if ((warmSnapshot.rowWholes[rowIndex] > 9999) || (warmSnapshot.rowTenths[rowIndex] > 9))
+            return 1;
+    }
+
+    for (rowIndex = 0; rowIndex < 2; rowIndex++)
+    {
+        rowValues[rowIndex].whole = warmSnapshot.rowWholes[rowIndex];
+        rowValues[rowIndex].tenth = warmSnapshot.rowTenths[rowIndex];
+    }
+    *ledState = warmSnapshot.ledState;
+
+    return 0;
+}
+
+// evaluates the check word of a snapshot: the complement of the 16-bit sum of every word before it
+static unsigned int warmChecksum(const WARM_SNAPSHOT *const snapshot)
+{
+    const unsigned int *const snapshotWords = (const unsigned int *)snapshot;
+    unsigned int sum = 0;
+    unsigned char wordIndex;
+
+    for (wordIndex = 0; wordIndex < ((sizeof(WARM_SNAPSHOT) / sizeof(unsigned int)) - 1); wordIndex++)
+        sum += snapshotWords[wordIndex];
+
+    return ~sum;
+}
+#endif
+
+// disables the keypad interrupts and debounce timer; events already in the keypad's FIFO are cleared by the main loop (the FIFO's consumer)
 // (this function could possibly be inline, but I've left that up to the compiler to decide)
 static void disableKeypad()
 {
-    TA0CCR0 = 0;                                            // stop debouncing
-    prevSysState &= ~FLAG_KEYPAD_PRESS;                     // clear any kind of pending button press
-    currSysState &= ~FLAG_KEYPAD_PRESS;
+    TA0CCTL0 &= ~CCIE;                                      // stop debouncing
     *(geminiKeypad.ROW_IE) &= ~(geminiKeypad.ROW_PINS);     // shut off keypad interrupts
     *(geminiKeypad.ROW_IES) &= ~(geminiKeypad.ROW_PINS);    // reset the edge select to wait for a press (L -> H)
     *(geminiKeypad.ROW_IFG) &= ~(geminiKeypad.ROW_PINS);    // clear any keypad flags
@@ -1153,18 +2513,36 @@ __inline static void enableKeypad()
     *(geminiKeypad.ROW_IE) |= (geminiKeypad.ROW_PINS);          // enable keypad interrupts
 }
 
-// initializes all necessary registers for timerA0 interrupt functionality; the timer must actually be started by later loading a TA0CCR0 value
+/* initializes all necessary registers for timerA0 interrupt functionality; the timer free-runs in continuous mode so TA0CCR0 (keypad debounce)
+ * and TA0CCR1 (the scheduler tick) can be used at the same time, each scheduled relative to TA0R with its CCIE bit set only while in use */
 __inline static void initKeypadDelayTimer()
 {
     BCSCTL1 &= ~(BIT4 | BIT5 | XTS);            // ensure no ACLK division, and low-frequency mode for LFXT1 to allow for VLOCLK selection
     BCSCTL3 |= LFXT1S_2;                        // set ACLK source to VLOCLK (12kHz)
 
-    TA0CTL = TASSEL_1 | MC_1;                   // set source as ACLK, no clock division, count up mode
-    TA0CCTL0 |= CCIE;                           // enable timer interruptss
-    TA0CCTL0 &= ~CCIFG;                         // clear timer interrupt flags
+    TA0CCTL0 = 0;                               // no debounce or scheduler compares are pending; this also clears any flags
+    TA0CCTL1 = 0;
+    TA0CTL = TASSEL_1 | MC_2 | TACLR;           // set source as ACLK, no clock division, continuous mode
     __enable_interrupt();                       // enable global interrupts
 }
 
+/* sets MCLK and SMCLK to the DCO at F_CPU, as selected by CLK_PROFILE; returns 1 (leaving the clocks alone) if the calibration constants for the
+ * selected frequency have been erased, otherwise 0. ACLK is left for initKeypadDelayTimer to set up */
+__inline static unsigned char initClocks()
+{
+#if (CLK_PROFILE != CLK_PROFILE_DEFAULT)
+    if (CLK_CALBC1 == 0xFF)
+        return 1;
+
+    DCOCTL = 0;                                 // select the lowest DCOx and MODx settings while changing RSELx, so MCLK can't overshoot
+    BCSCTL1 = CLK_CALBC1;
+    DCOCTL = CLK_CALDCO;
+#endif
+    BCSCTL2 = SELM_0 | DIVM_0 | DIVS_0;         // MCLK and SMCLK from the DCO with no division
+
+    return 0;
+}
+
 // initializes all necessary registers for power button interrupt functionality
 __inline static void initPwrBtn()
 {
@@ -1192,9 +2570,15 @@ __interrupt void keypadPressISR(void)
         *(geminiKeypad.ROW_IE) &= ~(geminiKeypad.ROW_PINS);
         *(geminiKeypad.ROW_IFG) &= ~(geminiKeypad.ROW_PINS);
 
-        /* Before registering the button press, if the button was pressed, set the timer to wait for a release debounce delay.
-         * Otherwise, have the timer wait for the press debounce delay. These are configured in "mtrxKeypad.h" */
-        TA0CCR0 = (currSysState & FLAG_KEYPAD_PRESS) ? RELEASE_DBNC_DELAY : PRESS_DBNC_DELAY;
+        /* If the rows' edge select is H -> L, a key was already scanned and this edge is its release, so set the timer to wait for a
+         * release debounce delay. Otherwise, have the timer wait for the press debounce delay. These are configured in "mtrxKeypad.h"
+         * There is nothing for the main loop to do until the delay is over, so the CPU is left asleep; timer0A0ISR wakes it. */
+#if (MTRX_INTEGRATE_DBNC)
+        TA0CCR0 = TA0R + MTRX_PRESS_DELAY;  // row edges are always presses here; this only schedules the first sample
+#else
+        TA0CCR0 = TA0R + ((*(geminiKeypad.ROW_IES) & (geminiKeypad.ROW_PINS)) ? RELEASE_DBNC_DELAY : PRESS_DBNC_DELAY);
+#endif
+        TA0CCTL0 = CCIE;    // this also clears any stale CCIFG
     }
     else
     {
@@ -1215,6 +2599,7 @@ __interrupt void pwrbtnPressISR(void)
         currSysState ^= FLAG_PWR_OFF;                           // toggle the system power state
         KEYPAD_PWR_IE &= ~KEYPAD_PWR_BTN;                       // turn off power button interrupts until debounced
         KEYPAD_PWR_IFG &= ~KEYPAD_PWR_BTN;                      // and clear the power button interrupt
+        __bic_SR_register_on_exit(LPM3_bits);                   // wake the main loop to handle the power state change
     }
     else
     {
@@ -1224,10 +2609,138 @@ __interrupt void pwrbtnPressISR(void)
     }
 }
 
+#pragma vector = TIMER0_A1_VECTOR
+__interrupt void timer0A1ISR(void)
+{
+    switch (__even_in_range(TA0IV, TA0IV_TAIFG))
+    {
+    case TA0IV_TACCR1:                          // a scheduler tick
+        if (!schedTick(&scheduler))
+            __bic_SR_register_on_exit(LPM3_bits);   // wake the main loop to run the tasks that are now due
+        break;
+#if (SUPPLY_MONITOR)
+    case TA0IV_TACCR2:                          // time for the next background supply reading; adc10ISR collects it
+        TA0CCR2 += SUPPLY_SAMPLE_TICKS;
+        supplyStartReading();
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+#if (SPI_ASYNC_QUEUE) || (COMPUTER_CONTROL)
+#pragma vector = USCIAB0RX_VECTOR
+__interrupt void usciAB0RxISR(void)
+{
+#if (SPI_ASYNC_QUEUE)
+    unsigned char queueServiced = 0;
+
+    // a queued display/LED byte has finished shifting out; release its chip select and start the next one
+    if (IFG2 & UCA0RXIFG)
+    {
+        usciXNSpiQueueISR(&USCIA0SPI, &spiTxQueue);
+        queueServiced = 1;
+    }
+#if (LEDSR_USCIB0)
+    // the same for a queued LED byte, on its own USCI
+    if (IFG2 & UCB0RXIFG)
+    {
+        usciXNSpiQueueISR(&USCIB0SPI, &ledTxQueue);
+        queueServiced = 1;
+    }
+#endif
+
+    // wake the main loop once every queue is drained, so it can drop from LPM0 down to LPM3
+    if (queueServiced)
+    {
+        if (SPI_TX_IDLE)
+        {
+#if (LATENCY_PROFILE)
+            // the last byte caused by a profiled key release has now left UCA0TXBUF
+            if (profOutputPending)
+            {
+                profRecord(&latencyProfile, PROF_STAGE_OUTPUT, PROF_NOW() - profOutputStart);
+                profOutputPending = 0;
+            }
+#endif
+            __bic_SR_register_on_exit(LPM0_bits);
+        }
+    }
+#endif
+
+#if (COMPUTER_CONTROL)
+    // a byte has been received from the computer, and the next report byte loaded; wake the main loop once a whole command is in
+    if (IFG2 & UCB0RXIFG)
+    {
+        if (!ctrlLinkISR(&USCIB0SPI, &ctrlLink))
+            __bic_SR_register_on_exit(LPM3_bits);
+    }
+#endif
+}
+#endif
+
 #pragma vector = TIMER0_A0_VECTOR
 __interrupt void timer0A0ISR(void)
 {
-    prevSysState ^= ((prevSysState ^ currSysState) & FLAG_KEYPAD_PRESS);    // toggle previous key state to match current if it differs from the current
-    currSysState ^= FLAG_KEYPAD_PRESS;                                      // officially register a keypad event, now that debouncing is complete
-    TA0CCR0 = 0;                                                            // stop the timer, now that the debounce delay is complete
+#if (LATENCY_PROFILE)
+    unsigned int profStart = PROF_NOW();
+#endif
+
+    TA0CCTL0 &= ~CCIE;                                                      // stop listening to the timer, now that the debounce delay is complete
+
+    // scan or save the key now that debouncing is complete, and only wake the main loop if an event was queued for it
+#if (MTRX_BITMAP_SCAN)
+    if (!mtrxGeminiDebounce(&geminiKeypad, KEY_EVENT_TIMESTAMP))
+#else
+    if (!mtrxKeypadDebounce(&geminiKeypad, KEY_EVENT_TIMESTAMP))
+#endif
+        __bic_SR_register_on_exit(LPM3_bits);
+
+#if (MTRX_BITMAP_SCAN)
+    // while any key is held (or settling), row interrupts stay off, so keep rescanning the matrix to catch further presses and releases
+    if (MTRX_KEYS_HELD(&geminiKeypad))
+    {
+        TA0CCR0 += MTRX_RESCAN_DELAY;
+        TA0CCTL0 = CCIE;
+    }
+#endif
+
+#if (LATENCY_PROFILE)
+    profRecord(&latencyProfile, PROF_STAGE_SCAN, PROF_NOW() - profStart);
+#endif
+}
+
+#if (SUPPLY_MONITOR)
+#pragma vector = ADC10_VECTOR
+__interrupt void adc10ISR(void)
+{
+    // a background supply reading is complete; wake the main loop to update the power LEDs
+    if (!supplyISR(&supply))
+        __bic_SR_register_on_exit(LPM3_bits);
+}
+#endif
+
+#if (DISP_DIMMING)
+#pragma vector = TIMER1_A0_VECTOR
+__interrupt void timer1A0ISR(void)
+{
+    // the dimmer has moved on to the lit or blank part of its period; wake the main loop to relight or blank the outputs
+    if (!dimISR(&dimmer))
+        __bic_SR_register_on_exit(LPM3_bits);
+}
+
+#pragma vector = TIMER1_A1_VECTOR
+__interrupt void timer1A1ISR(void)
+{
+    switch (__even_in_range(TA1IV, TA1IV_TAIFG))
+    {
+    case TA1IV_TACCR1:                          // a step of the dimmer's inactivity timeout
+        if (!dimIdleISR(&dimmer))
+            __bic_SR_register_on_exit(LPM3_bits);   // wake the main loop to relight the outputs
+        break;
+    default:
+        break;
+    }
 }
+#endif
@@ -0,0 +1,90 @@
+################################################################################
+# Gemini Interface Control Board -- Host Benchmark Build
+# Property of Super Props Inc., all rights reserved
+#
+# Builds the host benchmark (hostBenchClient.c) with gcc, and a fresh linker map
+# of the firmware with the TI compiler, then reports the bench's figures against
+# that map, so the sizes it lists are never from a stale build. Run from the
+# firmware directory:
+#   make -f hostBench.mk report     bench script and fault script, against a fresh map
+#   make -f hostBench.mk run        bench script alone, without a map (no TI compiler needed)
+#   make -f hostBench.mk map        firmware build alone, for $(BENCH_DIR)/$(MAP_NAME)
+#   make -f hostBench.mk clean
+#
+# The firmware is built with the options of the CCS Debug configuration, apart
+# from the optimization profile, which is selected with OPT_LEVEL and
+# OPT_FOR_SPEED (ex: make -f hostBench.mk report OPT_LEVEL=4 OPT_FOR_SPEED=2).
+# Every source the CCS project builds is compiled, so the map covers the whole
+# tree; the option defines in the headers are the ones the bench is built with.
+#
+# The bench is built with -finstrument-functions, and the symbols of its binary
+# are listed with nm, so it can print the modelled cycles of every firmware
+# function along with their size in the map.
+#
+# Created:      October 14, 2026
+# Modified:     October 14, 2026
+################################################################################
+
+CG_TOOL_ROOT ?= /opt/ccstudio/ccs/tools/compiler/ti-cgt-msp430_21.6.1.LTS
+MSP430_INCLUDE ?= /opt/ccstudio/ccs/ccs_base/msp430/include
+OPT_LEVEL ?= 2
+OPT_FOR_SPEED ?= 0
+
+HOST_CC ?= gcc
+NM ?= nm
+BENCH_DIR ?= benchBuild
+MAP_NAME := SuperProps_GeminiControlBoard.map
+
+MODULE_SRCS := $(wildcard *_Module/*.c)
+MODULE_DIRS := $(sort $(patsubst %/,%,$(dir $(MODULE_SRCS))))
+FW_SRCS := geminiControlClient.c $(filter-out HAL_Module/hostHal.c,$(MODULE_SRCS))
+FW_HDRS := $(wildcard *_Module/*.h)
+
+# the CCS Debug configuration's compiler and linker options (see Debug/subdir_rules.mk and Debug/makefile)
+CL430 := $(CG_TOOL_ROOT)/bin/cl430
+CL430_FLAGS := -vmsp -O$(OPT_LEVEL) --opt_for_speed=$(OPT_FOR_SPEED) --use_hw_mpy=none \
+    --include_path="$(MSP430_INCLUDE)" $(addprefix --include_path=,$(MODULE_DIRS)) --include_path=. \
+    --include_path="$(CG_TOOL_ROOT)/include" --advice:power="all" --define=__MSP430G2353__ -g \
+    --printf_support=minimal --diag_warning=225 --diag_wrap=off --display_error_number --enum_type=packed
+LNK430_FLAGS := -z --heap_size=80 --stack_size=80 -i"$(MSP430_INCLUDE)" -i"$(CG_TOOL_ROOT)/lib" \
+    -i"$(CG_TOOL_ROOT)/include" --reread_libs --warn_sections --rom_model
+
+# the bench's own files and the peripheral model aren't timed, so their cycles are counted against the firmware function that called them
+BENCH_CFLAGS := -DHOST_BUILD -Wno-unknown-pragmas $(addprefix -I ,$(MODULE_DIRS)) \
+    -finstrument-functions -finstrument-functions-exclude-file-list=hostBenchClient.c,hostHal.c
+
+FW_OBJS := $(addprefix $(BENCH_DIR)/,$(FW_SRCS:.c=.obj))
+BENCH_BIN := $(BENCH_DIR)/hostBench
+BENCH_SYMS := $(BENCH_DIR)/hostBench.syms
+BENCH_MAP := $(BENCH_DIR)/$(MAP_NAME)
+
+.PHONY: report run map bench clean
+
+report: $(BENCH_BIN) $(BENCH_SYMS) $(BENCH_MAP)
+	./$(BENCH_BIN) -syms $(BENCH_SYMS) $(BENCH_MAP)
+	./$(BENCH_BIN) -fault -syms $(BENCH_SYMS)
+
+run: $(BENCH_BIN) $(BENCH_SYMS)
+	./$(BENCH_BIN) -syms $(BENCH_SYMS)
+
+map: $(BENCH_MAP)
+
+bench: $(BENCH_BIN) $(BENCH_SYMS)
+
+$(BENCH_BIN): hostBenchClient.c geminiControlClient.c $(MODULE_SRCS) $(FW_HDRS)
+	@mkdir -p $(dir $@)
+	$(HOST_CC) $(BENCH_CFLAGS) hostBenchClient.c $(MODULE_SRCS) -o $@
+
+$(BENCH_SYMS): $(BENCH_BIN)
+	$(NM) $< > $@
+
+# every object depends on every header, as the option defines are spread across them
+$(BENCH_DIR)/%.obj: %.c $(FW_HDRS)
+	@mkdir -p $(dir $@)
+	"$(CL430)" $(CL430_FLAGS) --obj_directory="$(dir $@)" "$<"
+
+$(BENCH_MAP): $(FW_OBJS) lnk_msp430g2353.cmd
+	"$(CL430)" $(CL430_FLAGS) $(LNK430_FLAGS) -m"$@" -o "$(@:.map=.out)" $(FW_OBJS) lnk_msp430g2353.cmd -llibc.a
+
+clean:
+	rm -rf $(BENCH_DIR)
@@ -0,0 +1,962 @@
+/************************************************************************************
+* Gemini Interface Control Board -- Host Benchmark Client
+* Property of Super Props Inc., all rights reserved
+*
+* Client file that runs the unmodified geminiControlClient.c firmware on a PC,
+* against the peripheral model in "hostHal.c", and drives it through a fixed
+* script of keypad and power button presses. After each step, it prints the SPI
+* bytes sent, chip select toggles, and modelled active CPU cycles for that step,
+* followed by what the displays and LED shift register are showing. Totals and a
+* signature of all SPI traffic (bytes plus the chip selects asserted for each) are
+* printed at the end, so changes to the firmware can be compared run to run: a
+* refactor that should not change behavior must not change the signature.
+*
+* A budget of each scenario's steps, SPI bytes, and active cycles follows. Given the
+* path of a CCS linker map, the flash size of every function in it is listed as
+* well, largest first, along with the RAM taken by each section. The cycle figures
+* come from the peripheral model, which doesn't count straight-line code (see
+* "hostHal.h"), so they show what a firmware change costs in bus, ISR, and
+* busy-wait time whatever the optimization profile; the map shows what the build
+* costs in RAM and flash.
+*
+* Please note: the sizes are only those of the build the map came from, so the map
+* must be from a fresh build of this tree (with the same options as the bench),
+* such as the one made by "hostBench.mk". The maps committed under "Debug/" (and
+* "Debug/optimizerAssistant/") predate most of the modules here, and describe code
+* that has since been removed; a map without BENCH_MAP_TREE_FUNC in it is reported
+* as not being from this tree.
+*
+* Built with -finstrument-functions (as "hostBench.mk" does) and given an nm
+* listing of itself, the bench also times every firmware function: the calls to
+* it, and the modelled active cycles spent in it over the whole run, not counting
+* the firmware functions it called, are listed most cycles first, next to its
+* size from the map. As above, these are the model's cycles (busy-waits, SPI
+* transfers, ISR entry), so they show which functions the bus and wait time of a
+* change goes to, not how fast their straight-line code is.
+*
+* With COMPUTER_CONTROL enabled in "ctrlLink.h", the script also plays the part of
+* the computer on the control link, clocking commands into USCI_B0 and printing
+* the key reports clocked back out with them.
+*
+* With LEDSR_USCIB0 enabled, the LED shift register is only wired to USCI_B0, and
+* the displays to USCI_A0.
+*
+* Given -fault, the fault script is run instead: the DCO calibration constants for
+* CLK_PROFILE are erased before reset, so the firmware boots into criticalFaultHandler
+* (FAULT_CLK_CAL) on the power-up DCO. Once it is polling the power button, the
+* button is held down, and the run ends with the PUC the handler does on its press.
+*
+* With DISP_DIMMING enabled in "dimmer.h", a "dim idle" scenario leaves the keypad
+* alone until the dimmer has dropped to DIM_IDLE_LEVEL, then for BENCH_DIMMED_MS
+* more, so its step shows what the blanking and relighting writes cost.
+*
+* Build and run from the firmware directory with "make -f hostBench.mk report",
+* which also builds a fresh linker map of the firmware with the TI compiler, with
+* the CCS Debug options and the optimization profile selected by OPT_LEVEL and
+* OPT_FOR_SPEED, and runs both scripts against it ("make -f hostBench.mk run" runs
+* the bench script alone, without a map). The binary it builds takes:
+*   benchBuild/hostBench [-fault] [-syms <nm listing of the binary>] [<linker map>]
+*
+* This file (and "hostHal.c") is excluded from the CCS project build.
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+
+
+//########## DEPENDENCIES ##########//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// the firmware's main() is renamed so the bench can register ISRs before running it
+#define main geminiMain
+#include "geminiControlClient.c"
+#undef main
+
+
+//########## SYMBOLIC CONSTANTS ##########//
+#define BENCH_KEYPAD_PORT   2       // the keypad's rows and columns are all on port 2
+#define BENCH_PWR_PORT      1       // the power button is on port 1
+#if (COMPUTER_CONTROL)
+#define BENCH_CS_BIT        3       // bit of the LED shift register's (or the frame's) chip select on port 1, kept clear of USCI_B0
+#else
+#define BENCH_CS_BIT        6
+#endif
+
+// what each display and the LED shift register were last written with; on the daisy-chained board, display n is n registers down the chain
+#if (DISP_DAISY_CHAIN)
+#define BENCH_DISP_BYTE(dispIndex)  hostHalChainByte(1, BENCH_CS_BIT, (dispIndex))
+#define BENCH_LED_BYTE              hostHalChainByte(1, BENCH_CS_BIT, NUM_DISPS)
+#else
+#define BENCH_DISP_BYTE(dispIndex)  hostHalLastByte(3, (dispIndex))
+#define BENCH_LED_BYTE              hostHalLastByte(1, BENCH_CS_BIT)
+#endif
+
+#define BENCH_HOLD_MS       100     // how long keys are held for
+#define BENCH_LONG_HOLD_MS  2000    // how long keys are held for by STIM_HOLD, long enough to auto-repeat
+#define BENCH_FAULT_MS      2000    // how long after reset the fault script's first step is applied, once the fault handler is polling the power button
+#if (DISP_DIMMING)
+#define BENCH_DIMMED_MS     1000    // how long STIM_WAIT leaves the firmware running at DIM_IDLE_LEVEL
+#define BENCH_WAIT_MS       (DIM_IDLE_MS + BENCH_DIMMED_MS)
+#endif
+
+#define STIM_KEY            0       // press a matrix key, and release it BENCH_HOLD_MS later (or once the firmware is idle, if sooner)
+#define STIM_CHORD          1       // press two matrix keys at once, and release them together in the same way
+#define STIM_PWR            2       // tap the power button (its release is waited for by the firmware)
+#define STIM_HOLD           3       // press a matrix key, and release it BENCH_LONG_HOLD_MS later
+#define STIM_LINK           4       // clock a command into the control link, framed with CTRL_SYNC and its checksum
+#define STIM_LINK_BAD       5       // the same, but with a checksum that is off by one
+#define STIM_WAIT           6       // press nothing for BENCH_WAIT_MS, long enough for the dimmer to idle and then blank for BENCH_DIMMED_MS
+#define STIM_PWR_HOLD       7       // hold the power button down for BENCH_HOLD_MS, for a firmware that polls it rather than waiting for its edge
+
+#define BENCH_LINK_MAX      (CTRL_RX_BUF_SZ + 2)    // longest framed command the bench can send
+
+#define BENCH_MAP_LINE      256     // longest linker map line read whole (longer ones are read in pieces, which never match)
+#define BENCH_MAP_FUNCS     96      // most functions listed from a linker map
+#define BENCH_MAP_NAME      40      // longest function or section name kept from a linker map, with its terminator
+#define BENCH_MAP_TREE_FUNC "ledCompUpdate" // a function every build of this tree links, whatever its options; a map without it is from an older tree
+
+#define BENCH_PROF_FUNCS    128     // most firmware functions timed by the -finstrument-functions hooks
+#define BENCH_PROF_DEPTH    32      // deepest nesting of firmware calls timed
+#define BENCH_PROF_UNTIMED  0xFF    // benchProfStack entry of a call that isn't timed, as benchProf is full
+
+
+//########## STRUCTURES ##########//
+typedef struct BENCH_STEP
+{
+    const char *scenario;           // scenario the step starts, or 0 if it continues the previous one
+    const char *name;               // key or button being pressed
+    unsigned char stim;             // one of the STIM_ constants
+    unsigned char keyCoord;         // key coordinate, for STIM_KEY, STIM_CHORD, and STIM_HOLD
+    unsigned char chordCoord;       // coordinate of the second key, for STIM_CHORD
+    const unsigned char *linkCmd;   // command byte and payload, for STIM_LINK and STIM_LINK_BAD
+    unsigned char linkLen;          // number of bytes in linkCmd
+}
+BENCH_STEP;
+
+typedef struct BENCH_BUDGET
+{
+    const char *scenario;           // name of the scenario
+    unsigned char steps;            // number of steps in it
+    unsigned long spiBytes;         // SPI bytes sent over all of its steps
+    unsigned long activeCycles;     // modelled active CPU cycles over all of its steps
+}
+BENCH_BUDGET;
+
+typedef struct BENCH_FUNC
+{
+    char name[BENCH_MAP_NAME];      // function (or, for unnamed sections, object file) name
+    unsigned long size;             // bytes of flash taken
+}
+BENCH_FUNC;
+
+typedef struct BENCH_PROF_FUNC
+{
+    const void *addr;               // entry point of the function
+    char name[BENCH_MAP_NAME];      // function name, from the symbol listing (empty if it isn't in it)
+    unsigned long calls;            // number of times it was called
+    unsigned long cycles;           // modelled active CPU cycles spent in it, not counting the firmware functions it called
+}
+BENCH_PROF_FUNC;
+
+
+//########## PRIVATE GLOBALS ##########//
+#if (COMPUTER_CONTROL)
+// control link commands: a full frame showing "C0DE" over "1234" with every other LED lit, a frame changing 2 displays, and a release
+static const unsigned char benchLinkFrame[] = {CTRL_CMD_FRAME | CTRL_FRAME_LED, ALL_DISPS, 0x39, 0x3F, 0x5E, 0x79, 0x06, 0x5B, 0x4F, 0x66, 0x55};
+static const unsigned char benchLinkPartial[] = {CTRL_CMD_FRAME, DISP4 | DISP7, 0x71, 0x40};
+static const unsigned char benchLinkRelease[] = {CTRL_CMD_RELEASE};
+#define BENCH_LINK(cmd)     (cmd), sizeof(cmd)
+#endif
+
+static const BENCH_STEP benchScript[] =
+{
+    {"power on",        "POWER",        STIM_PWR, 0},
+    {"RATE edit",       "RATE",         STIM_KEY, RATE},
+    {0,                 "100",          STIM_KEY, HUNDRED},
+    {0,                 "10",           STIM_KEY, TEN},
+    {0,                 "1",            STIM_KEY, ONE},
+    {0,                 "0.1",          STIM_KEY, TENTH},
+    {0,                 "RATE",         STIM_KEY, RATE},
+    {"VTBI edit",       "VTBI",         STIM_KEY, VTBI},
+    {0,                 "100",          STIM_KEY, HUNDRED},
+    {0,                 "100",          STIM_KEY, HUNDRED},
+    {0,                 "1",            STIM_KEY, ONE},
+    {0,                 "CLEAR",        STIM_KEY, CLEAR_SILENCE},
+    {0,                 "10",           STIM_KEY, TEN},
+    {0,                 "VTBI",         STIM_KEY, VTBI},
+    {"pump",            "START",        STIM_KEY, START},
+    {0,                 "PAUSE/STOP",   STIM_KEY, PAUSE_STOP_DOWN},
+    {"LED toggle",      "CC MONITOR",   STIM_KEY, CC_MONITOR},
+    {0,                 "PC MODE",      STIM_KEY, PC_MODE},
+#if (DISP_DIMMING)
+    {"dim idle",        "wait",         STIM_WAIT, 0},
+#endif
+    {"typematic",       "RATE",         STIM_KEY, RATE},
+    {0,                 "hold 10",      STIM_HOLD, TEN},
+    {0,                 "hold 0.1",     STIM_HOLD, TENTH},
+    {0,                 "RATE",         STIM_KEY, RATE},
+    {"UI table",        "VTBI",         STIM_KEY, VTBI},
+    {0,                 "RATE",         STIM_KEY, RATE},
+    {0,                 "CLEAR",        STIM_KEY, CLEAR_SILENCE},
+    {0,                 "VTBI",         STIM_KEY, VTBI},
+    {0,                 "VTBI",         STIM_KEY, VTBI},
+    {0,                 "CC MONITOR",   STIM_KEY, CC_MONITOR},
+    {0,                 "CC MONITOR",   STIM_KEY, CC_MONITOR},
+    {0,                 "CC MONITOR",   STIM_KEY, CC_MONITOR},
+    {0,                 "PC MODE",      STIM_KEY, PC_MODE},
+    {0,                 "VOL INFUSED",  STIM_KEY, VOLUME_INFUSED},
+    {0,                 "VOL INFUSED",  STIM_KEY, VOLUME_INFUSED},
+    {0,                 "SEC PIGGY",    STIM_KEY, SEC_PIGGY_BACK},
+    {0,                 "START",        STIM_KEY, START},
+    {0,                 "100",          STIM_KEY, HUNDRED},
+    {0,                 "PC MODE",      STIM_KEY, PC_MODE},
+    {0,                 "RATE",         STIM_KEY, RATE},
+    {0,                 "PAUSE/STOP",   STIM_KEY, PAUSE_STOP_ALT},
+    {0,                 "CLEAR",        STIM_KEY, CLEAR_SILENCE},
+    {"lamp test",       "CLEAR+START",  STIM_CHORD, CLEAR_SILENCE, START},
+#if (COMPUTER_CONTROL)
+    {"computer",        "frame",        STIM_LINK, 0, 0, BENCH_LINK(benchLinkFrame)},
+    {0,                 "partial",      STIM_LINK, 0, 0, BENCH_LINK(benchLinkPartial)},
+    {0,                 "100",          STIM_KEY, HUNDRED},
+    {0,                 "bad checksum", STIM_LINK_BAD, 0, 0, BENCH_LINK(benchLinkFrame)},
+    {0,                 "release",      STIM_LINK, 0, 0, BENCH_LINK(benchLinkRelease)},
+#endif
+    {"power off",       "POWER",        STIM_PWR, 0}
+};
+
+#define BENCH_NUM_STEPS     (sizeof(benchScript) / sizeof(benchScript[0]))
+
+// the fault script, run with -fault: the DCO calibration constants are erased, so the firmware boots into criticalFaultHandler, which resets on a press
+static const BENCH_STEP benchFaultScript[] =
+{
+    {"clock fault",     "POWER",        STIM_PWR_HOLD, 0}
+};
+
+#define BENCH_NUM_FAULT_STEPS   (sizeof(benchFaultScript) / sizeof(benchFaultScript[0]))
+
+static const BENCH_STEP *benchSteps = benchScript;      // the script being run
+static unsigned char benchNumSteps = BENCH_NUM_STEPS;   // number of steps in it
+static unsigned char benchStep = 0;         // index of the next script step to apply
+static unsigned char benchKeyDown = 0;      // set while the current step's keys are held
+static HOST_HAL_STATS benchLastStats;       // counters at the end of the previous step
+static BENCH_BUDGET benchBudget[BENCH_NUM_STEPS];   // totals for each scenario run so far
+static unsigned char benchNumScenarios = 0;         // number of entries in benchBudget
+static const char *benchMapPath = 0;                // linker map to list the function sizes of, or 0 for none
+static const char *benchSymsPath = 0;               // nm listing of this binary to name the timed functions from, or 0 for none
+static BENCH_FUNC benchMapFuncs[BENCH_MAP_FUNCS];   // functions read from the linker map, largest first
+static unsigned char benchNumMapFuncs = 0;
+
+static BENCH_PROF_FUNC benchProf[BENCH_PROF_FUNCS];     // firmware functions timed so far, in the order they were first called
+static unsigned char benchNumProf = 0;
+static unsigned char benchProfStack[BENCH_PROF_DEPTH];  // benchProf index of every firmware function being run, innermost last
+static unsigned char benchProfDepth = 0;
+static unsigned long benchProfDeep = 0;             // calls made below BENCH_PROF_DEPTH that are still running, whose cycles go to the innermost timed one
+static unsigned long benchProfLast = 0;             // active cycles when the innermost function was last charged for its time
+#if (COMPUTER_CONTROL)
+static unsigned char benchLinkTx[BENCH_LINK_MAX];   // framed command being clocked into the control link
+static unsigned char benchLinkRx[BENCH_LINK_MAX];   // bytes clocked back out with it
+static unsigned char benchLinkLen = 0;              // number of bytes in benchLinkTx
+#endif
+
+
+//########## FUNCTION PROTOTYPES ##########//
+static void printStep(const BENCH_STEP *const step);
+static void benchFinish(void);
+static char decodeDisp(const unsigned char segCode, unsigned char *const dp);
+static void printBudget(void);
+static void printMapSizes(const char *const path);
+static void printFuncCycles(const char *const path);
+static int compareProfCycles(const void *a, const void *b);
+static void chargeProfFunc(void) __attribute__((no_instrument_function));
+static int compareFuncSize(const void *a, const void *b);
+#if (COMPUTER_CONTROL)
+static void sendLinkCmd(const BENCH_STEP *const step);
+#endif
+
+
+//########## MAIN ##########//
+int main(int argc, char *argv[])
+{
+    int argIndex;
+
+    for (argIndex = 1; argIndex < argc; argIndex++)
+    {
+        if (!strcmp(argv[argIndex], "-fault"))
+        {
+            benchSteps = benchFaultScript;
+            benchNumSteps = BENCH_NUM_FAULT_STEPS;
+        }
+        else if (!strcmp(argv[argIndex], "-syms") && (argIndex + 1 < argc))
+            benchSymsPath = argv[++argIndex];
+        else
+            benchMapPath = argv[argIndex];
+    }
+
+    hostHalSetIsr(KEYPAD_ISR_VECTOR, keypadPressISR);
+    hostHalSetIsr(PWRBTN_ISR_VECTOR, pwrbtnPressISR);
+    hostHalSetIsr(TIMER0_A0_VECTOR, timer0A0ISR);
+    hostHalSetIsr(TIMER0_A1_VECTOR, timer0A1ISR);
+#if (SPI_ASYNC_QUEUE) || (COMPUTER_CONTROL)
+    hostHalSetIsr(USCIAB0RX_VECTOR, usciAB0RxISR);
+#endif
+#if (SUPPLY_MONITOR)
+    hostHalSetIsr(ADC10_VECTOR, adc10ISR);
+    hostHalSetBackground(0, 2);     // the background supply readings never stop, so they don't hold up the next step
+#endif
+#if (LEDSR_USCIB0)
+    hostHalSetSpiBus(1, 1, LEDSR);      // on this board revision, only USCI_B0 reaches the LED shift register, and only USCI_A0 the displays
+    hostHalSetSpiBus(0, 3, ALL_DISPS);
+#endif
+#if (DISP_DIMMING)
+    hostHalSetIsr(TIMER1_A0_VECTOR, timer1A0ISR);
+    hostHalSetIsr(TIMER1_A1_VECTOR, timer1A1ISR);
+    hostHalSetBackground(1, 0);     // the blanking never stops while dimmed, and the inactivity timeout is left to run out between steps (which only STIM_WAIT waits for)
+    hostHalSetBackground(1, 1);
+#endif
+
+    if (benchSteps == benchFaultScript)
+    {
+#if (CLK_PROFILE == CLK_PROFILE_DEFAULT)
+        printf("the fault script needs a calibrated CLK_PROFILE, as it erases its calibration constants\n");
+        return 1;
+#else
+        // the handler polls the power button with interrupts disabled, so its press is applied by an alarm rather than once the firmware sleeps
+        CLK_CALBC1 = 0xFF;
+        CLK_CALDCO = 0xFF;
+        hostHalSetAlarm(BENCH_FAULT_MS);
+#endif
+    }
+
+    printf("%-12s %-12s %6s %6s %10s   %-9s %-9s %s\n", "scenario", "step", "bytes", "cs", "cycles", "top", "bottom", "LEDs");
+
+    geminiMain();   // never returns; hostHalIdle() ends the program after the last step, or hostHalReset() once the firmware resets
+
+    return 1;
+}
+
+
+//########## FUNCTIONS ##########//
+
+/************************************************************************************
+* Function: hostHalIdle
+*
+* Description:
+*   Called by the peripheral model whenever the firmware is asleep with nothing
+*   scheduled, or once a key's hold time is up. The step in progress is finished
+*   (held keys or the power button are released, or the results of the last step
+*   are printed), then the next step is applied. After the last step, the totals
+*   are printed and the program exits (see benchFinish).
+*
+* Arguments: none
+*
+* Returns: none
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void hostHalIdle(void)
+{
+    const BENCH_STEP *const step = &benchSteps[benchStep];
+
+    // the keys of the current step are released on the idle call after their press
+    if (benchKeyDown)
+    {
+        benchKeyDown = 0;
+        hostHalReleaseKeys();
+        hostHalReleasePin(BENCH_PWR_PORT, KEYPAD_PWR_BTN);
+        return;
+    }
+
+    if (benchStep)
+        printStep(&benchSteps[benchStep - 1]);
+
+    if (benchStep >= benchNumSteps)
+        benchFinish();
+
+#if (COMPUTER_CONTROL)
+    if ((step->stim == STIM_LINK) || (step->stim == STIM_LINK_BAD))
+        sendLinkCmd(step);
+    else
+#endif
+#if (DISP_DIMMING)
+    if (step->stim == STIM_WAIT)
+    {
+        // nothing is pressed, so there is nothing to release once the wait is over
+        hostHalWait(BENCH_WAIT_MS);
+        benchKeyDown = 1;
+    }
+    else
+#endif
+    if (step->stim == STIM_PWR_HOLD)
+    {
+        hostHalDrivePin(BENCH_PWR_PORT, KEYPAD_PWR_BTN, 0);
+        hostHalSetAlarm(BENCH_HOLD_MS);
+        benchKeyDown = 1;
+    }
+    else if (step->stim != STIM_PWR)
+    {
+        hostHalPressKey(BENCH_KEYPAD_PORT, step->keyCoord);
+        if (step->stim == STIM_CHORD)
+            hostHalPressKey(BENCH_KEYPAD_PORT, step->chordCoord);
+        hostHalSetAlarm((step->stim == STIM_HOLD) ? BENCH_LONG_HOLD_MS : BENCH_HOLD_MS);
+        benchKeyDown = 1;
+    }
+    else
+    {
+        // the pin is pulled back up before the firmware waits for the release, so this is a short tap
+        hostHalDrivePin(BENCH_PWR_PORT, KEYPAD_PWR_BTN, 0);
+        hostHalReleasePin(BENCH_PWR_PORT, KEYPAD_PWR_BTN);
+    }
+    benchStep++;
+}
+
+/************************************************************************************
+* Function: hostHalReset
+*
+* Description:
+*   Called by the peripheral model once the firmware causes a PUC (such as
+*   criticalFaultHandler's invalid WDTCTL write). The firmware can't be restarted
+*   in the same process, so the step in progress is printed as the last one, and
+*   the program ends as it does after the last step.
+*
+* Arguments: none
+*
+* Returns: none
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void hostHalReset(void)
+{
+    if (benchStep)
+        printStep(&benchSteps[benchStep - 1]);
+    printf("%-12s %-12s the firmware reset itself (PUC)\n", "", "");
+
+    benchFinish();
+}
+
+/************************************************************************************
+* Function: benchFinish
+*
+* Description:
+*   Prints the scenario budget, the sizes from the linker map and the cycles of
+*   every firmware function (if a map and symbol listing were given), and the
+*   totals and traffic signature of the whole run, then exits.
+*
+* Arguments: none
+*
+* Returns: none (DOES NOT RETURN)
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void benchFinish(void)
+{
+    const HOST_HAL_STATS *const stats = hostHalGetStats();
+
+    chargeProfFunc();
+    printBudget();
+    if (benchMapPath)
+        printMapSizes(benchMapPath);
+    if (benchSymsPath)
+        printFuncCycles(benchSymsPath);
+
+    printf("\ntotal: %lu SPI bytes, %lu chip select toggles, %lu active cycles, %lu sleep cycles, %lu ISR calls\n",
+           stats->spiBytes, stats->csToggles, stats->activeCycles, stats->sleepCycles, stats->isrCalls);
+    printf("traffic signature: %08lX\n", stats->trafficSig & 0xFFFFFFFFUL);
+    exit(0);
+}
+
+/************************************************************************************
+* Function: printStep
+*
+* Description:
+*   Prints the counter deltas of a finished step, and the current contents of the
+*   two display rows and the LED shift register. The deltas are also added to the
+*   step's scenario in benchBudget.
+*
+* Arguments:
+*   *step   -   the step that just finished
+*
+* Returns: none
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void printStep(const BENCH_STEP *const step)
+{
+    const HOST_HAL_STATS *stats = hostHalGetStats();
+    BENCH_BUDGET *budget;
+    char rows[2][9];
+    unsigned char rowPos;
+    unsigned char dispIndex;
+    unsigned char dp;
+#if (COMPUTER_CONTROL)
+    unsigned char linkIndex;
+#endif
+
+    // each row is printed as 4 characters, each followed by '.' if its decimal point is lit
+    for (dispIndex = 0; dispIndex < NUM_DISPS; dispIndex++)
+    {
+        rowPos = (dispIndex & 0x03) * 2;
+        rows[dispIndex >> 2][rowPos] = decodeDisp(BENCH_DISP_BYTE(dispIndex), &dp);
+        rows[dispIndex >> 2][rowPos + 1] = (dp) ? '.' : ' ';
+    }
+    rows[0][8] = '\0';
+    rows[1][8] = '\0';
+
+    printf("%-12s %-12s %6lu %6lu %10lu   [%s] [%s] %02X\n", (step->scenario) ? step->scenario : "", step->name,
+           stats->spiBytes - benchLastStats.spiBytes, stats->csToggles - benchLastStats.csToggles,
+           stats->activeCycles - benchLastStats.activeCycles, rows[0], rows[1], BENCH_LED_BYTE);
+
+    // a step without a scenario name carries on the one before
+    if (step->scenario || !benchNumScenarios)
+    {
+        budget = &benchBudget[benchNumScenarios++];
+        budget->scenario = (step->scenario) ? step->scenario : "";
+        budget->steps = 0;
+        budget->spiBytes = 0;
+        budget->activeCycles = 0;
+    }
+    budget = &benchBudget[benchNumScenarios - 1];
+    budget->steps++;
+    budget->spiBytes += stats->spiBytes - benchLastStats.spiBytes;
+    budget->activeCycles += stats->activeCycles - benchLastStats.activeCycles;
+
+#if (COMPUTER_CONTROL)
+    // every report byte the computer collected with the command (CTRL_REPORT_IDLE filler is left out)
+    if ((step->stim == STIM_LINK) || (step->stim == STIM_LINK_BAD))
+    {
+        printf("%-12s %-12s reports:", "", "");
+        for (linkIndex = 0; linkIndex < benchLinkLen; linkIndex++)
+        {
+            if (benchLinkRx[linkIndex] != CTRL_REPORT_IDLE)
+                printf(" %02X", benchLinkRx[linkIndex]);
+        }
+        printf("\n");
+    }
+#endif
+
+    benchLastStats = *stats;
+}
+
+/************************************************************************************
+* Function: decodeDisp
+*
+* Description:
+*   Converts a segment code sent to an (active HIGH) display back into the
+*   character it shows, using the SevenSeg module's decoder.
+*
+* Arguments:
+*   segCode -   the last segment code sent to the display
+*   *dp     -   set to 1 if the decimal point is lit, otherwise 0
+*
+* Returns: the hex digit shown, ' ' if blank, '-' for a dash, or '?' if unknown
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static char decodeDisp(const unsigned char segCode, unsigned char *const dp)
+{
+    SEVEN_SEG_DISP display = {0, 0, 0, segCode, segCode};
+
+    *dp = 0;
+    if (SevSegToHex(&display))
+        return '?';
+
+    *dp = display.dp;
+    if (display.hexDigit == OFF_CODE)
+        return ' ';
+    if (display.hexDigit == DASH_CODE)
+        return '-';
+    return "0123456789ABCDEF"[display.hexDigit];
+}
+
+/************************************************************************************
+* Function: printBudget
+*
+* Description:
+*   Prints the number of steps, SPI bytes, and active cycles of every scenario in
+*   the script, along with the cycles per step.
+*
+* Arguments: none
+*
+* Returns: none
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void printBudget(void)
+{
+    unsigned char index;
+
+    printf("\n%-12s %6s %8s %12s %12s\n", "scenario", "steps", "bytes", "cycles", "cycles/step");
+    for (index = 0; index < benchNumScenarios; index++)
+    {
+        printf("%-12s %6u %8lu %12lu %12lu\n", benchBudget[index].scenario, benchBudget[index].steps, benchBudget[index].spiBytes,
+               benchBudget[index].activeCycles, benchBudget[index].activeCycles / benchBudget[index].steps);
+    }
+}
+
+/************************************************************************************
+* Function: printMapSizes
+*
+* Description:
+*   Reads a CCS linker map, and prints how much of the RAM and flash is used, the
+*   size of every output section in them, and the size of every function's .text
+*   input section, largest first. Unnamed .text sections (hand-written assembly
+*   in the runtime library) are listed by object file. Only the first
+*   BENCH_MAP_FUNCS functions are kept, in benchMapFuncs. If BENCH_MAP_TREE_FUNC
+*   isn't among them, a warning that the map isn't from this tree follows.
+*
+* Arguments:
+*   *path   -   path of the linker map
+*
+* Returns: none
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void printMapSizes(const char *const path)
+{
+    BENCH_FUNC *const funcs = benchMapFuncs;
+    unsigned char numFuncs = 0;
+    FILE *map;
+    char line[BENCH_MAP_LINE];
+    char name[BENCH_MAP_NAME];
+    char sect[BENCH_MAP_NAME] = "";     // output section the map is currently listing
+    unsigned char inSectMap = 0;        // set while reading the SECTION ALLOCATION MAP
+    unsigned char fromTree = 0;         // set once BENCH_MAP_TREE_FUNC has been found
+    unsigned long origin;
+    unsigned long length;
+    unsigned long used;
+    const char *start;
+    const char *end;
+    unsigned char index;
+
+    map = fopen(path, "r");
+    if (!map)
+    {
+        printf("\ncan't open linker map %s\n", path);
+        return;
+    }
+
+    printf("\n%s:\n", path);
+    while (fgets(line, sizeof(line), map))
+    {
+        // the memory usage comes first, in the MEMORY CONFIGURATION table
+        if (!inSectMap && (sscanf(line, " %39s %lx %lx %lx", name, &origin, &length, &used) == 4)
+            && (!strcmp(name, "RAM") || !strcmp(name, "FLASH")))
+        {
+            printf("%-12s %6lu of %lu bytes used\n", name, used, length);
+            continue;
+        }
+
+        if (!strncmp(line, "SECTION ALLOCATION MAP", 22))
+        {
+            inSectMap = 1;
+            printf("\n%-40s %6s\n", "section", "bytes");
+            continue;
+        }
+        if (!inSectMap)
+            continue;
+        if (!strncmp(line, "GLOBAL SYMBOLS", 14) || !strncmp(line, "MODULE SUMMARY", 14) || !strncmp(line, "LINKER GENERATED", 16))
+            break;
+
+        // an output section starts at the left margin (its page, origin, and length go on the next line, after a '*', if its name is long)
+        if ((line[0] != ' ') && (line[0] != '*') && (line[0] != '\n') && (line[0] != '\r'))
+        {
+            sscanf(line, "%39s", sect);
+            if ((sect[0] == '.') && (sscanf(line, "%*s %*s %lx %lx", &origin, &length) == 2) && length)
+                printf("%-40s %6lu\n", sect, length);
+            continue;
+        }
+
+        if (!strcmp(sect, ".text") && strstr(line, "(.text:" BENCH_MAP_TREE_FUNC ")"))
+            fromTree = 1;
+
+        // every other line of a .text section with an origin and length is one of its input sections
+        if (strcmp(sect, ".text") || (sscanf(line, " %lx %lx", &origin, &length) != 2) || (numFuncs >= BENCH_MAP_FUNCS))
+            continue;
+
+        end = strchr(line, '(');
+        if (!end)
+            continue;   // a --HOLE--
+
+        if (!strncmp(end, "(.text:", 7))
+        {
+            // the function name is the last part of the section name ("(.text:decompress:lzss:__TI_decompress_lzss)")
+            end = strchr(end, ')');
+            if (!end)
+                continue;
+            for (start = end; (start[-1] != ':'); start--);
+        }
+        else
+        {
+            // the object file name is the word before the section name
+            while ((end > line) && (end[-1] == ' '))
+                end--;
+            for (start = end; (start > line) && (start[-1] != ' '); start--);
+        }
+
+        length = (unsigned long)(end - start);
+        if (length >= BENCH_MAP_NAME)
+            length = BENCH_MAP_NAME - 1;
+        memcpy(funcs[numFuncs].name, start, length);
+        funcs[numFuncs].name[length] = '\0';
+        sscanf(line, " %*x %lx", &funcs[numFuncs].size);
+        numFuncs++;
+    }
+    fclose(map);
+
+    qsort(funcs, numFuncs, sizeof(funcs[0]), compareFuncSize);
+    benchNumMapFuncs = numFuncs;
+    printf("\n%-40s %6s\n", "function", "bytes");
+    for (index = 0; index < numFuncs; index++)
+        printf("%-40s %6lu\n", funcs[index].name, funcs[index].size);
+
+    if (!fromTree)
+        printf("\nwarning: %s isn't in this map, so it wasn't linked from this tree; the sizes above are stale (run make -f hostBench.mk report)\n", BENCH_MAP_TREE_FUNC);
+}
+
+// orders BENCH_FUNCs by size, largest first, then by name
+static int compareFuncSize(const void *a, const void *b)
+{
+    const BENCH_FUNC *funcA = (const BENCH_FUNC *)a;
+    const BENCH_FUNC *funcB = (const BENCH_FUNC *)b;
+
+    if (funcA->size != funcB->size)
+        return (funcA->size > funcB->size) ? -1 : 1;
+    return strcmp(funcA->name, funcB->name);
+}
+
+/************************************************************************************
+* Function: printFuncCycles
+*
+* Description:
+*   Names the firmware functions timed by the -finstrument-functions hooks from an
+*   nm listing of this binary, and prints how many times each was called and the
+*   modelled active cycles spent in it (not counting the firmware functions it
+*   called), most cycles first, next to its flash size from the linker map. A
+*   function without a size was inlined (or is host-only); one without a name is
+*   listed by address.
+*
+*   The listing's addresses are offset by where main() actually is, so a binary
+*   built as a position independent executable is named as well.
+*
+* Arguments:
+*   *path   -   path of the nm listing
+*
+* Returns: none
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void printFuncCycles(const char *const path)
+{
+    FILE *syms;
+    char line[BENCH_MAP_LINE];
+    char name[BENCH_MAP_LINE];
+    char type;
+    unsigned long addr;
+    unsigned long offset = 0;
+    unsigned char foundMain = 0;
+    unsigned char index;
+    unsigned char mapIndex;
+    const char *mapName;                // name of the function in the linker map
+    char *suffix;
+
+    syms = fopen(path, "r");
+    if (!syms)
+    {
+        printf("\ncan't open symbol listing %s\n", path);
+        return;
+    }
+
+    // the listing is from the binary as linked, so main() gives the offset to where it was loaded
+    while (!foundMain && fgets(line, sizeof(line), syms))
+    {
+        if ((sscanf(line, "%lx %c %255s", &addr, &type, name) == 3) && !strcmp(name, "main"))
+        {
+            offset = (unsigned long)(uintptr_t)main - addr;
+            foundMain = 1;
+        }
+    }
+    if (!foundMain)
+    {
+        printf("\nmain isn't in symbol listing %s\n", path);
+        fclose(syms);
+        return;
+    }
+
+    rewind(syms);
+    while (fgets(line, sizeof(line), syms))
+    {
+        if ((sscanf(line, "%lx %c %255s", &addr, &type, name) != 3) || ((type != 't') && (type != 'T')))
+            continue;
+
+        // gcc's clones ("writeDimPhase.constprop.0") are named after the function they are of
+        suffix = strchr(name, '.');
+        if (suffix)
+            *suffix = '\0';
+
+        for (index = 0; index < benchNumProf; index++)
+        {
+            if ((unsigned long)(uintptr_t)benchProf[index].addr == addr + offset)
+            {
+                strncpy(benchProf[index].name, name, BENCH_MAP_NAME - 1);
+                benchProf[index].name[BENCH_MAP_NAME - 1] = '\0';
+            }
+        }
+    }
+    fclose(syms);
+
+    if (!benchNumProf)
+    {
+        printf("\nno firmware functions were timed (build with -finstrument-functions, see hostBench.mk)\n");
+        return;
+    }
+
+    qsort(benchProf, benchNumProf, sizeof(benchProf[0]), compareProfCycles);
+    printf("\n%-40s %8s %12s %6s\n", "function", "calls", "cycles", "bytes");
+    for (index = 0; index < benchNumProf; index++)
+    {
+        if (benchProf[index].name[0])
+            printf("%-40s", benchProf[index].name);
+        else
+            printf("%-40p", benchProf[index].addr);
+        printf(" %8lu %12lu", benchProf[index].calls, benchProf[index].cycles);
+
+        // the firmware's main() is renamed for the bench (see above)
+        mapName = strcmp(benchProf[index].name, "geminiMain") ? benchProf[index].name : "main";
+        for (mapIndex = 0; (mapIndex < benchNumMapFuncs) && strcmp(benchMapFuncs[mapIndex].name, mapName); mapIndex++);
+        if (benchProf[index].name[0] && (mapIndex < benchNumMapFuncs))
+            printf(" %6lu\n", benchMapFuncs[mapIndex].size);
+        else
+            printf(" %6s\n", "-");
+    }
+}
+
+// orders BENCH_PROF_FUNCs by cycles, most first, then by calls
+static int compareProfCycles(const void *a, const void *b)
+{
+    const BENCH_PROF_FUNC *funcA = (const BENCH_PROF_FUNC *)a;
+    const BENCH_PROF_FUNC *funcB = (const BENCH_PROF_FUNC *)b;
+
+    if (funcA->cycles != funcB->cycles)
+        return (funcA->cycles > funcB->cycles) ? -1 : 1;
+    if (funcA->calls != funcB->calls)
+        return (funcA->calls > funcB->calls) ? -1 : 1;
+    return 0;
+}
+
+// charges the innermost timed firmware function for the active cycles since it was last charged
+static void chargeProfFunc(void)
+{
+    const unsigned long now = hostHalGetStats()->activeCycles;
+
+    if (benchProfDepth && (benchProfStack[benchProfDepth - 1] != BENCH_PROF_UNTIMED))
+        benchProf[benchProfStack[benchProfDepth - 1]].cycles += now - benchProfLast;
+    benchProfLast = now;
+}
+
+/************************************************************************************
+* Function: __cyg_profile_func_enter
+*
+* Description:
+*   Called by gcc on entry to every firmware function, when the bench is built
+*   with -finstrument-functions (see hostBench.mk). The function that was running
+*   is charged for its time, and the one entered is counted and timed until it
+*   returns or calls another. Functions in the bench and the peripheral model
+*   aren't instrumented, so their cycles (busy-waits, SPI transfers) go to the
+*   firmware function that called them; ISRs dispatched by the model are timed
+*   on their own.
+*
+* Arguments:
+*   *func           -   entry point of the function entered
+*   *caller         -   address it was called from (unused)
+*
+* Returns: none
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+void __attribute__((no_instrument_function)) __cyg_profile_func_enter(void *func, void *caller)
+{
+    unsigned char index;
+
+    (void)caller;
+    chargeProfFunc();
+
+    if (benchProfDepth >= BENCH_PROF_DEPTH)
+    {
+        benchProfDeep++;
+        return;
+    }
+
+    for (index = 0; (index < benchNumProf) && (benchProf[index].addr != func); index++);
+    if ((index == benchNumProf) && (benchNumProf < BENCH_PROF_FUNCS))
+    {
+        benchProf[index].addr = func;
+        benchNumProf++;
+    }
+
+    if (index < benchNumProf)
+    {
+        benchProf[index].calls++;
+        benchProfStack[benchProfDepth++] = index;
+    }
+    else
+        benchProfStack[benchProfDepth++] = BENCH_PROF_UNTIMED;
+}
+
+// called by gcc on return from every firmware function; the function returning is charged for its time (see __cyg_profile_func_enter)
+void __attribute__((no_instrument_function)) __cyg_profile_func_exit(void *func, void *caller)
+{
+    (void)func;
+    (void)caller;
+    chargeProfFunc();
+
+    if (benchProfDeep)
+        benchProfDeep--;
+    else if (benchProfDepth)
+        benchProfDepth--;
+}
+
+#if (COMPUTER_CONTROL)
+/************************************************************************************
+* Function: sendLinkCmd
+*
+* Description:
+*   Frames a step's control link command with CTRL_SYNC and its checksum (off by
+*   one for STIM_LINK_BAD), and has the peripheral model clock it into USCI_B0;
+*   the bytes clocked back out are collected in benchLinkRx.
+*
+* Arguments:
+*   *step   -   the STIM_LINK or STIM_LINK_BAD step to apply
+*
+* Returns: none
+*
+* Created:      October 14, 2026
+* Modified:     October 14, 2026
+************************************************************************************/
+static void sendLinkCmd(const BENCH_STEP *const step)
+{
+    unsigned char sum = 0;
+    unsigned char index;
+
+    benchLinkTx[0] = CTRL_SYNC;
+    for (index = 0; index < step->linkLen; index++)
+    {
+        benchLinkTx[index + 1] = step->linkCmd[index];
+        sum += step->linkCmd[index];
+    }
+    benchLinkTx[step->linkLen + 1] = (unsigned char)(-sum) + ((step->stim == STIM_LINK_BAD) ? 1 : 0);
+    benchLinkLen = step->linkLen + 2;
+
+    hostHalSpiSlaveXfer(&UCB0RXBUF, benchLinkTx, benchLinkRx, benchLinkLen);
+}
+#endif